@@ -0,0 +1,60 @@
+#include "alloc_utils.h"
+
+#include <stdatomic.h>
+
+static void* __mem_allocator_default_alloc(void* ctx, size_t size)
+{
+	(void)ctx;
+	return malloc(size);
+}
+
+static void* __mem_allocator_default_realloc(void* ctx, void* ptr, size_t size)
+{
+	(void)ctx;
+	return realloc(ptr, size);
+}
+
+static void __mem_allocator_default_free(void* ctx, void* ptr)
+{
+	(void)ctx;
+	free(ptr);
+}
+
+static const MemAllocator __mem_allocator_default = {
+	.alloc = __mem_allocator_default_alloc,
+	.realloc = __mem_allocator_default_realloc,
+	.free = __mem_allocator_default_free,
+	.ctx = NULL
+};
+
+static _Atomic(const MemAllocator*) __mem_allocator_global = &__mem_allocator_default;
+
+const MemAllocator* mem_allocator_default()
+{
+	return &__mem_allocator_default;
+}
+
+const MemAllocator* mem_allocator_get()
+{
+	return atomic_load_explicit(&__mem_allocator_global, memory_order_acquire);
+}
+
+void mem_allocator_set(const MemAllocator* allocator)
+{
+	atomic_store_explicit(&__mem_allocator_global, ( allocator ? allocator : &__mem_allocator_default ), memory_order_release);
+}
+
+void* mem_alloc(size_t size)
+{
+	return mem_allocator_alloc(mem_allocator_get(), size);
+}
+
+void* mem_realloc(void* ptr, size_t size)
+{
+	return mem_allocator_realloc(mem_allocator_get(), ptr, size);
+}
+
+void mem_free(void* ptr)
+{
+	mem_allocator_free(mem_allocator_get(), ptr);
+}
\ No newline at end of file
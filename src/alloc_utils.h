@@ -0,0 +1,50 @@
+#ifndef ALLOC_UTILS_H
+#define ALLOC_UTILS_H
+
+#include <stdlib.h>
+#include <stddef.h>
+
+/* Memory routines used by the library instead of malloc, realloc and free. ctx is passed through
+   to every call, e.g. a heap handle or tracking state. realloc and free get NULL like their libc counterparts.
+*/
+typedef struct 
+{
+    void* (*alloc)(void* ctx, size_t size);
+    void* (*realloc)(void* ctx, void* ptr, size_t size);
+    void (*free)(void* ctx, void* ptr);
+    void* ctx;
+} MemAllocator;
+
+//allocator wrapping malloc, realloc and free
+const MemAllocator* mem_allocator_default();
+
+//allocator of all new allocations without an explicit one, mem_allocator_default if not set
+const MemAllocator* mem_allocator_get();
+
+/* Replaces the global allocator, NULL restores the default. The allocator must outlive all memory taken
+   from it. Objects keep the allocator current at their init and release everything with it. Plain results
+   like strings are released with mem_free, so they must not outlive a change of the global allocator.
+*/
+void mem_allocator_set(const MemAllocator* allocator);
+
+static inline void* mem_allocator_alloc(const MemAllocator* allocator, size_t size)
+{
+    return allocator->alloc(allocator->ctx, size);
+}
+
+static inline void* mem_allocator_realloc(const MemAllocator* allocator, void* ptr, size_t size)
+{
+    return allocator->realloc(allocator->ctx, ptr, size);
+}
+
+static inline void mem_allocator_free(const MemAllocator* allocator, void* ptr)
+{
+    allocator->free(allocator->ctx, ptr);
+}
+
+//shortcuts using the global allocator, e.g. to release strings of string_utils
+void* mem_alloc(size_t size);
+void* mem_realloc(void* ptr, size_t size);
+void mem_free(void* ptr);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,175 @@
+#include "arena_utils.h"
+
+#include <stdint.h>
+
+typedef struct MemArenaChunk
+{
+	struct MemArenaChunk* next;
+	size_t size;                //capacity of data
+	size_t used;
+	_Alignas(max_align_t) unsigned char data[];
+} MemArenaChunk;
+
+static MemArenaChunk* __mem_arena_chunk_new(MemArena* _arena, size_t size)
+{
+	MemArena* arena = _arena;
+	if (size > SIZE_MAX - sizeof(MemArenaChunk)) return NULL;
+
+	MemArenaChunk* chunk = mem_allocator_alloc(arena->allocator, sizeof(MemArenaChunk) + size);
+
+	if (chunk)
+	{
+		chunk->next = NULL;
+		chunk->size = size;
+		chunk->used = 0;
+	}
+
+	return chunk;
+}
+
+//offset behind the alignment gap or SIZE_MAX if the allocation does not fit
+static size_t __mem_arena_chunk_fit(MemArenaChunk* chunk, size_t size, size_t align)
+{
+	uintptr_t cur = (uintptr_t)&chunk->data[chunk->used];
+	size_t gap = (size_t)((align - (cur & (align - 1))) & (align - 1));
+
+	if (gap > chunk->size - chunk->used || size > chunk->size - chunk->used - gap) return SIZE_MAX;
+
+	return chunk->used + gap;
+}
+
+MemArena* mem_arena_new(size_t chunkSize)
+{
+	MemArena* new_arena = mem_allocator_alloc(mem_allocator_get(), sizeof(MemArena));
+
+	if (new_arena)
+	{
+		mem_arena_init(new_arena, chunkSize);
+		new_arena->allocObj = true;
+	}
+
+	return new_arena;
+}
+
+void mem_arena_init(MemArena* _arena, size_t chunkSize)
+{
+	MemArena* arena = _arena;
+	if (arena)
+	{
+		arena->allocObj = false;
+		arena->chunkSize = ( chunkSize > 0 ? chunkSize : MEM_ARENA_DEFAULT_CHUNK_SIZE );
+		arena->first = NULL;
+		arena->current = NULL;
+		arena->used = 0;
+		arena->allocator = mem_allocator_get();
+	}
+}
+
+void mem_arena_free(MemArena** _arena)
+{
+	MemArena** arena = _arena;
+	if (arena && *arena)
+	{
+		MemArena* toDelete = *arena;
+
+		MemArenaChunk* chunk = toDelete->first;
+		while (chunk)
+		{
+			MemArenaChunk* next = chunk->next;
+			mem_allocator_free(toDelete->allocator, chunk);
+			chunk = next;
+		}
+
+		toDelete->first = NULL;
+		toDelete->current = NULL;
+		toDelete->used = 0;
+
+		if (toDelete->allocObj)
+		{
+			mem_allocator_free(toDelete->allocator, toDelete);
+			*arena = NULL;
+		}
+	}
+}
+
+void* mem_arena_alloc(MemArena* arena, size_t size)
+{
+	return mem_arena_alloc_aligned(arena, size, MEM_ARENA_DEFAULT_ALIGN);
+}
+
+void* mem_arena_alloc_aligned(MemArena* _arena, size_t size, size_t align)
+{
+	MemArena* arena = _arena;
+	if (!arena || align == 0 || (align & (align - 1)) != 0) return NULL;
+
+	MemArenaChunk* chunk = arena->current;
+	size_t start = ( chunk ? __mem_arena_chunk_fit(chunk, size, align) : SIZE_MAX );
+
+	//chunks kept by reset are used again before new ones are allocated
+	while (start == SIZE_MAX && chunk && chunk->next)
+	{
+		chunk = chunk->next;
+		start = __mem_arena_chunk_fit(chunk, size, align);
+	}
+
+	if (start == SIZE_MAX)
+	{
+		size_t minSize = size + ( align > MEM_ARENA_DEFAULT_ALIGN ? align : 0 );
+		if (minSize < size) return NULL;
+
+		MemArenaChunk* newChunk = __mem_arena_chunk_new(arena, minSize > arena->chunkSize ? minSize : arena->chunkSize );
+		if (!newChunk) return NULL;
+
+		if (chunk)
+		{
+			newChunk->next = chunk->next;
+			chunk->next = newChunk;
+		}
+		else
+		{
+			arena->first = newChunk;
+		}
+
+		chunk = newChunk;
+		start = __mem_arena_chunk_fit(chunk, size, align);
+	}
+
+	arena->current = chunk;
+	chunk->used = start + size;
+	arena->used += size;
+
+	return &chunk->data[start];
+}
+
+void mem_arena_reset(MemArena* _arena)
+{
+	MemArena* arena = _arena;
+	if (arena)
+	{
+		MemArenaChunk** link = &arena->first;
+
+		while (*link)
+		{
+			MemArenaChunk* chunk = *link;
+
+			//oversized chunks would mostly stay unused
+			if (chunk->size > arena->chunkSize)
+			{
+				*link = chunk->next;
+				mem_allocator_free(arena->allocator, chunk);
+				continue;
+			}
+
+			chunk->used = 0;
+			link = &chunk->next;
+		}
+
+		arena->current = arena->first;
+		arena->used = 0;
+	}
+}
+
+size_t mem_arena_used(MemArena* arena)
+{
+	return arena->used;
+}
\ No newline at end of file
@@ -0,0 +1,47 @@
+#ifndef ARENA_UTILS_H
+#define ARENA_UTILS_H
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "alloc_utils.h"
+
+#define MEM_ARENA_DEFAULT_CHUNK_SIZE (64 * 1024)
+#define MEM_ARENA_DEFAULT_ALIGN (sizeof(max_align_t))
+
+struct MemArenaChunk;
+
+/* Bump allocator over a list of chunks. Allocations are never freed one by one,
+   mem_arena_reset releases all of them at once and keeps the chunks for reuse.
+   Allocations larger than the chunk size get an own chunk, which is freed on reset.
+*/
+typedef struct 
+{
+    bool allocObj;                      //true, if mem_arena_new was called
+    size_t chunkSize;                   //capacity of regular chunks
+    struct MemArenaChunk* first;
+    struct MemArenaChunk* current;      //chunk allocations are taken from
+    size_t used;                        //bytes handed out since the last reset, without alignment gaps
+    const MemAllocator* allocator;      //routines for chunks and the object, global allocator at init
+} MemArena;
+
+//Allocates a complete Arena Object, chunkSize 0 uses MEM_ARENA_DEFAULT_CHUNK_SIZE
+MemArena* mem_arena_new(size_t chunkSize);
+
+void mem_arena_init(MemArena* arena, size_t chunkSize);
+
+void mem_arena_free(MemArena** arena);
+
+//size bytes aligned to MEM_ARENA_DEFAULT_ALIGN, NULL on error
+void* mem_arena_alloc(MemArena* arena, size_t size);
+
+//size bytes aligned to align, which must be a power of two. NULL on error.
+void* mem_arena_alloc_aligned(MemArena* arena, size_t size, size_t align);
+
+//releases all allocations at once
+void mem_arena_reset(MemArena* arena);
+
+size_t mem_arena_used(MemArena* arena);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,355 @@
+#include "byte_buffer_pool.h"
+
+#include <stddef.h>
+
+#define BYTE_BUFFER_POOL_UNPOOLED BYTE_BUFFER_POOL_CLASSES
+
+typedef struct ByteBufferPoolBlock
+{
+	struct ByteBufferPoolBlock* next;       //free list link
+	ByteBufferPool* pool;
+	size_t sizeClass;                       //BYTE_BUFFER_POOL_UNPOOLED for too large buffers
+	size_t dataSize;                        //capacity of data
+	ByteBuffer buffer;
+	_Alignas(16) unsigned char data[];
+} ByteBufferPoolBlock;
+
+typedef struct ByteBufferPoolCache
+{
+	ByteBufferPool* pool;
+	struct ByteBufferPoolCache* next;
+	struct ByteBufferPoolCache* prev;
+	ByteBufferPoolBlock* blocks[BYTE_BUFFER_POOL_CLASSES];
+	size_t cntBlocks[BYTE_BUFFER_POOL_CLASSES];
+} ByteBufferPoolCache;
+
+static size_t __byte_buffer_pool_class(size_t size)
+{
+	size_t sizeClass = 0;
+	size_t classSize = (size_t)1 << BYTE_BUFFER_POOL_MIN_SHIFT;
+
+	while (classSize < size && sizeClass < BYTE_BUFFER_POOL_UNPOOLED)
+	{
+		classSize <<= 1;
+		sizeClass++;
+	}
+
+	return sizeClass;
+}
+
+static size_t __byte_buffer_pool_class_size(size_t sizeClass)
+{
+	return (size_t)1 << (sizeClass + BYTE_BUFFER_POOL_MIN_SHIFT);
+}
+
+static ByteBufferPoolBlock* __byte_buffer_pool_block_of(ByteBuffer* buffer)
+{
+	return (ByteBufferPoolBlock*)((unsigned char*)buffer - offsetof(ByteBufferPoolBlock, buffer));
+}
+
+static void __byte_buffer_pool_free_list(ByteBufferPool* pool, ByteBufferPoolBlock* block)
+{
+	while (block)
+	{
+		ByteBufferPoolBlock* next = block->next;
+		mem_allocator_free(pool->allocator, block);
+		block = next;
+	}
+}
+
+//moves the cached blocks to the global list when the thread ends
+static void __byte_buffer_pool_cache_destroy(void* _cache)
+{
+	ByteBufferPoolCache* cache = _cache;
+	ByteBufferPool* pool = cache->pool;
+
+	pthread_mutex_lock(&pool->lock);
+
+	for (size_t curClass = 0; curClass < BYTE_BUFFER_POOL_CLASSES; curClass++)
+	{
+		ByteBufferPoolBlock* block = cache->blocks[curClass];
+		while (block)
+		{
+			ByteBufferPoolBlock* next = block->next;
+			block->next = pool->globalBlocks[curClass];
+			pool->globalBlocks[curClass] = block;
+			atomic_fetch_add_explicit(&pool->cntGlobalBlocks[curClass], 1, memory_order_relaxed);
+			block = next;
+		}
+	}
+
+	if (cache->prev) cache->prev->next = cache->next;
+	else pool->caches = cache->next;
+	if (cache->next) cache->next->prev = cache->prev;
+
+	pthread_mutex_unlock(&pool->lock);
+
+	mem_allocator_free(pool->allocator, cache);
+}
+
+static ByteBufferPoolCache* __byte_buffer_pool_cache(ByteBufferPool* pool)
+{
+	ByteBufferPoolCache* cache = pthread_getspecific(pool->cacheKey);
+
+	if (!cache)
+	{
+		cache = mem_allocator_alloc(pool->allocator, sizeof(ByteBufferPoolCache));
+		if (!cache) return NULL;
+
+		memset(cache, 0, sizeof(ByteBufferPoolCache));
+
+		cache->pool = pool;
+
+		pthread_mutex_lock(&pool->lock);
+		cache->next = pool->caches;
+		if (pool->caches) pool->caches->prev = cache;
+		pool->caches = cache;
+		pthread_mutex_unlock(&pool->lock);
+
+		pthread_setspecific(pool->cacheKey, cache);
+	}
+
+	return cache;
+}
+
+static void __byte_buffer_pool_count_use(ByteBufferPool* pool, size_t cntBytes)
+{
+	size_t inUse = atomic_fetch_add_explicit(&pool->inUse, cntBytes, memory_order_relaxed) + cntBytes;
+	size_t highWater = atomic_load_explicit(&pool->highWater, memory_order_relaxed);
+
+	while (inUse > highWater && !atomic_compare_exchange_weak_explicit(&pool->highWater, &highWater, inUse, memory_order_relaxed, memory_order_relaxed))
+	{
+	}
+}
+
+//takes a free block of the class from the thread cache, refilled by a batch of the global list
+static ByteBufferPoolBlock* __byte_buffer_pool_take(ByteBufferPool* pool, size_t sizeClass)
+{
+	ByteBufferPoolCache* cache = __byte_buffer_pool_cache(pool);
+	if (!cache) return NULL;
+
+	if (!cache->blocks[sizeClass] && atomic_load_explicit(&pool->cntGlobalBlocks[sizeClass], memory_order_relaxed) > 0)
+	{
+		pthread_mutex_lock(&pool->lock);
+
+		for (size_t curBlock = 0; curBlock < BYTE_BUFFER_POOL_BATCH && pool->globalBlocks[sizeClass]; curBlock++)
+		{
+			ByteBufferPoolBlock* block = pool->globalBlocks[sizeClass];
+			pool->globalBlocks[sizeClass] = block->next;
+			atomic_fetch_sub_explicit(&pool->cntGlobalBlocks[sizeClass], 1, memory_order_relaxed);
+
+			block->next = cache->blocks[sizeClass];
+			cache->blocks[sizeClass] = block;
+			cache->cntBlocks[sizeClass]++;
+		}
+
+		pthread_mutex_unlock(&pool->lock);
+	}
+
+	ByteBufferPoolBlock* block = cache->blocks[sizeClass];
+	if (block)
+	{
+		cache->blocks[sizeClass] = block->next;
+		cache->cntBlocks[sizeClass]--;
+	}
+
+	return block;
+}
+
+//puts the block into the thread cache, a full cache moves half of it to the global list
+static void __byte_buffer_pool_put(ByteBufferPool* pool, ByteBufferPoolBlock* block)
+{
+	size_t sizeClass = block->sizeClass;
+	ByteBufferPoolCache* cache = __byte_buffer_pool_cache(pool);
+
+	if (!cache)
+	{
+		mem_allocator_free(pool->allocator, block);
+		return;
+	}
+
+	block->next = cache->blocks[sizeClass];
+	cache->blocks[sizeClass] = block;
+	cache->cntBlocks[sizeClass]++;
+
+	if (cache->cntBlocks[sizeClass] > BYTE_BUFFER_POOL_THREAD_MAX)
+	{
+		pthread_mutex_lock(&pool->lock);
+
+		while (cache->cntBlocks[sizeClass] > BYTE_BUFFER_POOL_THREAD_MAX / 2)
+		{
+			ByteBufferPoolBlock* moved = cache->blocks[sizeClass];
+			cache->blocks[sizeClass] = moved->next;
+			cache->cntBlocks[sizeClass]--;
+
+			moved->next = pool->globalBlocks[sizeClass];
+			pool->globalBlocks[sizeClass] = moved;
+			atomic_fetch_add_explicit(&pool->cntGlobalBlocks[sizeClass], 1, memory_order_relaxed);
+		}
+
+		pthread_mutex_unlock(&pool->lock);
+	}
+}
+
+ByteBufferPool* byte_buffer_pool_new()
+{
+	const MemAllocator* allocator = mem_allocator_get();
+	ByteBufferPool* new_pool = mem_allocator_alloc(allocator, sizeof(ByteBufferPool));
+
+	if (new_pool && !byte_buffer_pool_init(new_pool))
+	{
+		mem_allocator_free(allocator, new_pool);
+		return NULL;
+	}
+
+	if (new_pool)
+	{
+		new_pool->allocObj = true;
+	}
+
+	return new_pool;
+}
+
+bool byte_buffer_pool_init(ByteBufferPool* _pool)
+{
+	ByteBufferPool* pool = _pool;
+	if (!pool) return false;
+
+	memset(pool, 0, sizeof(ByteBufferPool));
+
+	pool->allocator = mem_allocator_get();
+
+	if (pthread_key_create(&pool->cacheKey, __byte_buffer_pool_cache_destroy) != 0) return false;
+
+	pthread_mutex_init(&pool->lock, NULL);
+
+	for (size_t curClass = 0; curClass < BYTE_BUFFER_POOL_CLASSES; curClass++)
+	{
+		atomic_init(&pool->cntGlobalBlocks[curClass], 0);
+	}
+
+	atomic_init(&pool->hits, 0);
+	atomic_init(&pool->misses, 0);
+	atomic_init(&pool->inUse, 0);
+	atomic_init(&pool->highWater, 0);
+
+	return true;
+}
+
+void byte_buffer_pool_free(ByteBufferPool** _pool)
+{
+	ByteBufferPool** pool = _pool;
+	if (pool && *pool)
+	{
+		ByteBufferPool* toDelete = *pool;
+
+		//no destructor runs after deleting the key, so all caches are freed here
+		pthread_key_delete(toDelete->cacheKey);
+
+		ByteBufferPoolCache* cache = toDelete->caches;
+		while (cache)
+		{
+			ByteBufferPoolCache* next = cache->next;
+
+			for (size_t curClass = 0; curClass < BYTE_BUFFER_POOL_CLASSES; curClass++)
+			{
+				__byte_buffer_pool_free_list(toDelete, cache->blocks[curClass]);
+			}
+
+			mem_allocator_free(toDelete->allocator, cache);
+			cache = next;
+		}
+
+		for (size_t curClass = 0; curClass < BYTE_BUFFER_POOL_CLASSES; curClass++)
+		{
+			__byte_buffer_pool_free_list(toDelete, toDelete->globalBlocks[curClass]);
+			toDelete->globalBlocks[curClass] = NULL;
+		}
+
+		toDelete->caches = NULL;
+
+		pthread_mutex_destroy(&toDelete->lock);
+
+		if (toDelete->allocObj)
+		{
+			mem_allocator_free(toDelete->allocator, toDelete);
+			*pool = NULL;
+		}
+	}
+}
+
+void byte_buffer_pool_stats(ByteBufferPool* pool, ByteBufferPoolStats* stats)
+{
+	stats->hits = atomic_load_explicit(&pool->hits, memory_order_relaxed);
+	stats->misses = atomic_load_explicit(&pool->misses, memory_order_relaxed);
+	stats->inUse = atomic_load_explicit(&pool->inUse, memory_order_relaxed);
+	stats->highWater = atomic_load_explicit(&pool->highWater, memory_order_relaxed);
+}
+
+ByteBuffer* byte_buffer_new_pooled(ByteBufferPool* pool, ByteBufferMode mode, size_t rawBuffSize)
+{
+	if (!pool) return NULL;
+
+	size_t sizeClass = __byte_buffer_pool_class(rawBuffSize);
+	ByteBufferPoolBlock* block = NULL;
+
+	if (sizeClass < BYTE_BUFFER_POOL_UNPOOLED)
+	{
+		block = __byte_buffer_pool_take(pool, sizeClass);
+	}
+
+	if (block)
+	{
+		atomic_fetch_add_explicit(&pool->hits, 1, memory_order_relaxed);
+	}
+	else
+	{
+		size_t dataSize = ( sizeClass < BYTE_BUFFER_POOL_UNPOOLED ? __byte_buffer_pool_class_size(sizeClass) : rawBuffSize );
+
+		block = mem_allocator_alloc(pool->allocator, sizeof(ByteBufferPoolBlock) + dataSize);
+		if (!block) return NULL;
+
+		block->pool = pool;
+		block->sizeClass = sizeClass;
+		block->dataSize = dataSize;
+
+		atomic_fetch_add_explicit(&pool->misses, 1, memory_order_relaxed);
+	}
+
+	block->next = NULL;
+
+	__byte_buffer_pool_count_use(pool, block->dataSize);
+
+	//storage and object belong to the block, so byte_buffer_free would release nothing
+	byte_buffer_init(&block->buffer, mode, &block->data[0], rawBuffSize);
+	block->buffer.allocator = pool->allocator;
+
+	return &block->buffer;
+}
+
+void byte_buffer_free_pooled(ByteBuffer** _buffer)
+{
+	ByteBuffer** buffer = _buffer;
+	if (buffer && *buffer)
+	{
+		ByteBufferPoolBlock* block = __byte_buffer_pool_block_of(*buffer);
+		ByteBufferPool* pool = block->pool;
+		ByteBuffer* toDelete = &block->buffer;
+
+		atomic_fetch_sub_explicit(&pool->inUse, block->dataSize, memory_order_relaxed);
+
+		//grown buffers live in own memory now
+		byte_buffer_free(&toDelete);
+
+		if (block->sizeClass < BYTE_BUFFER_POOL_UNPOOLED)
+		{
+			__byte_buffer_pool_put(pool, block);
+		}
+		else
+		{
+			mem_allocator_free(pool->allocator, block);
+		}
+
+		*buffer = NULL;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,63 @@
+#ifndef BYTE_BUFFER_POOL_H
+#define BYTE_BUFFER_POOL_H
+
+#include <stdatomic.h>
+#include <pthread.h>
+
+#include "byte_utils.h"
+
+#define BYTE_BUFFER_POOL_MIN_SHIFT 6            //smallest size class 64 bytes
+#define BYTE_BUFFER_POOL_MAX_SHIFT 20           //largest size class 1 MiB, larger buffers are not pooled
+#define BYTE_BUFFER_POOL_CLASSES (BYTE_BUFFER_POOL_MAX_SHIFT - BYTE_BUFFER_POOL_MIN_SHIFT + 1)
+#define BYTE_BUFFER_POOL_THREAD_MAX 64          //cached blocks per class and thread before moving half to the global list
+#define BYTE_BUFFER_POOL_BATCH 16               //blocks taken from the global list at once
+
+struct ByteBufferPoolBlock;
+struct ByteBufferPoolCache;
+
+typedef struct 
+{
+    size_t hits;                //buffers served from a cache
+    size_t misses;              //buffers which needed a new allocation
+    size_t inUse;               //bytes of block storage handed out and not returned
+    size_t highWater;           //max of inUse
+} ByteBufferPoolStats;
+
+/* Pool of buffers in power of two size classes. Object, storage and pool header of a buffer are
+   one allocation. Every thread caches free blocks per class without locking, only moving
+   batches between its cache and the global list takes the mutex.
+*/
+typedef struct 
+{
+    bool allocObj;                                              //true, if byte_buffer_pool_new was called
+    pthread_key_t cacheKey;                                     //per thread ByteBufferPoolCache
+    pthread_mutex_t lock;                                       //global lists and cache registry
+    struct ByteBufferPoolBlock* globalBlocks[BYTE_BUFFER_POOL_CLASSES];
+    atomic_size_t cntGlobalBlocks[BYTE_BUFFER_POOL_CLASSES];   //changed under lock, read as hint without
+    struct ByteBufferPoolCache* caches;                         //all thread caches, freed with the pool
+    atomic_size_t hits;
+    atomic_size_t misses;
+    atomic_size_t inUse;
+    atomic_size_t highWater;
+    const MemAllocator* allocator;                              //routines for blocks, caches and the object, global allocator at init
+} ByteBufferPool;
+
+//Allocates a complete Pool Object, NULL on error
+ByteBufferPool* byte_buffer_pool_new();
+
+bool byte_buffer_pool_init(ByteBufferPool* pool);
+
+//frees all cached blocks. Buffers still in use must not be returned afterwards.
+void byte_buffer_pool_free(ByteBufferPool** pool);
+
+void byte_buffer_pool_stats(ByteBufferPool* pool, ByteBufferPoolStats* stats);
+
+/* Pooled variant of byte_buffer_new. The buffer must be returned with byte_buffer_free_pooled
+   from any thread. Clones get a copy of the storage, as it is reused after returning. Growing moves
+   the content into own memory, the pooled storage is reused anyway. Returns NULL on error.
+*/
+ByteBuffer* byte_buffer_new_pooled(ByteBufferPool* pool, ByteBufferMode mode, size_t rawBuffSize);
+
+void byte_buffer_free_pooled(ByteBuffer** buffer);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,628 @@
+#include "byte_codec.h"
+#include "cpu_utils.h"
+
+#ifdef CPU_UTILS_X86
+	#include <immintrin.h>
+#endif
+
+#define BYTE_CODEC_SCRATCH_SIZE 512      //results up to this size are appended over the stack
+#define BYTE_CODEC_INVALID 0xFF
+
+static const unsigned char __byte_codec_base64_chars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+static const unsigned char __byte_codec_hex_chars[] = "0123456789abcdef";
+
+//6 bit value of a base64 char, BYTE_CODEC_INVALID outside of the alphabet
+static const unsigned char __byte_codec_base64_values[256] = {
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x3E, 0xFF, 0xFF, 0xFF, 0x3F,
+	0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x3B, 0x3C, 0x3D, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E,
+	0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+	0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F, 0x30, 0x31, 0x32, 0x33, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+};
+
+//4 bit value of a hex char in both cases, BYTE_CODEC_INVALID outside of the alphabet
+static const unsigned char __byte_codec_hex_values[256] = {
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+};
+
+static size_t __byte_codec_base64_encode_scalar(unsigned char* dest, const unsigned char* src, size_t cntBytes)
+{
+	unsigned char* out = dest;
+	size_t pos = 0;
+
+	for (; pos + 3 <= cntBytes; pos += 3)
+	{
+		uint32_t triple = ((uint32_t)src[pos] << 16) | ((uint32_t)src[pos + 1] << 8) | src[pos + 2];
+		out[0] = __byte_codec_base64_chars[triple >> 18];
+		out[1] = __byte_codec_base64_chars[(triple >> 12) & 0x3F];
+		out[2] = __byte_codec_base64_chars[(triple >> 6) & 0x3F];
+		out[3] = __byte_codec_base64_chars[triple & 0x3F];
+		out += 4;
+	}
+
+	size_t rest = cntBytes - pos;
+	if (rest > 0)
+	{
+		uint32_t triple = ((uint32_t)src[pos] << 16) | ( rest == 2 ? (uint32_t)src[pos + 1] << 8 : 0 );
+		out[0] = __byte_codec_base64_chars[triple >> 18];
+		out[1] = __byte_codec_base64_chars[(triple >> 12) & 0x3F];
+		out[2] = ( rest == 2 ? __byte_codec_base64_chars[(triple >> 6) & 0x3F] : '=' );
+		out[3] = '=';
+		out += 4;
+	}
+
+	return (size_t)(out - dest);
+}
+
+//cntChars is a multiple of 4, only the last quad may hold padding
+static bool __byte_codec_base64_decode_scalar(unsigned char* dest, const unsigned char* src, size_t cntChars, size_t* cntDecoded)
+{
+	unsigned char* out = dest;
+	size_t cntQuads = cntChars / 4;
+
+	for (size_t curQuad = 0; curQuad < cntQuads; curQuad++)
+	{
+		const unsigned char* quad = src + curQuad * 4;
+		unsigned char value0 = __byte_codec_base64_values[quad[0]];
+		unsigned char value1 = __byte_codec_base64_values[quad[1]];
+		unsigned char value2 = __byte_codec_base64_values[quad[2]];
+		unsigned char value3 = __byte_codec_base64_values[quad[3]];
+
+		//valid values stay below 64
+		if (((value0 | value1 | value2 | value3) & 0xC0) == 0)
+		{
+			uint32_t triple = ((uint32_t)value0 << 18) | ((uint32_t)value1 << 12) | ((uint32_t)value2 << 6) | value3;
+			out[0] = (unsigned char)(triple >> 16);
+			out[1] = (unsigned char)(triple >> 8);
+			out[2] = (unsigned char)triple;
+			out += 3;
+			continue;
+		}
+
+		bool isLast = (curQuad + 1 == cntQuads);
+		if (!isLast || value0 == BYTE_CODEC_INVALID || value1 == BYTE_CODEC_INVALID) return false;
+
+		//"xx==" or "xxx=", the bits behind the data must be zero
+		if (quad[2] == '=' && quad[3] == '=' && (value1 & 0x0F) == 0)
+		{
+			out[0] = (unsigned char)((value0 << 2) | (value1 >> 4));
+			out += 1;
+		}
+		else if (value2 != BYTE_CODEC_INVALID && quad[3] == '=' && (value2 & 0x03) == 0)
+		{
+			out[0] = (unsigned char)((value0 << 2) | (value1 >> 4));
+			out[1] = (unsigned char)((value1 << 4) | (value2 >> 2));
+			out += 2;
+		}
+		else
+		{
+			return false;
+		}
+	}
+
+	*cntDecoded = (size_t)(out - dest);
+
+	return true;
+}
+
+static size_t __byte_codec_hex_encode_scalar(unsigned char* dest, const unsigned char* src, size_t cntBytes)
+{
+	for (size_t pos = 0; pos < cntBytes; pos++)
+	{
+		dest[2 * pos] = __byte_codec_hex_chars[src[pos] >> 4];
+		dest[2 * pos + 1] = __byte_codec_hex_chars[src[pos] & 0x0F];
+	}
+
+	return cntBytes * 2;
+}
+
+static bool __byte_codec_hex_decode_scalar(unsigned char* dest, const unsigned char* src, size_t cntChars)
+{
+	for (size_t pos = 0; pos < cntChars; pos += 2)
+	{
+		unsigned char high = __byte_codec_hex_values[src[pos]];
+		unsigned char low = __byte_codec_hex_values[src[pos + 1]];
+
+		if ((high | low) == BYTE_CODEC_INVALID) return false;
+
+		dest[pos / 2] = (unsigned char)((high << 4) | low);
+	}
+
+	return true;
+}
+
+#ifdef CPU_UTILS_X86
+
+/* Base64 kernels after Wojciech Muła and Daniel Lemire, "Faster Base64 Encoding and Decoding using AVX2
+   Instructions". The encoder spreads 3 bytes to 4 six bit indices by multiplications and maps them
+   to chars by an offset per range. The decoder validates and maps chars by two nibble lookups and packs
+   the six bit values with multiply adds.
+*/
+__attribute__((target("ssse3")))
+static inline __m128i __byte_codec_base64_encode_block_ssse3(__m128i input)
+{
+	input = _mm_shuffle_epi8(input, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+
+	__m128i high = _mm_mulhi_epu16(_mm_and_si128(input, _mm_set1_epi32(0x0FC0FC00)), _mm_set1_epi32(0x04000040));
+	__m128i low = _mm_mullo_epi16(_mm_and_si128(input, _mm_set1_epi32(0x003F03F0)), _mm_set1_epi32(0x01000010));
+	__m128i indices = _mm_or_si128(high, low);
+
+	//ranges A-Z => 13, a-z => 0, 0-9 => 1..10, + => 11, / => 12
+	__m128i range = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+	range = _mm_or_si128(range, _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), indices), _mm_set1_epi8(13)));
+
+	const __m128i offsets = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+	                                      '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+
+	return _mm_add_epi8(indices, _mm_shuffle_epi8(offsets, range));
+}
+
+//reads 16 bytes for every 12 encoded ones
+__attribute__((target("ssse3")))
+static size_t __byte_codec_base64_encode_ssse3(unsigned char* dest, const unsigned char* src, size_t cntBytes, size_t* consumed)
+{
+	size_t pos = 0;
+	unsigned char* out = dest;
+
+	for (; pos + 16 <= cntBytes; pos += 12)
+	{
+		__m128i input = _mm_loadu_si128((const __m128i*)(src + pos));
+		_mm_storeu_si128((__m128i*)out, __byte_codec_base64_encode_block_ssse3(input));
+		out += 16;
+	}
+
+	*consumed = pos;
+
+	return (size_t)(out - dest);
+}
+
+__attribute__((target("avx2")))
+static size_t __byte_codec_base64_encode_avx2(unsigned char* dest, const unsigned char* src, size_t cntBytes, size_t* consumed)
+{
+	size_t pos = 0;
+	unsigned char* out = dest;
+
+	const __m256i spread = _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+	                                        1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+	const __m256i offsets = _mm256_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+	                                         '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0,
+	                                         'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+	                                         '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+
+	//each lane takes 12 bytes, the upper lane is loaded from 12 bytes later
+	for (; pos + 28 <= cntBytes; pos += 24)
+	{
+		__m256i input = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)(src + pos))),
+		                                        _mm_loadu_si128((const __m128i*)(src + pos + 12)), 1);
+		input = _mm256_shuffle_epi8(input, spread);
+
+		__m256i high = _mm256_mulhi_epu16(_mm256_and_si256(input, _mm256_set1_epi32(0x0FC0FC00)), _mm256_set1_epi32(0x04000040));
+		__m256i low = _mm256_mullo_epi16(_mm256_and_si256(input, _mm256_set1_epi32(0x003F03F0)), _mm256_set1_epi32(0x01000010));
+		__m256i indices = _mm256_or_si256(high, low);
+
+		__m256i range = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+		range = _mm256_or_si256(range, _mm256_and_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices), _mm256_set1_epi8(13)));
+
+		_mm256_storeu_si256((__m256i*)out, _mm256_add_epi8(indices, _mm256_shuffle_epi8(offsets, range)));
+		out += 32;
+	}
+
+	*consumed = pos;
+
+	return (size_t)(out - dest);
+}
+
+//false if a char is not part of the alphabet, the padding is left to the scalar tail
+__attribute__((target("ssse3")))
+static inline bool __byte_codec_base64_decode_block_ssse3(__m128i input, unsigned char* out)
+{
+	const __m128i lutLow = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+	const __m128i lutHigh = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+	const __m128i lutRoll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+	const __m128i nibble = _mm_set1_epi8(0x0F);
+
+	__m128i highNibbles = _mm_and_si128(_mm_srli_epi32(input, 4), nibble);
+	__m128i lowNibbles = _mm_and_si128(input, nibble);
+
+	__m128i invalid = _mm_and_si128(_mm_shuffle_epi8(lutLow, lowNibbles), _mm_shuffle_epi8(lutHigh, highNibbles));
+	if (_mm_movemask_epi8(_mm_cmpeq_epi8(invalid, _mm_setzero_si128())) != 0xFFFF) return false;
+
+	__m128i roll = _mm_shuffle_epi8(lutRoll, _mm_add_epi8(_mm_cmpeq_epi8(input, _mm_set1_epi8('/')), highNibbles));
+	__m128i values = _mm_add_epi8(input, roll);
+
+	__m128i merged = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+	merged = _mm_madd_epi16(merged, _mm_set1_epi32(0x00011000));
+	merged = _mm_shuffle_epi8(merged, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+
+	unsigned char packed[16];
+	_mm_storeu_si128((__m128i*)packed, merged);
+	memcpy(out, packed, 12);
+
+	return true;
+}
+
+__attribute__((target("ssse3")))
+static size_t __byte_codec_base64_decode_ssse3(unsigned char* dest, const unsigned char* src, size_t cntChars, size_t* consumed)
+{
+	size_t pos = 0;
+	unsigned char* out = dest;
+
+	for (; pos + 16 <= cntChars; pos += 16)
+	{
+		if (!__byte_codec_base64_decode_block_ssse3(_mm_loadu_si128((const __m128i*)(src + pos)), out)) break;
+		out += 12;
+	}
+
+	*consumed = pos;
+
+	return (size_t)(out - dest);
+}
+
+__attribute__((target("avx2")))
+static size_t __byte_codec_base64_decode_avx2(unsigned char* dest, const unsigned char* src, size_t cntChars, size_t* consumed)
+{
+	const __m256i lutLow = _mm256_broadcastsi128_si256(_mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A));
+	const __m256i lutHigh = _mm256_broadcastsi128_si256(_mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10));
+	const __m256i lutRoll = _mm256_broadcastsi128_si256(_mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0));
+	const __m256i pack = _mm256_broadcastsi128_si256(_mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+	const __m256i nibble = _mm256_set1_epi8(0x0F);
+
+	size_t pos = 0;
+	unsigned char* out = dest;
+
+	for (; pos + 32 <= cntChars; pos += 32)
+	{
+		__m256i input = _mm256_loadu_si256((const __m256i*)(src + pos));
+		__m256i highNibbles = _mm256_and_si256(_mm256_srli_epi32(input, 4), nibble);
+		__m256i lowNibbles = _mm256_and_si256(input, nibble);
+
+		__m256i invalid = _mm256_and_si256(_mm256_shuffle_epi8(lutLow, lowNibbles), _mm256_shuffle_epi8(lutHigh, highNibbles));
+		if (!_mm256_testz_si256(invalid, invalid)) break;
+
+		__m256i roll = _mm256_shuffle_epi8(lutRoll, _mm256_add_epi8(_mm256_cmpeq_epi8(input, _mm256_set1_epi8('/')), highNibbles));
+		__m256i values = _mm256_add_epi8(input, roll);
+
+		__m256i merged = _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+		merged = _mm256_madd_epi16(merged, _mm256_set1_epi32(0x00011000));
+		merged = _mm256_shuffle_epi8(merged, pack);
+
+		//12 bytes per lane moved together
+		merged = _mm256_permutevar8x32_epi32(merged, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+
+		unsigned char packed[32];
+		_mm256_storeu_si256((__m256i*)packed, merged);
+		memcpy(out, packed, 24);
+		out += 24;
+	}
+
+	*consumed = pos;
+
+	return (size_t)(out - dest);
+}
+
+//two chars per byte, the nibbles are mapped by a shuffle and interleaved
+__attribute__((target("ssse3")))
+static size_t __byte_codec_hex_encode_ssse3(unsigned char* dest, const unsigned char* src, size_t cntBytes)
+{
+	const __m128i chars = _mm_loadu_si128((const __m128i*)__byte_codec_hex_chars);
+	const __m128i nibble = _mm_set1_epi8(0x0F);
+	size_t pos = 0;
+
+	for (; pos + 16 <= cntBytes; pos += 16)
+	{
+		__m128i input = _mm_loadu_si128((const __m128i*)(src + pos));
+		__m128i high = _mm_shuffle_epi8(chars, _mm_and_si128(_mm_srli_epi16(input, 4), nibble));
+		__m128i low = _mm_shuffle_epi8(chars, _mm_and_si128(input, nibble));
+
+		_mm_storeu_si128((__m128i*)(dest + 2 * pos), _mm_unpacklo_epi8(high, low));
+		_mm_storeu_si128((__m128i*)(dest + 2 * pos + 16), _mm_unpackhi_epi8(high, low));
+	}
+
+	return pos;
+}
+
+__attribute__((target("avx2")))
+static size_t __byte_codec_hex_encode_avx2(unsigned char* dest, const unsigned char* src, size_t cntBytes)
+{
+	const __m256i chars = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)__byte_codec_hex_chars));
+	const __m256i nibble = _mm256_set1_epi8(0x0F);
+	size_t pos = 0;
+
+	for (; pos + 32 <= cntBytes; pos += 32)
+	{
+		__m256i input = _mm256_loadu_si256((const __m256i*)(src + pos));
+		__m256i high = _mm256_shuffle_epi8(chars, _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble));
+		__m256i low = _mm256_shuffle_epi8(chars, _mm256_and_si256(input, nibble));
+
+		//unpack works per lane: first holds bytes 0-7 and 16-23, second 8-15 and 24-31
+		__m256i first = _mm256_unpacklo_epi8(high, low);
+		__m256i second = _mm256_unpackhi_epi8(high, low);
+
+		_mm256_storeu_si256((__m256i*)(dest + 2 * pos), _mm256_permute2x128_si256(first, second, 0x20));
+		_mm256_storeu_si256((__m256i*)(dest + 2 * pos + 32), _mm256_permute2x128_si256(first, second, 0x31));
+	}
+
+	return pos;
+}
+
+/* Digits and letters of both cases are mapped separately, a char in neither range is invalid. The nibble
+   pairs are packed by a multiply add of 16 and 1.
+*/
+__attribute__((target("ssse3")))
+static inline bool __byte_codec_hex_decode_block_ssse3(__m128i input, __m128i* values)
+{
+	__m128i digits = _mm_sub_epi8(input, _mm_set1_epi8('0'));
+	__m128i letters = _mm_sub_epi8(_mm_or_si128(input, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+
+	__m128i isDigit = _mm_cmpeq_epi8(_mm_max_epu8(digits, _mm_set1_epi8(9)), _mm_set1_epi8(9));
+	__m128i isLetter = _mm_cmpeq_epi8(_mm_max_epu8(letters, _mm_set1_epi8(5)), _mm_set1_epi8(5));
+
+	if (_mm_movemask_epi8(_mm_or_si128(isDigit, isLetter)) != 0xFFFF) return false;
+
+	__m128i nibbles = _mm_or_si128(_mm_and_si128(isDigit, digits), _mm_and_si128(isLetter, _mm_add_epi8(letters, _mm_set1_epi8(10))));
+	*values = _mm_maddubs_epi16(nibbles, _mm_set1_epi16(0x0110));
+
+	return true;
+}
+
+__attribute__((target("ssse3")))
+static size_t __byte_codec_hex_decode_ssse3(unsigned char* dest, const unsigned char* src, size_t cntChars)
+{
+	size_t pos = 0;
+
+	for (; pos + 32 <= cntChars; pos += 32)
+	{
+		__m128i first, second;
+		if (!__byte_codec_hex_decode_block_ssse3(_mm_loadu_si128((const __m128i*)(src + pos)), &first) ||
+		    !__byte_codec_hex_decode_block_ssse3(_mm_loadu_si128((const __m128i*)(src + pos + 16)), &second)) break;
+
+		_mm_storeu_si128((__m128i*)(dest + pos / 2), _mm_packus_epi16(first, second));
+	}
+
+	return pos;
+}
+
+__attribute__((target("avx2")))
+static size_t __byte_codec_hex_decode_avx2(unsigned char* dest, const unsigned char* src, size_t cntChars)
+{
+	size_t pos = 0;
+
+	for (; pos + 64 <= cntChars; pos += 64)
+	{
+		__m256i values[2];
+		bool valid = true;
+
+		for (int curHalf = 0; curHalf < 2; curHalf++)
+		{
+			__m256i input = _mm256_loadu_si256((const __m256i*)(src + pos + 32 * curHalf));
+			__m256i digits = _mm256_sub_epi8(input, _mm256_set1_epi8('0'));
+			__m256i letters = _mm256_sub_epi8(_mm256_or_si256(input, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+
+			__m256i isDigit = _mm256_cmpeq_epi8(_mm256_max_epu8(digits, _mm256_set1_epi8(9)), _mm256_set1_epi8(9));
+			__m256i isLetter = _mm256_cmpeq_epi8(_mm256_max_epu8(letters, _mm256_set1_epi8(5)), _mm256_set1_epi8(5));
+
+			valid = valid && ((unsigned)_mm256_movemask_epi8(_mm256_or_si256(isDigit, isLetter)) == 0xFFFFFFFFU);
+
+			__m256i nibbles = _mm256_or_si256(_mm256_and_si256(isDigit, digits), _mm256_and_si256(isLetter, _mm256_add_epi8(letters, _mm256_set1_epi8(10))));
+			values[curHalf] = _mm256_maddubs_epi16(nibbles, _mm256_set1_epi16(0x0110));
+		}
+
+		if (!valid) break;
+
+		//packus works per lane, the 64 bit parts are brought back into order
+		__m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(values[0], values[1]), 0xD8);
+		_mm256_storeu_si256((__m256i*)(dest + pos / 2), packed);
+	}
+
+	return pos;
+}
+
+#endif
+
+size_t byte_base64_encode(unsigned char* dest, ByteView src)
+{
+	size_t consumed = 0;
+	size_t written = 0;
+
+#ifdef CPU_UTILS_X86
+	if (cpu_has_feature(CPU_FEATURE_AVX2))
+	{
+		written = __byte_codec_base64_encode_avx2(dest, src.ptr, src.len, &consumed);
+	}
+	else if (cpu_has_feature(CPU_FEATURE_SSSE3))
+	{
+		written = __byte_codec_base64_encode_ssse3(dest, src.ptr, src.len, &consumed);
+	}
+#endif
+
+	return written + __byte_codec_base64_encode_scalar(dest + written, src.ptr + consumed, src.len - consumed);
+}
+
+bool byte_base64_decode(unsigned char* dest, ByteView src, size_t* cntDecoded)
+{
+	if (src.len % 4 != 0) return false;
+
+	size_t consumed = 0;
+	size_t written = 0;
+
+#ifdef CPU_UTILS_X86
+	if (cpu_has_feature(CPU_FEATURE_AVX2))
+	{
+		written = __byte_codec_base64_decode_avx2(dest, src.ptr, src.len, &consumed);
+	}
+	else if (cpu_has_feature(CPU_FEATURE_SSSE3))
+	{
+		written = __byte_codec_base64_decode_ssse3(dest, src.ptr, src.len, &consumed);
+	}
+#endif
+
+	//the padding and invalid chars stop the kernels, the scalar tail decides
+	size_t cntTail = 0;
+	if (!__byte_codec_base64_decode_scalar(dest + written, src.ptr + consumed, src.len - consumed, &cntTail)) return false;
+
+	*cntDecoded = written + cntTail;
+
+	return true;
+}
+
+size_t byte_hex_encode(unsigned char* dest, ByteView src)
+{
+	size_t consumed = 0;
+
+#ifdef CPU_UTILS_X86
+	if (cpu_has_feature(CPU_FEATURE_AVX2))
+	{
+		consumed = __byte_codec_hex_encode_avx2(dest, src.ptr, src.len);
+	}
+	else if (cpu_has_feature(CPU_FEATURE_SSSE3))
+	{
+		consumed = __byte_codec_hex_encode_ssse3(dest, src.ptr, src.len);
+	}
+#endif
+
+	return 2 * consumed + __byte_codec_hex_encode_scalar(dest + 2 * consumed, src.ptr + consumed, src.len - consumed);
+}
+
+bool byte_hex_decode(unsigned char* dest, ByteView src, size_t* cntDecoded)
+{
+	if (src.len % 2 != 0) return false;
+
+	size_t consumed = 0;
+
+#ifdef CPU_UTILS_X86
+	if (cpu_has_feature(CPU_FEATURE_AVX2))
+	{
+		consumed = __byte_codec_hex_decode_avx2(dest, src.ptr, src.len);
+	}
+	else if (cpu_has_feature(CPU_FEATURE_SSSE3))
+	{
+		consumed = __byte_codec_hex_decode_ssse3(dest, src.ptr, src.len);
+	}
+#endif
+
+	if (!__byte_codec_hex_decode_scalar(dest + consumed / 2, src.ptr + consumed, src.len - consumed)) return false;
+
+	*cntDecoded = src.len / 2;
+
+	return true;
+}
+
+typedef enum
+{
+	BYTE_CODEC_BASE64_ENCODE,
+	BYTE_CODEC_BASE64_DECODE,
+	BYTE_CODEC_HEX_ENCODE,
+	BYTE_CODEC_HEX_DECODE
+} ByteCodecOperation;
+
+static bool __byte_codec_run(ByteCodecOperation operation, unsigned char* dest, ByteView src, size_t* cntWritten)
+{
+	switch(operation)
+	{
+		case BYTE_CODEC_BASE64_ENCODE: *cntWritten = byte_base64_encode(dest, src); return true;
+		case BYTE_CODEC_BASE64_DECODE: return byte_base64_decode(dest, src, cntWritten);
+		case BYTE_CODEC_HEX_ENCODE:    *cntWritten = byte_hex_encode(dest, src); return true;
+		case BYTE_CODEC_HEX_DECODE:    return byte_hex_decode(dest, src, cntWritten);
+	}
+
+	return false;
+}
+
+//true if src views memory of the buffer, which growing could move or the result could overwrite
+static bool __byte_codec_overlaps(ByteBuffer* buffer, ByteView src)
+{
+	uintptr_t start = (uintptr_t)buffer->buffer;
+	uintptr_t srcStart = (uintptr_t)src.ptr;
+
+	return buffer->buffer && src.len > 0 && srcStart < start + buffer->size && start < srcStart + src.len;
+}
+
+/* Growing buffers get the result written into their free space. For other modes and sources inside dest the
+   result goes over the stack or temporary memory into byte_buffer_append_bytes, which applies the overflow
+   handling of the mode.
+*/
+static bool __byte_codec_append(ByteBuffer* dest, ByteView src, size_t maxSize, ByteCodecOperation operation)
+{
+	if (!dest) return false;
+
+	size_t cntWritten = 0;
+
+	if (dest->mode == BYTE_BUFFER_GROW && !__byte_codec_overlaps(dest, src))
+	{
+		if (maxSize > SIZE_MAX - dest->offset || !byte_buffer_unshare(dest) || !byte_buffer_reserve(dest, dest->offset + maxSize)) return false;
+
+		if (!__byte_codec_run(operation, dest->buffer + dest->offset, src, &cntWritten)) return false;
+
+		dest->offset += cntWritten;
+
+		return true;
+	}
+
+	const MemAllocator* allocator = mem_allocator_get();
+	unsigned char scratch[BYTE_CODEC_SCRATCH_SIZE];
+	unsigned char* result = ( maxSize <= sizeof(scratch) ? &scratch[0] : mem_allocator_alloc(allocator, maxSize) );
+	if (!result) return false;
+
+	bool valid = __byte_codec_run(operation, result, src, &cntWritten);
+	if (valid)
+	{
+		byte_buffer_append_bytes(dest, result, cntWritten);
+	}
+
+	if (result != &scratch[0])
+	{
+		mem_allocator_free(allocator, result);
+	}
+
+	return valid;
+}
+
+bool byte_buffer_append_base64_encoded(ByteBuffer* dest, ByteView src)
+{
+	if (src.len > SIZE_MAX / 4 * 3 - 2) return false;
+
+	return __byte_codec_append(dest, src, byte_base64_encoded_size(src.len), BYTE_CODEC_BASE64_ENCODE);
+}
+
+bool byte_buffer_append_base64_decoded(ByteBuffer* dest, ByteView src)
+{
+	return __byte_codec_append(dest, src, byte_base64_decoded_size(src.len), BYTE_CODEC_BASE64_DECODE);
+}
+
+bool byte_buffer_append_hex_encoded(ByteBuffer* dest, ByteView src)
+{
+	if (src.len > SIZE_MAX / 2) return false;
+
+	return __byte_codec_append(dest, src, byte_hex_encoded_size(src.len), BYTE_CODEC_HEX_ENCODE);
+}
+
+bool byte_buffer_append_hex_decoded(ByteBuffer* dest, ByteView src)
+{
+	return __byte_codec_append(dest, src, byte_hex_decoded_size(src.len), BYTE_CODEC_HEX_DECODE);
+}
\ No newline at end of file
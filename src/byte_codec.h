@@ -0,0 +1,48 @@
+#ifndef BYTE_CODEC_H
+#define BYTE_CODEC_H
+
+#include "byte_utils.h"
+
+/* Text encodings of binary data after RFC 4648. Base64 uses the standard alphabet with padding,
+   hex is written in lower case. Decoding is strict: wrong lengths, missing or misplaced padding,
+   characters outside the alphabet and set bits in the padding are rejected. Hex accepts both cases.
+*/
+
+//sizes of the results, decoded sizes are upper bounds without looking at the padding
+static inline size_t byte_base64_encoded_size(size_t cntBytes)
+{
+    return (cntBytes + 2) / 3 * 4;
+}
+
+static inline size_t byte_base64_decoded_size(size_t cntChars)
+{
+    return cntChars / 4 * 3;
+}
+
+static inline size_t byte_hex_encoded_size(size_t cntBytes)
+{
+    return cntBytes * 2;
+}
+
+static inline size_t byte_hex_decoded_size(size_t cntChars)
+{
+    return cntChars / 2;
+}
+
+/* Raw variants writing to dest, which must hold the size of the functions above. Encoders return the
+   count of written chars, decoders return false on invalid input and set the count of written bytes.
+*/
+size_t byte_base64_encode(unsigned char* dest, ByteView src);
+bool byte_base64_decode(unsigned char* dest, ByteView src, size_t* cntDecoded);
+size_t byte_hex_encode(unsigned char* dest, ByteView src);
+bool byte_hex_decode(unsigned char* dest, ByteView src, size_t* cntDecoded);
+
+/* Appends the result like byte_buffer_append_bytes, growing buffers are written directly. Returns false
+   on invalid input or missing memory, dest is unchanged then.
+*/
+bool byte_buffer_append_base64_encoded(ByteBuffer* dest, ByteView src);
+bool byte_buffer_append_base64_decoded(ByteBuffer* dest, ByteView src);
+bool byte_buffer_append_hex_encoded(ByteBuffer* dest, ByteView src);
+bool byte_buffer_append_hex_decoded(ByteBuffer* dest, ByteView src);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,705 @@
+#include "byte_format.h"
+
+#define BYTE_FORMAT_MAX_INT_SIZE 20
+#define BYTE_FORMAT_MAX_F64_SIZE 32
+#define BYTE_FORMAT_MAX_DIGITS 24
+
+#define BYTE_FORMAT_DP_SIGNIFICAND_SIZE 52
+#define BYTE_FORMAT_DP_EXPONENT_BIAS (0x3FF + BYTE_FORMAT_DP_SIGNIFICAND_SIZE)
+#define BYTE_FORMAT_DP_MIN_EXPONENT (-BYTE_FORMAT_DP_EXPONENT_BIAS)
+#define BYTE_FORMAT_DP_EXPONENT_MASK 0x7FF0000000000000ULL
+#define BYTE_FORMAT_DP_SIGNIFICAND_MASK 0x000FFFFFFFFFFFFFULL
+#define BYTE_FORMAT_DP_HIDDEN_BIT 0x0010000000000000ULL
+
+static const char BYTE_FORMAT_DIGIT_PAIRS[] =
+	"00010203040506070809"
+	"10111213141516171819"
+	"20212223242526272829"
+	"30313233343536373839"
+	"40414243444546474849"
+	"50515253545556575859"
+	"60616263646566676869"
+	"70717273747576777879"
+	"80818283848586878889"
+	"90919293949596979899";
+
+static const char BYTE_FORMAT_HEX_DIGITS[] = "0123456789abcdef";
+
+static const uint64_t BYTE_FORMAT_POW10[] =
+{
+	1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL,
+	1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+	100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL, 100000000000000000ULL,
+	1000000000000000000ULL, 10000000000000000000ULL
+};
+
+//normalized 10^k for k = -348, -340, ..., 340, generated with exact integer arithmetic
+static const uint64_t BYTE_FORMAT_CACHED_POWERS_F[] =
+{
+	0xfa8fd5a0081c0288ULL, 0xbaaee17fa23ebf76ULL, 0x8b16fb203055ac76ULL, 0xcf42894a5dce35eaULL,
+	0x9a6bb0aa55653b2dULL, 0xe61acf033d1a45dfULL, 0xab70fe17c79ac6caULL, 0xff77b1fcbebcdc4fULL,
+	0xbe5691ef416bd60cULL, 0x8dd01fad907ffc3cULL, 0xd3515c2831559a83ULL, 0x9d71ac8fada6c9b5ULL,
+	0xea9c227723ee8bcbULL, 0xaecc49914078536dULL, 0x823c12795db6ce57ULL, 0xc21094364dfb5637ULL,
+	0x9096ea6f3848984fULL, 0xd77485cb25823ac7ULL, 0xa086cfcd97bf97f4ULL, 0xef340a98172aace5ULL,
+	0xb23867fb2a35b28eULL, 0x84c8d4dfd2c63f3bULL, 0xc5dd44271ad3cdbaULL, 0x936b9fcebb25c996ULL,
+	0xdbac6c247d62a584ULL, 0xa3ab66580d5fdaf6ULL, 0xf3e2f893dec3f126ULL, 0xb5b5ada8aaff80b8ULL,
+	0x87625f056c7c4a8bULL, 0xc9bcff6034c13053ULL, 0x964e858c91ba2655ULL, 0xdff9772470297ebdULL,
+	0xa6dfbd9fb8e5b88fULL, 0xf8a95fcf88747d94ULL, 0xb94470938fa89bcfULL, 0x8a08f0f8bf0f156bULL,
+	0xcdb02555653131b6ULL, 0x993fe2c6d07b7facULL, 0xe45c10c42a2b3b06ULL, 0xaa242499697392d3ULL,
+	0xfd87b5f28300ca0eULL, 0xbce5086492111aebULL, 0x8cbccc096f5088ccULL, 0xd1b71758e219652cULL,
+	0x9c40000000000000ULL, 0xe8d4a51000000000ULL, 0xad78ebc5ac620000ULL, 0x813f3978f8940984ULL,
+	0xc097ce7bc90715b3ULL, 0x8f7e32ce7bea5c70ULL, 0xd5d238a4abe98068ULL, 0x9f4f2726179a2245ULL,
+	0xed63a231d4c4fb27ULL, 0xb0de65388cc8ada8ULL, 0x83c7088e1aab65dbULL, 0xc45d1df942711d9aULL,
+	0x924d692ca61be758ULL, 0xda01ee641a708deaULL, 0xa26da3999aef774aULL, 0xf209787bb47d6b85ULL,
+	0xb454e4a179dd1877ULL, 0x865b86925b9bc5c2ULL, 0xc83553c5c8965d3dULL, 0x952ab45cfa97a0b3ULL,
+	0xde469fbd99a05fe3ULL, 0xa59bc234db398c25ULL, 0xf6c69a72a3989f5cULL, 0xb7dcbf5354e9beceULL,
+	0x88fcf317f22241e2ULL, 0xcc20ce9bd35c78a5ULL, 0x98165af37b2153dfULL, 0xe2a0b5dc971f303aULL,
+	0xa8d9d1535ce3b396ULL, 0xfb9b7cd9a4a7443cULL, 0xbb764c4ca7a44410ULL, 0x8bab8eefb6409c1aULL,
+	0xd01fef10a657842cULL, 0x9b10a4e5e9913129ULL, 0xe7109bfba19c0c9dULL, 0xac2820d9623bf429ULL,
+	0x80444b5e7aa7cf85ULL, 0xbf21e44003acdd2dULL, 0x8e679c2f5e44ff8fULL, 0xd433179d9c8cb841ULL,
+	0x9e19db92b4e31ba9ULL, 0xeb96bf6ebadf77d9ULL, 0xaf87023b9bf0ee6bULL
+};
+
+static const int16_t BYTE_FORMAT_CACHED_POWERS_E[] =
+{
+	-1220, -1193, -1166, -1140, -1113, -1087, -1060, -1034, -1007, -980, -954, -927,
+	-901, -874, -847, -821, -794, -768, -741, -715, -688, -661, -635, -608,
+	-582, -555, -529, -502, -475, -449, -422, -396, -369, -343, -316, -289,
+	-263, -236, -210, -183, -157, -130, -103, -77, -50, -24, 3, 30,
+	56, 83, 109, 136, 162, 189, 216, 242, 269, 295, 322, 348,
+	375, 402, 428, 455, 481, 508, 534, 561, 588, 614, 641, 667,
+	694, 720, 747, 774, 800, 827, 853, 880, 907, 933, 960, 986,
+	1013, 1039, 1066
+};
+
+//writes the digits backwards, ending before end. Returns the first digit.
+static char* __byte_format_u64(char* end, uint64_t value)
+{
+	char* cur = end;
+
+	//two digits per division
+	while (value >= 100)
+	{
+		size_t pairIdx = (size_t)(value % 100) * 2;
+		value /= 100;
+		cur -= 2;
+		memcpy(cur, &BYTE_FORMAT_DIGIT_PAIRS[pairIdx], 2);
+	}
+
+	if (value < 10)
+	{
+		*--cur = (char)('0' + value);
+	}
+	else
+	{
+		cur -= 2;
+		memcpy(cur, &BYTE_FORMAT_DIGIT_PAIRS[value * 2], 2);
+	}
+
+	return cur;
+}
+
+void byte_buffer_append_i64(ByteBuffer* buffer, int64_t value)
+{
+	char formatted[BYTE_FORMAT_MAX_INT_SIZE + 1];
+	char* end = &formatted[sizeof(formatted)];
+
+	//unsigned negation works for INT64_MIN too
+	uint64_t magnitude = ( value < 0 ? 0 - (uint64_t)value : (uint64_t)value );
+	char* first = __byte_format_u64(end, magnitude);
+
+	if (value < 0)
+	{
+		*--first = '-';
+	}
+
+	byte_buffer_append_bytes(buffer, (unsigned char*)first, (size_t)(end - first));
+}
+
+void byte_buffer_append_u64(ByteBuffer* buffer, uint64_t value)
+{
+	char formatted[BYTE_FORMAT_MAX_INT_SIZE];
+	char* end = &formatted[sizeof(formatted)];
+	char* first = __byte_format_u64(end, value);
+
+	byte_buffer_append_bytes(buffer, (unsigned char*)first, (size_t)(end - first));
+}
+
+void byte_buffer_append_hex(ByteBuffer* buffer, uint64_t value)
+{
+	char formatted[16];
+	char* end = &formatted[sizeof(formatted)];
+	char* first = end;
+
+	do
+	{
+		*--first = BYTE_FORMAT_HEX_DIGITS[value & 0xF];
+		value >>= 4;
+	} while (value > 0);
+
+	byte_buffer_append_bytes(buffer, (unsigned char*)first, (size_t)(end - first));
+}
+
+/* Grisu3 after Florian Loitsch, "Printing Floating-Point Numbers Quickly and Accurately with Integers".
+   Uses a 64 bit significand with binary exponent (diy fp) and cached powers of ten.
+*/
+typedef struct 
+{
+	uint64_t f;
+	int e;
+} ByteFormatDiyFp;
+
+static ByteFormatDiyFp __byte_format_diyfp(uint64_t f, int e)
+{
+	ByteFormatDiyFp result = { f, e };
+	return result;
+}
+
+static ByteFormatDiyFp __byte_format_diyfp_from_double(uint64_t bits)
+{
+	int biasedExponent = (int)((bits & BYTE_FORMAT_DP_EXPONENT_MASK) >> BYTE_FORMAT_DP_SIGNIFICAND_SIZE);
+	uint64_t significand = bits & BYTE_FORMAT_DP_SIGNIFICAND_MASK;
+
+	if (biasedExponent != 0)
+	{
+		return __byte_format_diyfp(significand + BYTE_FORMAT_DP_HIDDEN_BIT, biasedExponent - BYTE_FORMAT_DP_EXPONENT_BIAS);
+	}
+
+	//subnormal
+	return __byte_format_diyfp(significand, BYTE_FORMAT_DP_MIN_EXPONENT + 1);
+}
+
+static ByteFormatDiyFp __byte_format_diyfp_mul(ByteFormatDiyFp x, ByteFormatDiyFp y)
+{
+	const uint64_t mask32 = 0xFFFFFFFFULL;
+
+	uint64_t a = x.f >> 32;
+	uint64_t b = x.f & mask32;
+	uint64_t c = y.f >> 32;
+	uint64_t d = y.f & mask32;
+
+	uint64_t ac = a * c;
+	uint64_t bc = b * c;
+	uint64_t ad = a * d;
+	uint64_t bd = b * d;
+
+	uint64_t tmp = (bd >> 32) + (ad & mask32) + (bc & mask32);
+	tmp += 1ULL << 31;	//round
+
+	return __byte_format_diyfp(ac + (ad >> 32) + (bc >> 32) + (tmp >> 32), x.e + y.e + 64);
+}
+
+static ByteFormatDiyFp __byte_format_diyfp_normalize(ByteFormatDiyFp value)
+{
+	while ((value.f & (1ULL << 63)) == 0)
+	{
+		value.f <<= 1;
+		value.e--;
+	}
+
+	return value;
+}
+
+//true if the double below value is closer than the one above, which happens only at powers of two
+static bool __byte_format_lower_boundary_closer(ByteFormatDiyFp value)
+{
+	return value.f == BYTE_FORMAT_DP_HIDDEN_BIT && value.e > BYTE_FORMAT_DP_MIN_EXPONENT + 1;
+}
+
+//boundaries m- and m+ of value, both with the exponent of the normalized m+
+static void __byte_format_boundaries(ByteFormatDiyFp value, ByteFormatDiyFp* minus, ByteFormatDiyFp* plus)
+{
+	ByteFormatDiyFp upper = __byte_format_diyfp((value.f << 1) + 1, value.e - 1);
+
+	while ((upper.f & (BYTE_FORMAT_DP_HIDDEN_BIT << 1)) == 0)
+	{
+		upper.f <<= 1;
+		upper.e--;
+	}
+
+	upper.f <<= 64 - BYTE_FORMAT_DP_SIGNIFICAND_SIZE - 2;
+	upper.e -= 64 - BYTE_FORMAT_DP_SIGNIFICAND_SIZE - 2;
+
+	//the lower boundary is closer, if the significand is a power of two
+	ByteFormatDiyFp lower = ( __byte_format_lower_boundary_closer(value) ? __byte_format_diyfp((value.f << 2) - 1, value.e - 2)
+	                                                               : __byte_format_diyfp((value.f << 1) - 1, value.e - 1) );
+
+	lower.f <<= lower.e - upper.e;
+	lower.e = upper.e;
+
+	*minus = lower;
+	*plus = upper;
+}
+
+//cached power c = 10^-K, so that the product with a value of binary exponent e gets an exponent in [-60, -32]
+static ByteFormatDiyFp __byte_format_cached_power(int e, int* K)
+{
+	double dk = (-61 - e) * 0.30102999566398114 + 347;	//1/lg(10)
+	int k = (int)dk;
+	if (dk - k > 0.0)
+	{
+		k++;
+	}
+
+	unsigned index = (unsigned)((k >> 3) + 1);
+	*K = -(-348 + (int)(index * 8));
+
+	return __byte_format_diyfp(BYTE_FORMAT_CACHED_POWERS_F[index], BYTE_FORMAT_CACHED_POWERS_E[index]);
+}
+
+static int __byte_format_count_digits32(uint32_t value)
+{
+	int cntDigits = 1;
+	while (cntDigits < 10 && value >= BYTE_FORMAT_POW10[cntDigits])
+	{
+		cntDigits++;
+	}
+	return cntDigits;
+}
+
+/* Moves the last digit towards w as long as the result stays in the unsafe interval. False if the digits
+   can not be proven to be the closest shortest ones, because the imprecision of unit allows other results.
+*/
+static bool __byte_format_round_weed(char* digits, size_t cntDigits, uint64_t distanceTooHighW, uint64_t unsafeInterval,
+                                     uint64_t rest, uint64_t tenKappa, uint64_t unit)
+{
+	uint64_t smallDistance = distanceTooHighW - unit;
+	uint64_t bigDistance = distanceTooHighW + unit;
+
+	while (rest < smallDistance && unsafeInterval - rest >= tenKappa &&
+	       (rest + tenKappa < smallDistance || smallDistance - rest >= rest + tenKappa - smallDistance))
+	{
+		digits[cntDigits - 1]--;
+		rest += tenKappa;
+	}
+
+	if (rest < bigDistance && unsafeInterval - rest >= tenKappa &&
+	    (rest + tenKappa < bigDistance || bigDistance - rest > rest + tenKappa - bigDistance))
+	{
+		return false;
+	}
+
+	return 2 * unit <= rest && rest <= unsafeInterval - 4 * unit;
+}
+
+//generates the shortest digits in the interval widened by the imprecision of the scaled boundaries
+static bool __byte_format_digit_gen(ByteFormatDiyFp low, ByteFormatDiyFp w, ByteFormatDiyFp high, char* digits, size_t* cntDigits, int* K)
+{
+	uint64_t unit = 1;
+	ByteFormatDiyFp tooLow = __byte_format_diyfp(low.f - unit, low.e);
+	ByteFormatDiyFp tooHigh = __byte_format_diyfp(high.f + unit, high.e);
+	uint64_t unsafeInterval = tooHigh.f - tooLow.f;
+
+	ByteFormatDiyFp one = __byte_format_diyfp(1ULL << -w.e, w.e);
+	uint32_t integrals = (uint32_t)(tooHigh.f >> -one.e);
+	uint64_t fractionals = tooHigh.f & (one.f - 1);
+	int kappa = __byte_format_count_digits32(integrals);
+
+	*cntDigits = 0;
+
+	//integral part
+	while (kappa > 0)
+	{
+		uint32_t divisor = (uint32_t)BYTE_FORMAT_POW10[kappa - 1];
+		digits[(*cntDigits)++] = (char)('0' + integrals / divisor);
+		integrals %= divisor;
+		kappa--;
+
+		uint64_t rest = ((uint64_t)integrals << -one.e) + fractionals;
+		if (rest < unsafeInterval)
+		{
+			*K += kappa;
+			return __byte_format_round_weed(digits, *cntDigits, tooHigh.f - w.f, unsafeInterval, rest, (uint64_t)divisor << -one.e, unit);
+		}
+	}
+
+	//fractional part, the imprecision grows with every digit
+	for (;;)
+	{
+		fractionals *= 10;
+		unit *= 10;
+		unsafeInterval *= 10;
+
+		digits[(*cntDigits)++] = (char)('0' + (fractionals >> -one.e));
+		fractionals &= one.f - 1;
+		kappa--;
+
+		if (fractionals < unsafeInterval)
+		{
+			*K += kappa;
+			return __byte_format_round_weed(digits, *cntDigits, (tooHigh.f - w.f) * unit, unsafeInterval, fractionals, one.f, unit);
+		}
+	}
+}
+
+/* Grisu3: shortest digits of a positive finite value, value = digits * 10^K. False for the about 0.5% of
+   values where the 64 bit precision does not suffice to decide, which need the exact fallback.
+*/
+static bool __byte_format_grisu3(uint64_t bits, char* digits, size_t* cntDigits, int* K)
+{
+	ByteFormatDiyFp value = __byte_format_diyfp_from_double(bits);
+	ByteFormatDiyFp minus;
+	ByteFormatDiyFp plus;
+
+	__byte_format_boundaries(value, &minus, &plus);
+
+	ByteFormatDiyFp cachedPower = __byte_format_cached_power(plus.e, K);
+
+	ByteFormatDiyFp w = __byte_format_diyfp_mul(__byte_format_diyfp_normalize(value), cachedPower);
+	ByteFormatDiyFp wPlus = __byte_format_diyfp_mul(plus, cachedPower);
+	ByteFormatDiyFp wMinus = __byte_format_diyfp_mul(minus, cachedPower);
+
+	return __byte_format_digit_gen(wMinus, w, wPlus, digits, cntDigits, K);
+}
+
+/* Unsigned integers large enough for the exact fallback: the scaled values reach about 1140 bits for
+   the smallest subnormals and the largest doubles.
+*/
+#define BYTE_FORMAT_BIGNUM_LIMBS 40
+
+typedef struct
+{
+	uint32_t limbs[BYTE_FORMAT_BIGNUM_LIMBS];	//least significant first
+	size_t cntLimbs;                        	//without leading zero limbs
+} ByteFormatBignum;
+
+static void __byte_format_bignum_set(ByteFormatBignum* num, uint64_t value)
+{
+	num->limbs[0] = (uint32_t)value;
+	num->limbs[1] = (uint32_t)(value >> 32);
+	num->cntLimbs = ( value >> 32 ? 2 : ( value ? 1 : 0 ) );
+}
+
+static void __byte_format_bignum_mul_small(ByteFormatBignum* num, uint32_t factor)
+{
+	uint64_t carry = 0;
+
+	for (size_t curLimb = 0; curLimb < num->cntLimbs; curLimb++)
+	{
+		uint64_t product = (uint64_t)num->limbs[curLimb] * factor + carry;
+		num->limbs[curLimb] = (uint32_t)product;
+		carry = product >> 32;
+	}
+
+	if (carry)
+	{
+		num->limbs[num->cntLimbs++] = (uint32_t)carry;
+	}
+}
+
+static void __byte_format_bignum_mul_pow10(ByteFormatBignum* num, int exponent)
+{
+	for (; exponent >= 9; exponent -= 9)
+	{
+		__byte_format_bignum_mul_small(num, 1000000000U);
+	}
+
+	if (exponent > 0)
+	{
+		__byte_format_bignum_mul_small(num, (uint32_t)BYTE_FORMAT_POW10[exponent]);
+	}
+}
+
+static void __byte_format_bignum_shift_left(ByteFormatBignum* num, int bits)
+{
+	if (num->cntLimbs == 0 || bits <= 0) return;
+
+	size_t limbShift = (size_t)bits / 32;
+	unsigned bitShift = (unsigned)bits % 32;
+
+	if (bitShift)
+	{
+		uint32_t carry = num->limbs[num->cntLimbs - 1] >> (32 - bitShift);
+
+		for (size_t curLimb = num->cntLimbs - 1; curLimb > 0; curLimb--)
+		{
+			num->limbs[curLimb] = (num->limbs[curLimb] << bitShift) | (num->limbs[curLimb - 1] >> (32 - bitShift));
+		}
+		num->limbs[0] <<= bitShift;
+
+		if (carry)
+		{
+			num->limbs[num->cntLimbs++] = carry;
+		}
+	}
+
+	if (limbShift)
+	{
+		memmove(&num->limbs[limbShift], &num->limbs[0], num->cntLimbs * sizeof(uint32_t));
+		memset(&num->limbs[0], 0, limbShift * sizeof(uint32_t));
+		num->cntLimbs += limbShift;
+	}
+}
+
+static int __byte_format_bignum_compare(const ByteFormatBignum* a, const ByteFormatBignum* b)
+{
+	if (a->cntLimbs != b->cntLimbs) return ( a->cntLimbs < b->cntLimbs ? -1 : 1 );
+
+	for (size_t curLimb = a->cntLimbs; curLimb-- > 0;)
+	{
+		if (a->limbs[curLimb] != b->limbs[curLimb]) return ( a->limbs[curLimb] < b->limbs[curLimb] ? -1 : 1 );
+	}
+
+	return 0;
+}
+
+static void __byte_format_bignum_add(ByteFormatBignum* sum, const ByteFormatBignum* a, const ByteFormatBignum* b)
+{
+	const ByteFormatBignum* longer = ( a->cntLimbs >= b->cntLimbs ? a : b );
+	const ByteFormatBignum* shorter = ( longer == a ? b : a );
+	uint64_t carry = 0;
+
+	for (size_t curLimb = 0; curLimb < longer->cntLimbs; curLimb++)
+	{
+		carry += (uint64_t)longer->limbs[curLimb] + ( curLimb < shorter->cntLimbs ? shorter->limbs[curLimb] : 0 );
+		sum->limbs[curLimb] = (uint32_t)carry;
+		carry >>= 32;
+	}
+
+	sum->cntLimbs = longer->cntLimbs;
+
+	if (carry)
+	{
+		sum->limbs[sum->cntLimbs++] = (uint32_t)carry;
+	}
+}
+
+//num -= subtrahend, requires num >= subtrahend
+static void __byte_format_bignum_sub(ByteFormatBignum* num, const ByteFormatBignum* subtrahend)
+{
+	int64_t borrow = 0;
+
+	for (size_t curLimb = 0; curLimb < num->cntLimbs; curLimb++)
+	{
+		int64_t diff = (int64_t)num->limbs[curLimb] - ( curLimb < subtrahend->cntLimbs ? subtrahend->limbs[curLimb] : 0 ) - borrow;
+		borrow = ( diff < 0 );
+		num->limbs[curLimb] = (uint32_t)(diff + ( diff < 0 ? (1LL << 32) : 0 ));
+	}
+
+	while (num->cntLimbs > 0 && num->limbs[num->cntLimbs - 1] == 0)
+	{
+		num->cntLimbs--;
+	}
+}
+
+//compares a + b with c
+static int __byte_format_bignum_compare_sum(const ByteFormatBignum* a, const ByteFormatBignum* b, const ByteFormatBignum* c)
+{
+	ByteFormatBignum sum;
+	__byte_format_bignum_add(&sum, a, b);
+	return __byte_format_bignum_compare(&sum, c);
+}
+
+/* Exact fallback after Burger and Dybvig, "Printing Floating-Point Numbers Quickly and Accurately".
+   value = r / s with the rounding interval [r - mMinus, r + mPlus] / s, all doubled to stay integral.
+   The boundaries belong to the interval for even significands, as reading rounds ties to even.
+*/
+static void __byte_format_exact(uint64_t bits, char* digits, size_t* cntDigits, int* K)
+{
+	ByteFormatDiyFp value = __byte_format_diyfp_from_double(bits);
+	bool lowerCloser = __byte_format_lower_boundary_closer(value);
+	bool even = (value.f & 1) == 0;
+	uint64_t scale = ( lowerCloser ? 2 : 1 );
+
+	ByteFormatBignum r;
+	ByteFormatBignum s;
+	ByteFormatBignum mPlus;
+	ByteFormatBignum mMinus;
+
+	__byte_format_bignum_set(&r, value.f * 2 * scale);
+	__byte_format_bignum_set(&s, 2 * scale);
+	__byte_format_bignum_set(&mPlus, scale);
+	__byte_format_bignum_set(&mMinus, 1);
+
+	if (value.e >= 0)
+	{
+		__byte_format_bignum_shift_left(&r, value.e);
+		__byte_format_bignum_shift_left(&mPlus, value.e);
+		__byte_format_bignum_shift_left(&mMinus, value.e);
+	}
+	else
+	{
+		__byte_format_bignum_shift_left(&s, -value.e);
+	}
+
+	//estimate of ceil(log10(value)), which is never too high and corrected below
+	int significandBits = 64 - __builtin_clzll(value.f);
+	double dk = (value.e + significandBits - 1) * 0.30102999566398114 - 1e-10;
+	int k = (int)dk;
+	if (dk - k > 0.0)
+	{
+		k++;
+	}
+
+	if (k >= 0)
+	{
+		__byte_format_bignum_mul_pow10(&s, k);
+	}
+	else
+	{
+		__byte_format_bignum_mul_pow10(&r, -k);
+		__byte_format_bignum_mul_pow10(&mPlus, -k);
+		__byte_format_bignum_mul_pow10(&mMinus, -k);
+	}
+
+	//the upper boundary has to be below 1, so the first digit is not zero
+	while (__byte_format_bignum_compare_sum(&r, &mPlus, &s) >= ( even ? 0 : 1 ))
+	{
+		__byte_format_bignum_mul_small(&s, 10);
+		k++;
+	}
+
+	*cntDigits = 0;
+
+	for (;;)
+	{
+		__byte_format_bignum_mul_small(&r, 10);
+		__byte_format_bignum_mul_small(&mPlus, 10);
+		__byte_format_bignum_mul_small(&mMinus, 10);
+
+		int digit = 0;
+		while (__byte_format_bignum_compare(&r, &s) >= 0)
+		{
+			__byte_format_bignum_sub(&r, &s);
+			digit++;
+		}
+
+		//the digits so far are inside the interval, if the rest is below mMinus or the next digit above mPlus
+		int lowCompare = __byte_format_bignum_compare(&r, &mMinus);
+		int highCompare = __byte_format_bignum_compare_sum(&r, &mPlus, &s);
+		bool low = ( even ? lowCompare <= 0 : lowCompare < 0 );
+		bool high = ( even ? highCompare >= 0 : highCompare > 0 );
+
+		if (!low && !high)
+		{
+			digits[(*cntDigits)++] = (char)('0' + digit);
+			continue;
+		}
+
+		//both fit: the closer one, which is the upper one for rest >= s / 2
+		if (low && high)
+		{
+			ByteFormatBignum doubled = r;
+			__byte_format_bignum_mul_small(&doubled, 2);
+			high = __byte_format_bignum_compare(&doubled, &s) >= 0;
+		}
+
+		digits[(*cntDigits)++] = (char)('0' + digit + ( high ? 1 : 0 ));
+		break;
+	}
+
+	*K = k - (int)*cntDigits;
+}
+
+//writes digits * 10^K into out, returns the length
+static size_t __byte_format_prettify(char* out, const char* digits, size_t cntDigits, int K)
+{
+	int decimalPoint = (int)cntDigits + K;	//position of the decimal point behind the first digit
+	size_t length = 0;
+
+	if (K >= 0 && decimalPoint <= 21)
+	{
+		//integer: 1234e7 -> 12340000000
+		memcpy(out, digits, cntDigits);
+		memset(&out[cntDigits], '0', (size_t)K);
+		length = (size_t)decimalPoint;
+	}
+	else if (0 < decimalPoint && decimalPoint <= 21)
+	{
+		//1234e-2 -> 12.34
+		memcpy(out, digits, (size_t)decimalPoint);
+		out[decimalPoint] = '.';
+		memcpy(&out[decimalPoint + 1], &digits[decimalPoint], cntDigits - (size_t)decimalPoint);
+		length = cntDigits + 1;
+	}
+	else if (-6 < decimalPoint && decimalPoint <= 0)
+	{
+		//1234e-6 -> 0.001234
+		size_t cntZeros = (size_t)-decimalPoint;
+		out[0] = '0';
+		out[1] = '.';
+		memset(&out[2], '0', cntZeros);
+		memcpy(&out[2 + cntZeros], digits, cntDigits);
+		length = 2 + cntZeros + cntDigits;
+	}
+	else
+	{
+		//1234e30 -> 1.234e33
+		out[length++] = digits[0];
+
+		if (cntDigits > 1)
+		{
+			out[length++] = '.';
+			memcpy(&out[length], &digits[1], cntDigits - 1);
+			length += cntDigits - 1;
+		}
+
+		out[length++] = 'e';
+
+		int exponent = decimalPoint - 1;
+		if (exponent < 0)
+		{
+			out[length++] = '-';
+			exponent = -exponent;
+		}
+
+		char exponentDigits[4];
+		char* end = &exponentDigits[sizeof(exponentDigits)];
+		char* first = __byte_format_u64(end, (uint64_t)exponent);
+
+		memcpy(&out[length], first, (size_t)(end - first));
+		length += (size_t)(end - first);
+	}
+
+	return length;
+}
+
+void byte_buffer_append_f64(ByteBuffer* buffer, double value)
+{
+	char formatted[BYTE_FORMAT_MAX_F64_SIZE];
+	size_t length = 0;
+
+	uint64_t bits;
+	memcpy(&bits, &value, sizeof(bits));
+
+	bool negative = (bits >> 63) != 0;
+	bits &= ~(1ULL << 63);
+
+	if ((bits & BYTE_FORMAT_DP_EXPONENT_MASK) == BYTE_FORMAT_DP_EXPONENT_MASK)
+	{
+		if (bits & BYTE_FORMAT_DP_SIGNIFICAND_MASK)
+		{
+			byte_buffer_append_bytes(buffer, (unsigned char*)"nan", 3);
+		}
+		else
+		{
+			byte_buffer_append_bytes(buffer, (unsigned char*)(negative ? "-inf" : "inf"), (negative ? 4 : 3));
+		}
+		return;
+	}
+
+	if (negative)
+	{
+		formatted[length++] = '-';
+	}
+
+	if (bits == 0)
+	{
+		formatted[length++] = '0';
+	}
+	else
+	{
+		char digits[BYTE_FORMAT_MAX_DIGITS];
+		size_t cntDigits = 0;
+		int K = 0;
+
+		if (!__byte_format_grisu3(bits, &digits[0], &cntDigits, &K))
+		{
+			__byte_format_exact(bits, &digits[0], &cntDigits, &K);
+		}
+
+		length += __byte_format_prettify(&formatted[length], &digits[0], cntDigits, K);
+	}
+
+	byte_buffer_append_bytes(buffer, (unsigned char*)&formatted[0], length);
+}
\ No newline at end of file
@@ -0,0 +1,24 @@
+#ifndef BYTE_FORMAT_H
+#define BYTE_FORMAT_H
+
+#include "byte_utils.h"
+
+/* printf free number serializers. All functions append like byte_buffer_append_bytes,
+   so the mode of the buffer decides what happens on overflow.
+*/
+
+//decimal integer, e.g. "-42"
+void byte_buffer_append_i64(ByteBuffer* buffer, int64_t value);
+void byte_buffer_append_u64(ByteBuffer* buffer, uint64_t value);
+
+//lower case hexadecimal without prefix and leading zeros, e.g. "2a"
+void byte_buffer_append_hex(ByteBuffer* buffer, uint64_t value);
+
+/* shortest digits which read back to the same double, the closest of them if there are several (Grisu3,
+   exact big integer arithmetic for the few values it can not decide). Fixed notation is used
+   for decimal exponents from -6 to 20, otherwise exponential notation, e.g. "0.1", "123", "1.5e-7",
+   "1e21". Not finite values are written as "nan", "inf" and "-inf".
+*/
+void byte_buffer_append_f64(ByteBuffer* buffer, double value);
+
+#endif
\ No newline at end of file
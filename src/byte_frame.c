@@ -0,0 +1,339 @@
+#include "byte_frame.h"
+#include "byte_search.h"
+#include "byte_varint.h"
+#include "cpu_utils.h"
+
+#ifdef CPU_UTILS_X86
+	#include <immintrin.h>
+#endif
+
+static void __byte_frame_init(ByteFrameReader* frames, ByteFrameKind kind, ByteView data, ByteView delimiter)
+{
+	frames->kind = kind;
+	frames->data = data;
+	frames->delimiter = delimiter;
+	frames->position = 0;
+	frames->scanned = 0;
+	frames->maxRecordSize = 0;
+}
+
+void byte_frame_init_delimited(ByteFrameReader* _frames, ByteView data, ByteView delimiter)
+{
+	ByteFrameReader* frames = _frames;
+	if (frames)
+	{
+		__byte_frame_init(frames, BYTE_FRAME_DELIMITED, data, delimiter);
+	}
+}
+
+void byte_frame_init_prefixed(ByteFrameReader* _frames, ByteView data, ByteFrameKind kind)
+{
+	ByteFrameReader* frames = _frames;
+	if (frames)
+	{
+		__byte_frame_init(frames, kind, data, byte_view_of(NULL, 0));
+	}
+}
+
+void byte_frame_update(ByteFrameReader* _frames, ByteView data)
+{
+	ByteFrameReader* frames = _frames;
+	if (frames)
+	{
+		frames->data = data;
+	}
+}
+
+void byte_frame_rebase(ByteFrameReader* _frames, ByteView data)
+{
+	ByteFrameReader* frames = _frames;
+	if (frames)
+	{
+		frames->data = data;
+		frames->position = 0;
+	}
+}
+
+size_t byte_frame_position(ByteFrameReader* frames)
+{
+	return ( frames ? frames->position : 0 );
+}
+
+ByteView byte_frame_rest(ByteFrameReader* frames)
+{
+	return ( frames ? byte_view_suffix(frames->data, frames->position) : byte_view_of(NULL, 0) );
+}
+
+/* The search is limited to a record of maxRecordSize with its delimiter and continues behind the bytes
+   searched before, only a delimiter starting in their last bytes has to be looked at again.
+*/
+static ByteFrameStatus __byte_frame_delimited(ByteFrameReader* frames, ByteView rest, ByteView* record, size_t* cntConsumed)
+{
+	size_t cntDelimiter = frames->delimiter.len;
+	if (cntDelimiter == 0) return BYTE_FRAME_ERROR;
+
+	size_t cntSearch = rest.len;
+	if (frames->maxRecordSize > 0 && frames->maxRecordSize < SIZE_MAX - cntDelimiter && frames->maxRecordSize + cntDelimiter < cntSearch)
+	{
+		cntSearch = frames->maxRecordSize + cntDelimiter;
+	}
+
+	size_t resume = ( frames->scanned >= cntDelimiter ? frames->scanned - cntDelimiter + 1 : 0 );
+	if (resume > cntSearch) resume = cntSearch;
+
+	size_t found = byte_view_find_bytes(byte_view_slice(rest, resume, cntSearch - resume), frames->delimiter);
+
+	if (found == BYTE_SEARCH_NOT_FOUND)
+	{
+		frames->scanned = cntSearch;
+
+		//too long, if the delimiter could not start in front of the limit anymore
+		bool tooLong = frames->maxRecordSize > 0 && cntSearch >= cntDelimiter && cntSearch - cntDelimiter + 1 > frames->maxRecordSize;
+
+		return ( tooLong ? BYTE_FRAME_ERROR : BYTE_FRAME_PARTIAL );
+	}
+
+	*record = byte_view_prefix(rest, resume + found);
+	*cntConsumed = resume + found + cntDelimiter;
+
+	return BYTE_FRAME_OK;
+}
+
+static uint64_t __byte_frame_read(const unsigned char* bytes, size_t cntBytes, bool bigEndian)
+{
+	uint64_t value = 0;
+
+	for (size_t curByte = 0; curByte < cntBytes; curByte++)
+	{
+		size_t index = ( bigEndian ? curByte : cntBytes - 1 - curByte );
+		value = (value << 8) | bytes[index];
+	}
+
+	return value;
+}
+
+static ByteFrameStatus __byte_frame_prefixed(ByteFrameReader* frames, ByteView rest, ByteView* record, size_t* cntConsumed)
+{
+	uint64_t length = 0;
+	size_t cntPrefix = 0;
+
+	switch(frames->kind)
+	{
+		case BYTE_FRAME_PREFIX_U8:     cntPrefix = 1; break;
+		case BYTE_FRAME_PREFIX_U16_LE:
+		case BYTE_FRAME_PREFIX_U16_BE: cntPrefix = 2; break;
+		case BYTE_FRAME_PREFIX_U32_LE:
+		case BYTE_FRAME_PREFIX_U32_BE: cntPrefix = 4; break;
+		case BYTE_FRAME_PREFIX_UVARINT:
+		{
+			cntPrefix = byte_varint_decode(rest.ptr, rest.len, &length);
+
+			//without an end all bytes continue the varint, which is only malformed if it is already too long
+			if (cntPrefix == 0) return ( rest.len < BYTE_VARINT_MAX_SIZE ? BYTE_FRAME_PARTIAL : BYTE_FRAME_ERROR );
+			break;
+		}
+		default: return BYTE_FRAME_ERROR;
+	}
+
+	if (rest.len < cntPrefix) return BYTE_FRAME_PARTIAL;
+
+	if (frames->kind != BYTE_FRAME_PREFIX_UVARINT)
+	{
+		bool bigEndian = (frames->kind == BYTE_FRAME_PREFIX_U16_BE || frames->kind == BYTE_FRAME_PREFIX_U32_BE);
+		length = __byte_frame_read(rest.ptr, cntPrefix, bigEndian);
+	}
+
+	if (frames->maxRecordSize > 0 && length > frames->maxRecordSize) return BYTE_FRAME_ERROR;
+	if (length > rest.len - cntPrefix) return BYTE_FRAME_PARTIAL;
+
+	*record = byte_view_slice(rest, cntPrefix, (size_t)length);
+	*cntConsumed = cntPrefix + (size_t)length;
+
+	return BYTE_FRAME_OK;
+}
+
+ByteFrameStatus byte_frame_next(ByteFrameReader* _frames, ByteView* record)
+{
+	ByteFrameReader* frames = _frames;
+	if (!frames || !record) return BYTE_FRAME_ERROR;
+
+	if (frames->position >= frames->data.len) return BYTE_FRAME_END;
+
+	ByteView rest = byte_frame_rest(frames);
+	size_t cntConsumed = 0;
+
+	ByteFrameStatus status = ( frames->kind == BYTE_FRAME_DELIMITED ? __byte_frame_delimited(frames, rest, record, &cntConsumed)
+	                                                                 : __byte_frame_prefixed(frames, rest, record, &cntConsumed) );
+
+	if (status == BYTE_FRAME_OK)
+	{
+		frames->position += cntConsumed;
+		frames->scanned = 0;
+	}
+
+	return status;
+}
+
+#ifdef CPU_UTILS_X86
+
+//records in front of each delimiter bit of mask, false if the scan has to stop in front of the current record
+static inline bool __byte_frame_take(ByteFrameReader* frames, uint64_t mask, size_t pos, size_t* start, ByteView* records, size_t maxRecords, size_t* cntRecords)
+{
+	while (mask)
+	{
+		size_t end = pos + (size_t)__builtin_ctzll(mask);
+
+		//the single record path reports the error
+		if (frames->maxRecordSize > 0 && end - *start > frames->maxRecordSize) return false;
+
+		records[(*cntRecords)++] = byte_view_of(frames->data.ptr + *start, end - *start);
+		*start = end + 1;
+		mask &= mask - 1;
+
+		if (*cntRecords == maxRecords) return false;
+	}
+
+	return true;
+}
+
+//the bytes up to pos hold no further delimiter, unless the scan stopped early
+static inline void __byte_frame_split_done(ByteFrameReader* frames, size_t start, size_t pos, bool stopped)
+{
+	frames->position = start;
+	frames->scanned = ( stopped ? 0 : pos - start );
+}
+
+/* One compare over 64 bytes gives the ends of all records in them, so short records cost a few
+   instructions instead of a search call each. The remaining tail is left to byte_frame_next.
+*/
+__attribute__((target("sse2")))
+static size_t __byte_frame_split_sse2(ByteFrameReader* frames, ByteView* records, size_t maxRecords)
+{
+	const unsigned char* data = frames->data.ptr;
+	const __m128i pattern = _mm_set1_epi8((char)frames->delimiter.ptr[0]);
+	size_t start = frames->position;
+	size_t pos = start + frames->scanned;
+	size_t cntRecords = 0;
+
+	for (; pos + 64 <= frames->data.len; pos += 64)
+	{
+		__m128i first = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(data + pos)), pattern);
+		__m128i second = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(data + pos + 16)), pattern);
+		__m128i third = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(data + pos + 32)), pattern);
+		__m128i fourth = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(data + pos + 48)), pattern);
+
+		if (!_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(first, second), _mm_or_si128(third, fourth)))) continue;
+
+		uint64_t mask = (uint64_t)(unsigned)_mm_movemask_epi8(first) | ((uint64_t)(unsigned)_mm_movemask_epi8(second) << 16) |
+		                ((uint64_t)(unsigned)_mm_movemask_epi8(third) << 32) | ((uint64_t)(unsigned)_mm_movemask_epi8(fourth) << 48);
+
+		if (!__byte_frame_take(frames, mask, pos, &start, records, maxRecords, &cntRecords))
+		{
+			__byte_frame_split_done(frames, start, pos, true);
+			return cntRecords;
+		}
+	}
+
+	__byte_frame_split_done(frames, start, pos, false);
+
+	return cntRecords;
+}
+
+__attribute__((target("avx2")))
+static size_t __byte_frame_split_avx2(ByteFrameReader* frames, ByteView* records, size_t maxRecords)
+{
+	const unsigned char* data = frames->data.ptr;
+	const __m256i pattern = _mm256_set1_epi8((char)frames->delimiter.ptr[0]);
+	size_t start = frames->position;
+	size_t pos = start + frames->scanned;
+	size_t cntRecords = 0;
+
+	for (; pos + 64 <= frames->data.len; pos += 64)
+	{
+		__m256i first = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(data + pos)), pattern);
+		__m256i second = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(data + pos + 32)), pattern);
+
+		if (_mm256_testz_si256(_mm256_or_si256(first, second), _mm256_or_si256(first, second))) continue;
+
+		uint64_t mask = (uint32_t)_mm256_movemask_epi8(first) | ((uint64_t)(uint32_t)_mm256_movemask_epi8(second) << 32);
+
+		if (!__byte_frame_take(frames, mask, pos, &start, records, maxRecords, &cntRecords))
+		{
+			__byte_frame_split_done(frames, start, pos, true);
+			return cntRecords;
+		}
+	}
+
+	__byte_frame_split_done(frames, start, pos, false);
+
+	return cntRecords;
+}
+
+#endif
+
+size_t byte_frame_next_bulk(ByteFrameReader* _frames, ByteView* records, size_t maxRecords, ByteFrameStatus* status)
+{
+	ByteFrameReader* frames = _frames;
+	ByteFrameStatus result = BYTE_FRAME_ERROR;
+	size_t cntRecords = 0;
+
+	if (frames && records)
+	{
+#ifdef CPU_UTILS_X86
+		bool isSplit = frames->kind == BYTE_FRAME_DELIMITED && frames->delimiter.len == 1 && maxRecords > 0 && frames->data.ptr;
+
+		if (isSplit && cpu_has_feature(CPU_FEATURE_AVX2))
+		{
+			cntRecords = __byte_frame_split_avx2(frames, records, maxRecords);
+		}
+		else if (isSplit && cpu_has_feature(CPU_FEATURE_SSE2))
+		{
+			cntRecords = __byte_frame_split_sse2(frames, records, maxRecords);
+		}
+#endif
+
+		result = BYTE_FRAME_OK;
+		while (cntRecords < maxRecords && (result = byte_frame_next(frames, &records[cntRecords])) == BYTE_FRAME_OK)
+		{
+			cntRecords++;
+		}
+	}
+
+	if (status) *status = result;
+
+	return cntRecords;
+}
+
+bool byte_buffer_append_frame(ByteBuffer* dest, ByteFrameKind kind, ByteView record)
+{
+	if (!dest || (!record.ptr && record.len > 0)) return false;
+
+	switch(kind)
+	{
+		case BYTE_FRAME_PREFIX_U8:
+			if (record.len > UINT8_MAX) return false;
+			byte_buffer_append_byte(dest, (unsigned char)record.len);
+			break;
+		case BYTE_FRAME_PREFIX_U16_LE:
+		case BYTE_FRAME_PREFIX_U16_BE:
+			if (record.len > UINT16_MAX) return false;
+			if (kind == BYTE_FRAME_PREFIX_U16_LE) byte_buffer_put_u16_le(dest, (uint16_t)record.len);
+			else byte_buffer_put_u16_be(dest, (uint16_t)record.len);
+			break;
+		case BYTE_FRAME_PREFIX_U32_LE:
+		case BYTE_FRAME_PREFIX_U32_BE:
+			if (record.len > UINT32_MAX) return false;
+			if (kind == BYTE_FRAME_PREFIX_U32_LE) byte_buffer_put_u32_le(dest, (uint32_t)record.len);
+			else byte_buffer_put_u32_be(dest, (uint32_t)record.len);
+			break;
+		case BYTE_FRAME_PREFIX_UVARINT:
+			byte_buffer_put_uvarint(dest, record.len);
+			break;
+		default:
+			return false;
+	}
+
+	byte_buffer_append_view(dest, record);
+
+	return true;
+}
\ No newline at end of file
@@ -0,0 +1,65 @@
+#ifndef BYTE_FRAME_H
+#define BYTE_FRAME_H
+
+#include "byte_utils.h"
+
+typedef enum
+{
+    BYTE_FRAME_DELIMITED,       //records end with a delimiter of one or more bytes, which is not part of the record
+    BYTE_FRAME_PREFIX_U8,       //records follow their length, the prefix does not count itself
+    BYTE_FRAME_PREFIX_U16_LE,
+    BYTE_FRAME_PREFIX_U16_BE,
+    BYTE_FRAME_PREFIX_U32_LE,
+    BYTE_FRAME_PREFIX_U32_BE,
+    BYTE_FRAME_PREFIX_UVARINT   //LEB128 as written by byte_buffer_put_uvarint
+} ByteFrameKind;
+
+typedef enum
+{
+    BYTE_FRAME_OK,              //a record is returned
+    BYTE_FRAME_END,             //all bytes are consumed
+    BYTE_FRAME_PARTIAL,         //the rest is an incomplete record, more data is needed
+    BYTE_FRAME_ERROR            //malformed prefix or a record longer than maxRecordSize
+} ByteFrameStatus;
+
+/* Splits data into records, which are returned as views into data without copying. The viewed memory
+   must stay unchanged while the records are used, e.g. a buffer must not grow.
+   For streams the data can be replaced by a longer version of itself with byte_frame_update or by
+   its unconsumed rest with byte_frame_rebase. The delimiter is not searched twice in the same bytes.
+*/
+typedef struct
+{
+    ByteFrameKind kind;
+    ByteView data;
+    ByteView delimiter;
+    size_t position;            //start of the next record
+    size_t scanned;             //bytes from position searched for the delimiter without success
+    size_t maxRecordSize;       //longer records are an error, protects streams from unbounded input. 0 for no limit.
+} ByteFrameReader;
+
+//reading with an empty delimiter fails with BYTE_FRAME_ERROR
+void byte_frame_init_delimited(ByteFrameReader* frames, ByteView data, ByteView delimiter);
+void byte_frame_init_prefixed(ByteFrameReader* frames, ByteView data, ByteFrameKind kind);
+
+//data starts with the bytes of the previous data, e.g. the content of a buffer after appending
+void byte_frame_update(ByteFrameReader* frames, ByteView data);
+
+//data starts with the unconsumed rest of the previous data, e.g. after it was moved to the buffer start
+void byte_frame_rebase(ByteFrameReader* frames, ByteView data);
+
+//returns the next record. The position stays on PARTIAL and ERROR, so the call can be repeated.
+ByteFrameStatus byte_frame_next(ByteFrameReader* frames, ByteView* record);
+
+/* Returns up to maxRecords records at once, status gets the result after the last one. Single byte delimiters
+   are split from one SIMD scan over the data with SSE2 or AVX2, which is fastest for short records.
+*/
+size_t byte_frame_next_bulk(ByteFrameReader* frames, ByteView* records, size_t maxRecords, ByteFrameStatus* status);
+
+//consumed bytes and the rest, which holds a partial record after BYTE_FRAME_PARTIAL
+size_t byte_frame_position(ByteFrameReader* frames);
+ByteView byte_frame_rest(ByteFrameReader* frames);
+
+//appends the record with a prefix of kind, false for BYTE_FRAME_DELIMITED or a record too long for the prefix
+bool byte_buffer_append_frame(ByteBuffer* dest, ByteFrameKind kind, ByteView record);
+
+#endif
\ No newline at end of file
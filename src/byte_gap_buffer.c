@@ -0,0 +1,325 @@
+#include "byte_gap_buffer.h"
+
+#define BYTE_GAP_BUFFER_MIN_SIZE 16
+
+static size_t __byte_gap_buffer_gap(ByteGapBuffer* buffer)
+{
+	return buffer->gapEnd - buffer->gapStart;
+}
+
+//moves the gap to index, only the bytes between old and new position are moved
+static void __byte_gap_buffer_move_gap(ByteGapBuffer* _buffer, size_t index)
+{
+	ByteGapBuffer* buffer = _buffer;
+
+	if (index < buffer->gapStart)
+	{
+		size_t cntMove = buffer->gapStart - index;
+		memmove(buffer->buffer + buffer->gapEnd - cntMove, buffer->buffer + index, cntMove);
+		buffer->gapStart -= cntMove;
+		buffer->gapEnd -= cntMove;
+	}
+	else if (index > buffer->gapStart)
+	{
+		size_t cntMove = index - buffer->gapStart;
+		memmove(buffer->buffer + buffer->gapStart, buffer->buffer + buffer->gapEnd, cntMove);
+		buffer->gapStart += cntMove;
+		buffer->gapEnd += cntMove;
+	}
+}
+
+//ensures a gap of at least cntBytes, the capacity is doubled until it fits
+static bool __byte_gap_buffer_reserve_gap(ByteGapBuffer* _buffer, size_t cntBytes)
+{
+	ByteGapBuffer* buffer = _buffer;
+	size_t gapSize = __byte_gap_buffer_gap(buffer);
+
+	if (gapSize >= cntBytes) return true;
+
+	size_t length = buffer->size - gapSize;
+	if (cntBytes > SIZE_MAX - length) return false;
+
+	size_t minSize = length + cntBytes;
+	size_t newSize = (buffer->size < BYTE_GAP_BUFFER_MIN_SIZE ? BYTE_GAP_BUFFER_MIN_SIZE : buffer->size);
+	while (newSize < minSize)
+	{
+		newSize = ( newSize > SIZE_MAX / 2 ? minSize : newSize * 2 );
+	}
+
+	unsigned char* newBuffer = mem_allocator_realloc(buffer->allocator, buffer->buffer, newSize * sizeof(unsigned char));
+	if (!newBuffer) return false;
+
+	size_t cntBehindGap = buffer->size - buffer->gapEnd;
+	memmove(newBuffer + newSize - cntBehindGap, newBuffer + buffer->gapEnd, cntBehindGap);
+
+	buffer->buffer = newBuffer;
+	buffer->gapEnd = newSize - cntBehindGap;
+	buffer->size = newSize;
+
+	return true;
+}
+
+static void __byte_gap_buffer_insert_bytes_fmt_va(ByteGapBuffer* _buffer, size_t index, const char* fmt, va_list argptr)
+{
+	ByteGapBuffer* buffer = _buffer;
+	if (!buffer || index > byte_gap_buffer_length(buffer)) return;
+
+	va_list args_copy;
+	va_copy(args_copy, argptr);
+
+	int formattedSize = vsnprintf(NULL, 0, fmt, argptr);
+
+	//formats directly into the gap, the terminating zero lands in free space
+	if (formattedSize >= 0 && __byte_gap_buffer_reserve_gap(buffer, (size_t)formattedSize + 1))
+	{
+		__byte_gap_buffer_move_gap(buffer, index);
+		vsnprintf((char*)buffer->buffer + buffer->gapStart, (size_t)formattedSize + 1, fmt, args_copy);
+		buffer->gapStart += formattedSize;
+	}
+
+	va_end(args_copy);
+}
+
+ByteGapBuffer* byte_gap_buffer_new(size_t rawBuffSize)
+{
+	ByteGapBuffer* new_buf = mem_allocator_alloc(mem_allocator_get(), sizeof(ByteGapBuffer));
+
+	if (new_buf)
+	{
+		byte_gap_buffer_init_new(new_buf, rawBuffSize);
+		new_buf->allocObj = true;
+	}
+
+	return new_buf;
+}
+
+void byte_gap_buffer_init_new(ByteGapBuffer* _buffer, size_t rawBuffSize)
+{
+	ByteGapBuffer* buffer = _buffer;
+	if (buffer)
+	{
+		buffer->allocObj = false;
+		buffer->allocator = mem_allocator_get();
+		buffer->buffer = mem_allocator_alloc(buffer->allocator, rawBuffSize * sizeof(unsigned char));
+		buffer->size = (buffer->buffer ? rawBuffSize : 0);
+		buffer->gapStart = 0;
+		buffer->gapEnd = buffer->size;
+	}
+}
+
+void byte_gap_buffer_free(ByteGapBuffer** _buffer)
+{
+	ByteGapBuffer** buffer = _buffer;
+	if (buffer && *buffer)
+	{
+		ByteGapBuffer* toDelete = *buffer;
+
+		mem_allocator_free(toDelete->allocator, toDelete->buffer);
+
+		toDelete->buffer = NULL;
+		toDelete->size = 0;
+		toDelete->gapStart = 0;
+		toDelete->gapEnd = 0;
+
+		if (toDelete->allocObj)
+		{
+			mem_allocator_free(toDelete->allocator, toDelete);
+			*buffer = NULL;
+		}
+	}
+}
+
+void byte_gap_buffer_clear(ByteGapBuffer* _buffer)
+{
+	ByteGapBuffer* buffer = _buffer;
+	if (buffer)
+	{
+		buffer->gapStart = 0;
+		buffer->gapEnd = buffer->size;
+	}
+}
+
+size_t byte_gap_buffer_length(ByteGapBuffer* buffer)
+{
+	return buffer->size - __byte_gap_buffer_gap(buffer);
+}
+
+unsigned char byte_gap_buffer_get(ByteGapBuffer* buffer, size_t index)
+{
+	return ( index < buffer->gapStart ? buffer->buffer[index] : buffer->buffer[index + __byte_gap_buffer_gap(buffer)] );
+}
+
+//adding byte or bytes at the end
+void byte_gap_buffer_append_byte(ByteGapBuffer* buffer, unsigned char byte)
+{
+	if (buffer)
+	{
+		byte_gap_buffer_insert_bytes(buffer, byte_gap_buffer_length(buffer), &byte, 1);
+	}
+}
+
+void byte_gap_buffer_append_bytes(ByteGapBuffer* buffer, unsigned char* bytes, size_t cntBytes)
+{
+	if (buffer)
+	{
+		byte_gap_buffer_insert_bytes(buffer, byte_gap_buffer_length(buffer), bytes, cntBytes);
+	}
+}
+
+void byte_gap_buffer_append_bytes_fmt(ByteGapBuffer* buffer, const char* fmt, ...)
+{
+	va_list args;
+	va_start(args, fmt);
+
+	if (buffer)
+	{
+		__byte_gap_buffer_insert_bytes_fmt_va(buffer, byte_gap_buffer_length(buffer), fmt, args);
+	}
+
+	va_end(args);
+}
+
+//replace byte or bytes from given index. Bytes behind the end extend the content.
+void byte_gap_buffer_replace_byte(ByteGapBuffer* buffer, size_t index, unsigned char byte)
+{
+	byte_gap_buffer_replace_bytes(buffer, index, &byte, 1);
+}
+
+void byte_gap_buffer_replace_bytes(ByteGapBuffer* _buffer, size_t index, unsigned char* bytes, size_t cntBytes)
+{
+	ByteGapBuffer* buffer = _buffer;
+	if (buffer && index <= byte_gap_buffer_length(buffer))
+	{
+		byte_gap_buffer_remove(buffer, index, cntBytes);
+		byte_gap_buffer_insert_bytes(buffer, index, bytes, cntBytes);
+	}
+}
+
+void byte_gap_buffer_replace_bytes_fmt(ByteGapBuffer* _buffer, size_t index, const char* fmt, ...)
+{
+	va_list args;
+	va_start(args, fmt);
+
+	ByteGapBuffer* buffer = _buffer;
+	if (buffer && index <= byte_gap_buffer_length(buffer))
+	{
+		va_list args_copy;
+		va_copy(args_copy, args);
+
+		int formattedSize = vsnprintf(NULL, 0, fmt, args_copy);
+
+		va_end(args_copy);
+
+		if (formattedSize >= 0)
+		{
+			byte_gap_buffer_remove(buffer, index, (size_t)formattedSize);
+			__byte_gap_buffer_insert_bytes_fmt_va(buffer, index, fmt, args);
+		}
+	}
+
+	va_end(args);
+}
+
+//insert byte or bytes at given index. Index behind the end is ignored.
+void byte_gap_buffer_insert_byte(ByteGapBuffer* buffer, size_t index, unsigned char byte)
+{
+	byte_gap_buffer_insert_bytes(buffer, index, &byte, 1);
+}
+
+void byte_gap_buffer_insert_bytes(ByteGapBuffer* _buffer, size_t index, unsigned char* bytes, size_t cntBytes)
+{
+	ByteGapBuffer* buffer = _buffer;
+	if (buffer && index <= byte_gap_buffer_length(buffer) && __byte_gap_buffer_reserve_gap(buffer, cntBytes))
+	{
+		__byte_gap_buffer_move_gap(buffer, index);
+		memcpy(buffer->buffer + buffer->gapStart, bytes, cntBytes);
+		buffer->gapStart += cntBytes;
+	}
+}
+
+void byte_gap_buffer_insert_bytes_fmt(ByteGapBuffer* buffer, size_t index, const char* fmt, ...)
+{
+	va_list args;
+	va_start(args, fmt);
+
+	__byte_gap_buffer_insert_bytes_fmt_va(buffer, index, fmt, args);
+
+	va_end(args);
+}
+
+//insert byte or bytes at index 0
+void byte_gap_buffer_prepend_byte(ByteGapBuffer* buffer, unsigned char byte)
+{
+	byte_gap_buffer_insert_bytes(buffer, 0, &byte, 1);
+}
+
+void byte_gap_buffer_prepend_bytes(ByteGapBuffer* buffer, unsigned char* bytes, size_t cntBytes)
+{
+	byte_gap_buffer_insert_bytes(buffer, 0, bytes, cntBytes);
+}
+
+void byte_gap_buffer_prepend_bytes_fmt(ByteGapBuffer* buffer, const char* fmt, ...)
+{
+	va_list args;
+	va_start(args, fmt);
+
+	__byte_gap_buffer_insert_bytes_fmt_va(buffer, 0, fmt, args);
+
+	va_end(args);
+}
+
+void byte_gap_buffer_remove(ByteGapBuffer* _buffer, size_t index, size_t cntBytes)
+{
+	ByteGapBuffer* buffer = _buffer;
+	size_t length = ( buffer ? byte_gap_buffer_length(buffer) : 0 );
+
+	if (buffer && index < length)
+	{
+		size_t cntRemove = ( cntBytes < length - index ? cntBytes : length - index );
+
+		__byte_gap_buffer_move_gap(buffer, index);
+		buffer->gapEnd += cntRemove;
+	}
+}
+
+ByteBuffer* byte_gap_buffer_flatten(ByteGapBuffer* _buffer, ByteBufferMode resultMode)
+{
+	ByteGapBuffer* buffer = _buffer;
+	ByteBuffer* result = NULL;
+
+	if (buffer)
+	{
+		size_t length = byte_gap_buffer_length(buffer);
+
+		__byte_gap_buffer_move_gap(buffer, length);
+
+		result = mem_allocator_alloc(buffer->allocator, sizeof(ByteBuffer));
+
+		//the gap buffer keeps its memory, if there is no object to take it over
+		if (!result) return NULL;
+
+		//take over the memory instead of copying it
+		byte_buffer_init(result, resultMode, buffer->buffer, buffer->size);
+		result->alloc = true;
+		result->allocObj = true;
+		result->allocator = buffer->allocator;
+		result->offset = length;
+
+		buffer->buffer = NULL;
+		buffer->size = 0;
+		buffer->gapStart = 0;
+		buffer->gapEnd = 0;
+	}
+
+	return result;
+}
+
+void byte_gap_buffer_copy_to_buffer(ByteGapBuffer* _buffer, ByteBuffer* dest)
+{
+	ByteGapBuffer* buffer = _buffer;
+	if (buffer && dest)
+	{
+		byte_buffer_append_bytes(dest, buffer->buffer, buffer->gapStart);
+		byte_buffer_append_bytes(dest, buffer->buffer + buffer->gapEnd, buffer->size - buffer->gapEnd);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,69 @@
+#ifndef BYTE_GAP_BUFFER_H
+#define BYTE_GAP_BUFFER_H
+
+#include "byte_utils.h"
+
+/* Buffer with a movable gap of free space at the last edit position. Edits move the gap
+   to the edit index first, so repeated edits at nearby positions cost O(edit size) instead
+   of shifting the whole tail. Content is [0, gapStart) + [gapEnd, size). The capacity grows
+   by doubling if the gap is too small.
+*/
+typedef struct 
+{
+    bool allocObj;              //true, if byte_gap_buffer_new was called
+    size_t gapStart;            //first free byte, same as logical edit position
+    size_t gapEnd;              //first used byte behind the gap
+    size_t size;                //capacity of the buffer
+    unsigned char* buffer;      //the rawBuffer Data
+    const MemAllocator* allocator;      //routines for memory and the object, global allocator at init
+} ByteGapBuffer;
+
+//Allocates a complete Gap Buffer Object
+ByteGapBuffer* byte_gap_buffer_new(size_t rawBuffSize);
+
+//Handles internal memory allocation
+void byte_gap_buffer_init_new(ByteGapBuffer* buffer, size_t rawBuffSize);
+
+void byte_gap_buffer_free(ByteGapBuffer** buffer);
+
+void byte_gap_buffer_clear(ByteGapBuffer* buffer);
+
+//count of content bytes
+size_t byte_gap_buffer_length(ByteGapBuffer* buffer);
+
+//content byte at index. Index must be lower than length.
+unsigned char byte_gap_buffer_get(ByteGapBuffer* buffer, size_t index);
+
+//adding byte or bytes at the end
+void byte_gap_buffer_append_byte(ByteGapBuffer* buffer, unsigned char byte);
+void byte_gap_buffer_append_bytes(ByteGapBuffer* buffer, unsigned char* bytes, size_t cntBytes);
+void byte_gap_buffer_append_bytes_fmt(ByteGapBuffer* buffer, const char* fmt, ...);
+
+//replace byte or bytes from given index. Bytes behind the end extend the content.
+void byte_gap_buffer_replace_byte(ByteGapBuffer* buffer, size_t index, unsigned char byte);
+void byte_gap_buffer_replace_bytes(ByteGapBuffer* buffer, size_t index, unsigned char* bytes, size_t cntBytes);
+void byte_gap_buffer_replace_bytes_fmt(ByteGapBuffer* buffer, size_t index, const char* fmt, ...);
+
+//insert byte or bytes at given index. Index behind the end is ignored.
+void byte_gap_buffer_insert_byte(ByteGapBuffer* buffer, size_t index, unsigned char byte);
+void byte_gap_buffer_insert_bytes(ByteGapBuffer* buffer, size_t index, unsigned char* bytes, size_t cntBytes);
+void byte_gap_buffer_insert_bytes_fmt(ByteGapBuffer* buffer, size_t index, const char* fmt, ...);
+
+//insert byte or bytes at index 0
+void byte_gap_buffer_prepend_byte(ByteGapBuffer* buffer, unsigned char byte);
+void byte_gap_buffer_prepend_bytes(ByteGapBuffer* buffer, unsigned char* bytes, size_t cntBytes);
+void byte_gap_buffer_prepend_bytes_fmt(ByteGapBuffer* buffer, const char* fmt, ...);
+
+//removes cntBytes from given index
+void byte_gap_buffer_remove(ByteGapBuffer* buffer, size_t index, size_t cntBytes);
+
+/* Moves the gap to the end and hands the memory over to a new ByteBuffer with offset at the
+   end of content. Costs at most one memmove of the bytes behind the gap. The gap buffer is
+   empty afterwards. The Result Buffer musst be free'd by caller.
+*/
+ByteBuffer* byte_gap_buffer_flatten(ByteGapBuffer* buffer, ByteBufferMode resultMode);
+
+//appends the content to dest based on the dest mode. The gap buffer stays unchanged.
+void byte_gap_buffer_copy_to_buffer(ByteGapBuffer* buffer, ByteBuffer* dest);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,428 @@
+#include "byte_hash.h"
+#include "cpu_utils.h"
+
+#include <pthread.h>
+
+#ifdef CPU_UTILS_X86
+	#include <immintrin.h>
+#endif
+
+#define BYTE_HASH_CRC32C_POLY 0x82F63B78U       //reflected Castagnoli polynomial
+#define BYTE_HASH_BLOCK_SIZE (16 * 1024)        //both hashes take turns per block, so it is read once from memory
+
+#define BYTE_HASH_XXH64_P1 11400714785074694791ULL
+#define BYTE_HASH_XXH64_P2 14029467366897019727ULL
+#define BYTE_HASH_XXH64_P3 1609587929392839161ULL
+#define BYTE_HASH_XXH64_P4 9650029242287828579ULL
+#define BYTE_HASH_XXH64_P5 2870177450012600261ULL
+
+static uint32_t __byte_hash_crc32c_table[8][256];
+static pthread_once_t __byte_hash_crc32c_once = PTHREAD_ONCE_INIT;
+
+//table 0 is the bytewise table, table n continues a byte by n zero bytes
+static void __byte_hash_crc32c_init_tables()
+{
+	for (uint32_t curByte = 0; curByte < 256; curByte++)
+	{
+		uint32_t crc = curByte;
+
+		for (int curBit = 0; curBit < 8; curBit++)
+		{
+			crc = (crc >> 1) ^ (BYTE_HASH_CRC32C_POLY & (0U - (crc & 1)));
+		}
+
+		__byte_hash_crc32c_table[0][curByte] = crc;
+	}
+
+	for (uint32_t curByte = 0; curByte < 256; curByte++)
+	{
+		for (int curTable = 1; curTable < 8; curTable++)
+		{
+			uint32_t prev = __byte_hash_crc32c_table[curTable - 1][curByte];
+			__byte_hash_crc32c_table[curTable][curByte] = (prev >> 8) ^ __byte_hash_crc32c_table[0][prev & 0xFF];
+		}
+	}
+}
+
+//slice by 8, crc is not inverted here
+static uint32_t __byte_hash_crc32c_scalar(uint32_t crc, const unsigned char* bytes, size_t cntBytes)
+{
+	pthread_once(&__byte_hash_crc32c_once, __byte_hash_crc32c_init_tables);
+
+	const uint32_t (*table)[256] = __byte_hash_crc32c_table;
+
+	while (cntBytes >= 8)
+	{
+		crc ^= (uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8) | ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+
+		crc = table[7][crc & 0xFF] ^ table[6][(crc >> 8) & 0xFF] ^ table[5][(crc >> 16) & 0xFF] ^ table[4][crc >> 24] ^
+		      table[3][bytes[4]] ^ table[2][bytes[5]] ^ table[1][bytes[6]] ^ table[0][bytes[7]];
+
+		bytes += 8;
+		cntBytes -= 8;
+	}
+
+	while (cntBytes > 0)
+	{
+		crc = (crc >> 8) ^ table[0][(crc ^ *bytes) & 0xFF];
+		bytes++;
+		cntBytes--;
+	}
+
+	return crc;
+}
+
+#ifdef CPU_UTILS_X86
+
+#ifdef __x86_64__
+
+#define BYTE_HASH_CRC32C_LANE 1024      //bytes per lane, three lanes are computed at once
+
+//continues a crc by BYTE_HASH_CRC32C_LANE zero bytes, the crc is linear so the 4 bytes are shifted separately
+static uint32_t __byte_hash_crc32c_shift_table[4][256];
+static pthread_once_t __byte_hash_crc32c_shift_once = PTHREAD_ONCE_INIT;
+
+__attribute__((target("sse4.2")))
+static void __byte_hash_crc32c_init_shift_table()
+{
+	uint32_t shiftedBits[32];
+
+	for (int curBit = 0; curBit < 32; curBit++)
+	{
+		uint64_t crc = 1U << curBit;
+		for (size_t curWord = 0; curWord < BYTE_HASH_CRC32C_LANE / 8; curWord++)
+		{
+			crc = _mm_crc32_u64(crc, 0);
+		}
+		shiftedBits[curBit] = (uint32_t)crc;
+	}
+
+	for (int curTable = 0; curTable < 4; curTable++)
+	{
+		for (uint32_t curByte = 0; curByte < 256; curByte++)
+		{
+			uint32_t shifted = 0;
+			for (int curBit = 0; curBit < 8; curBit++)
+			{
+				if (curByte & (1U << curBit)) shifted ^= shiftedBits[curTable * 8 + curBit];
+			}
+			__byte_hash_crc32c_shift_table[curTable][curByte] = shifted;
+		}
+	}
+}
+
+static inline uint32_t __byte_hash_crc32c_shift_lane(uint32_t crc)
+{
+	return __byte_hash_crc32c_shift_table[0][crc & 0xFF] ^ __byte_hash_crc32c_shift_table[1][(crc >> 8) & 0xFF] ^
+	       __byte_hash_crc32c_shift_table[2][(crc >> 16) & 0xFF] ^ __byte_hash_crc32c_shift_table[3][crc >> 24];
+}
+
+#endif
+
+/* The crc32 instruction has a latency of three cycles but a throughput of one per cycle, so large inputs are
+   split into three independent lanes which are merged by shifting the earlier lanes over the later ones.
+*/
+__attribute__((target("sse4.2")))
+static uint32_t __byte_hash_crc32c_sse42(uint32_t crc, const unsigned char* bytes, size_t cntBytes)
+{
+#ifdef __x86_64__
+	uint64_t crc64 = crc;
+
+	if (cntBytes >= 3 * BYTE_HASH_CRC32C_LANE)
+	{
+		pthread_once(&__byte_hash_crc32c_shift_once, __byte_hash_crc32c_init_shift_table);
+	}
+
+	while (cntBytes >= 3 * BYTE_HASH_CRC32C_LANE)
+	{
+		uint64_t crcFirst = crc64, crcSecond = 0, crcThird = 0;
+
+		for (size_t curWord = 0; curWord < BYTE_HASH_CRC32C_LANE; curWord += 8)
+		{
+			uint64_t first, second, third;
+			memcpy(&first, bytes + curWord, sizeof(first));
+			memcpy(&second, bytes + BYTE_HASH_CRC32C_LANE + curWord, sizeof(second));
+			memcpy(&third, bytes + 2 * BYTE_HASH_CRC32C_LANE + curWord, sizeof(third));
+			crcFirst = _mm_crc32_u64(crcFirst, first);
+			crcSecond = _mm_crc32_u64(crcSecond, second);
+			crcThird = _mm_crc32_u64(crcThird, third);
+		}
+
+		uint32_t merged = __byte_hash_crc32c_shift_lane(__byte_hash_crc32c_shift_lane((uint32_t)crcFirst) ^ (uint32_t)crcSecond);
+		crc64 = merged ^ (uint32_t)crcThird;
+
+		bytes += 3 * BYTE_HASH_CRC32C_LANE;
+		cntBytes -= 3 * BYTE_HASH_CRC32C_LANE;
+	}
+
+	while (cntBytes >= 8)
+	{
+		uint64_t word;
+		memcpy(&word, bytes, sizeof(word));
+		crc64 = _mm_crc32_u64(crc64, word);
+		bytes += 8;
+		cntBytes -= 8;
+	}
+
+	crc = (uint32_t)crc64;
+#endif
+
+	while (cntBytes >= 4)
+	{
+		uint32_t word;
+		memcpy(&word, bytes, sizeof(word));
+		crc = _mm_crc32_u32(crc, word);
+		bytes += 4;
+		cntBytes -= 4;
+	}
+
+	while (cntBytes > 0)
+	{
+		crc = _mm_crc32_u8(crc, *bytes);
+		bytes++;
+		cntBytes--;
+	}
+
+	return crc;
+}
+
+#endif
+
+uint32_t byte_crc32c_update(uint32_t crc, const unsigned char* bytes, size_t cntBytes)
+{
+	crc = ~crc;
+
+#ifdef CPU_UTILS_X86
+	if (cpu_has_feature(CPU_FEATURE_SSE42))
+	{
+		return ~__byte_hash_crc32c_sse42(crc, bytes, cntBytes);
+	}
+#endif
+
+	return ~__byte_hash_crc32c_scalar(crc, bytes, cntBytes);
+}
+
+uint32_t byte_crc32c(const unsigned char* bytes, size_t cntBytes)
+{
+	return byte_crc32c_update(0, bytes, cntBytes);
+}
+
+static inline uint64_t __byte_hash_rotl64(uint64_t value, unsigned bits)
+{
+	return (value << bits) | (value >> (64 - bits));
+}
+
+static inline uint64_t __byte_hash_read64(const unsigned char* bytes)
+{
+	uint64_t value;
+	memcpy(&value, bytes, sizeof(value));
+	return BYTE_BUFFER_TO_LE64(value);
+}
+
+static inline uint32_t __byte_hash_read32(const unsigned char* bytes)
+{
+	uint32_t value;
+	memcpy(&value, bytes, sizeof(value));
+	return BYTE_BUFFER_TO_LE32(value);
+}
+
+static inline uint64_t __byte_hash_xxh64_round(uint64_t acc, uint64_t input)
+{
+	acc += input * BYTE_HASH_XXH64_P2;
+	acc = __byte_hash_rotl64(acc, 31);
+	return acc * BYTE_HASH_XXH64_P1;
+}
+
+static inline uint64_t __byte_hash_xxh64_merge(uint64_t hash, uint64_t acc)
+{
+	hash ^= __byte_hash_xxh64_round(0, acc);
+	return hash * BYTE_HASH_XXH64_P1 + BYTE_HASH_XXH64_P4;
+}
+
+//consumes complete 32 byte stripes, returns the count of consumed bytes
+static size_t __byte_hash_xxh64_stripes(uint64_t* acc, const unsigned char* bytes, size_t cntBytes)
+{
+	size_t consumed = 0;
+	uint64_t acc0 = acc[0], acc1 = acc[1], acc2 = acc[2], acc3 = acc[3];
+
+	for (; consumed + 32 <= cntBytes; consumed += 32)
+	{
+		const unsigned char* stripe = bytes + consumed;
+		acc0 = __byte_hash_xxh64_round(acc0, __byte_hash_read64(stripe));
+		acc1 = __byte_hash_xxh64_round(acc1, __byte_hash_read64(stripe + 8));
+		acc2 = __byte_hash_xxh64_round(acc2, __byte_hash_read64(stripe + 16));
+		acc3 = __byte_hash_xxh64_round(acc3, __byte_hash_read64(stripe + 24));
+	}
+
+	acc[0] = acc0;
+	acc[1] = acc1;
+	acc[2] = acc2;
+	acc[3] = acc3;
+
+	return consumed;
+}
+
+void byte_xxh64_init(ByteXxh64* state, uint64_t seed)
+{
+	if (state)
+	{
+		state->seed = seed;
+		state->totalBytes = 0;
+		state->acc[0] = seed + BYTE_HASH_XXH64_P1 + BYTE_HASH_XXH64_P2;
+		state->acc[1] = seed + BYTE_HASH_XXH64_P2;
+		state->acc[2] = seed;
+		state->acc[3] = seed - BYTE_HASH_XXH64_P1;
+		state->cntStripe = 0;
+	}
+}
+
+void byte_xxh64_update(ByteXxh64* state, const unsigned char* bytes, size_t cntBytes)
+{
+	if (!state || cntBytes == 0) return;
+
+	state->totalBytes += cntBytes;
+
+	//completes a stripe of the last update first
+	if (state->cntStripe > 0)
+	{
+		size_t missing = sizeof(state->stripe) - state->cntStripe;
+		size_t cntCopy = ( cntBytes < missing ? cntBytes : missing );
+
+		memcpy(state->stripe + state->cntStripe, bytes, cntCopy);
+		state->cntStripe += cntCopy;
+		bytes += cntCopy;
+		cntBytes -= cntCopy;
+
+		if (state->cntStripe < sizeof(state->stripe)) return;
+
+		__byte_hash_xxh64_stripes(state->acc, state->stripe, sizeof(state->stripe));
+		state->cntStripe = 0;
+	}
+
+	size_t consumed = __byte_hash_xxh64_stripes(state->acc, bytes, cntBytes);
+
+	memcpy(state->stripe, bytes + consumed, cntBytes - consumed);
+	state->cntStripe = cntBytes - consumed;
+}
+
+uint64_t byte_xxh64_digest(const ByteXxh64* state)
+{
+	uint64_t hash;
+
+	if (state->totalBytes >= 32)
+	{
+		hash = __byte_hash_rotl64(state->acc[0], 1) + __byte_hash_rotl64(state->acc[1], 7) +
+		       __byte_hash_rotl64(state->acc[2], 12) + __byte_hash_rotl64(state->acc[3], 18);
+
+		for (int curAcc = 0; curAcc < 4; curAcc++)
+		{
+			hash = __byte_hash_xxh64_merge(hash, state->acc[curAcc]);
+		}
+	}
+	else
+	{
+		hash = state->seed + BYTE_HASH_XXH64_P5;
+	}
+
+	hash += state->totalBytes;
+
+	const unsigned char* rest = state->stripe;
+	size_t cntRest = state->cntStripe;
+
+	for (; cntRest >= 8; rest += 8, cntRest -= 8)
+	{
+		hash ^= __byte_hash_xxh64_round(0, __byte_hash_read64(rest));
+		hash = __byte_hash_rotl64(hash, 27) * BYTE_HASH_XXH64_P1 + BYTE_HASH_XXH64_P4;
+	}
+
+	if (cntRest >= 4)
+	{
+		hash ^= (uint64_t)__byte_hash_read32(rest) * BYTE_HASH_XXH64_P1;
+		hash = __byte_hash_rotl64(hash, 23) * BYTE_HASH_XXH64_P2 + BYTE_HASH_XXH64_P3;
+		rest += 4;
+		cntRest -= 4;
+	}
+
+	for (; cntRest > 0; rest++, cntRest--)
+	{
+		hash ^= (uint64_t)*rest * BYTE_HASH_XXH64_P5;
+		hash = __byte_hash_rotl64(hash, 11) * BYTE_HASH_XXH64_P1;
+	}
+
+	hash ^= hash >> 33;
+	hash *= BYTE_HASH_XXH64_P2;
+	hash ^= hash >> 29;
+	hash *= BYTE_HASH_XXH64_P3;
+	hash ^= hash >> 32;
+
+	return hash;
+}
+
+uint64_t byte_xxh64(const unsigned char* bytes, size_t cntBytes, uint64_t seed)
+{
+	ByteXxh64 state;
+	byte_xxh64_init(&state, seed);
+	byte_xxh64_update(&state, bytes, cntBytes);
+	return byte_xxh64_digest(&state);
+}
+
+void byte_buffer_hasher_init(ByteBufferHasher* hasher, unsigned kinds, uint64_t seed)
+{
+	if (hasher)
+	{
+		hasher->kinds = kinds;
+		hasher->position = 0;
+		hasher->crc32c = 0;
+		byte_xxh64_init(&hasher->xxh64, seed);
+	}
+}
+
+bool byte_buffer_hasher_update(ByteBufferHasher* hasher, ByteBuffer* buffer)
+{
+	if (!hasher || !buffer) return false;
+
+	ByteView content = byte_view_from_content(buffer);
+	if (content.len < hasher->position) return false;
+
+	const unsigned char* bytes = content.ptr + hasher->position;
+	size_t cntBytes = content.len - hasher->position;
+
+	while (cntBytes > 0)
+	{
+		size_t cntBlock = ( cntBytes < BYTE_HASH_BLOCK_SIZE ? cntBytes : BYTE_HASH_BLOCK_SIZE );
+
+		if (hasher->kinds & BYTE_HASH_CRC32C)
+		{
+			hasher->crc32c = byte_crc32c_update(hasher->crc32c, bytes, cntBlock);
+		}
+
+		if (hasher->kinds & BYTE_HASH_XXH64)
+		{
+			byte_xxh64_update(&hasher->xxh64, bytes, cntBlock);
+		}
+
+		bytes += cntBlock;
+		cntBytes -= cntBlock;
+	}
+
+	hasher->position = content.len;
+
+	return true;
+}
+
+uint64_t byte_buffer_hasher_xxh64(const ByteBufferHasher* hasher)
+{
+	return byte_xxh64_digest(&hasher->xxh64);
+}
+
+uint32_t byte_buffer_crc32c(ByteBuffer* buffer)
+{
+	ByteView content = byte_view_from_content(buffer);
+	return byte_crc32c(content.ptr, content.len);
+}
+
+uint64_t byte_buffer_xxh64(ByteBuffer* buffer, uint64_t seed)
+{
+	ByteView content = byte_view_from_content(buffer);
+	return byte_xxh64(content.ptr, content.len, seed);
+}
\ No newline at end of file
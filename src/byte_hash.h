@@ -0,0 +1,58 @@
+#ifndef BYTE_HASH_H
+#define BYTE_HASH_H
+
+#include "byte_utils.h"
+
+/* CRC32C (Castagnoli) as used by iSCSI, ext4 and SCTP. Update takes the crc of the previous data,
+   0 for the start, so byte_crc32c_update(byte_crc32c(a), b) equals the crc of a followed by b.
+*/
+uint32_t byte_crc32c(const unsigned char* bytes, size_t cntBytes);
+uint32_t byte_crc32c_update(uint32_t crc, const unsigned char* bytes, size_t cntBytes);
+
+//streaming state of the 64 bit hash, results equal XXH64 of the same seed
+typedef struct 
+{
+    uint64_t seed;
+    uint64_t totalBytes;
+    uint64_t acc[4];            //lanes of the 32 byte stripes
+    unsigned char stripe[32];   //bytes not yet forming a complete stripe
+    size_t cntStripe;
+} ByteXxh64;
+
+uint64_t byte_xxh64(const unsigned char* bytes, size_t cntBytes, uint64_t seed);
+
+void byte_xxh64_init(ByteXxh64* state, uint64_t seed);
+void byte_xxh64_update(ByteXxh64* state, const unsigned char* bytes, size_t cntBytes);
+
+//hash of all bytes so far, the state could still be updated afterwards
+uint64_t byte_xxh64_digest(const ByteXxh64* state);
+
+typedef enum
+{
+    BYTE_HASH_CRC32C = 1 << 0,
+    BYTE_HASH_XXH64  = 1 << 1
+} ByteHashKind;
+
+/* Hashes the content of a buffer while it is written. Each update hashes only the content appended
+   since the last one, e.g. after every byte_buffer_append_bytes, while it is still in the cache.
+*/
+typedef struct 
+{
+    unsigned kinds;             //ByteHashKind bits
+    size_t position;            //content bytes already hashed
+    uint32_t crc32c;
+    ByteXxh64 xxh64;
+} ByteBufferHasher;
+
+void byte_buffer_hasher_init(ByteBufferHasher* hasher, unsigned kinds, uint64_t seed);
+
+//false if the content became shorter than the hashed part, e.g. after a clear. Nothing is hashed then.
+bool byte_buffer_hasher_update(ByteBufferHasher* hasher, ByteBuffer* buffer);
+
+uint64_t byte_buffer_hasher_xxh64(const ByteBufferHasher* hasher);
+
+//hashes over the written content, see byte_view_from_content
+uint32_t byte_buffer_crc32c(ByteBuffer* buffer);
+uint64_t byte_buffer_xxh64(ByteBuffer* buffer, uint64_t seed);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,173 @@
+#define _POSIX_C_SOURCE 200809L
+#define _XOPEN_SOURCE 700
+
+#include "byte_io.h"
+
+#include <errno.h>
+#include <limits.h>
+
+#ifdef _WIN32
+	#include <io.h>
+#else
+	#include <unistd.h>
+	#include <sys/uio.h>
+#endif
+
+#ifndef IOV_MAX
+	#define IOV_MAX 1024
+#endif
+
+#define BYTE_IO_MAX_VECTORS ( IOV_MAX < 64 ? IOV_MAX : 64 )
+
+#ifdef _WIN32
+
+//no vectored I/O, so the buffers are written one after another
+static long __byte_io_writev(int fd, ByteBuffer** buffers, size_t cntBuffers, size_t firstByte)
+{
+	for (size_t curBuffer = 0; curBuffer < cntBuffers; curBuffer++)
+	{
+		if (buffers[curBuffer]->offset > firstByte)
+		{
+			return _write(fd, buffers[curBuffer]->buffer + firstByte, (unsigned int)(buffers[curBuffer]->offset - firstByte));
+		}
+		firstByte -= buffers[curBuffer]->offset;
+	}
+	return 0;
+}
+
+static long __byte_io_readv(int fd, ByteBuffer** buffers, size_t cntBuffers)
+{
+	for (size_t curBuffer = 0; curBuffer < cntBuffers; curBuffer++)
+	{
+		ByteBuffer* buffer = buffers[curBuffer];
+		if (buffer->offset < buffer->size)
+		{
+			return _read(fd, buffer->buffer + buffer->offset, (unsigned int)(buffer->size - buffer->offset));
+		}
+	}
+	return 0;
+}
+
+#else
+
+//one writev over the buffers, starting firstByte bytes into the first buffer
+static long __byte_io_writev(int fd, ByteBuffer** buffers, size_t cntBuffers, size_t firstByte)
+{
+	struct iovec vectors[BYTE_IO_MAX_VECTORS];
+	size_t cntVectors = 0;
+
+	for (size_t curBuffer = 0; curBuffer < cntBuffers && cntVectors < BYTE_IO_MAX_VECTORS; curBuffer++)
+	{
+		ByteBuffer* buffer = buffers[curBuffer];
+		if (buffer->offset <= firstByte)
+		{
+			firstByte -= buffer->offset;
+			continue;
+		}
+
+		vectors[cntVectors].iov_base = buffer->buffer + firstByte;
+		vectors[cntVectors].iov_len = buffer->offset - firstByte;
+		cntVectors++;
+		firstByte = 0;
+	}
+
+	return writev(fd, &vectors[0], (int)cntVectors);
+}
+
+static long __byte_io_readv(int fd, ByteBuffer** buffers, size_t cntBuffers)
+{
+	struct iovec vectors[BYTE_IO_MAX_VECTORS];
+	size_t cntVectors = 0;
+
+	for (size_t curBuffer = 0; curBuffer < cntBuffers && cntVectors < BYTE_IO_MAX_VECTORS; curBuffer++)
+	{
+		ByteBuffer* buffer = buffers[curBuffer];
+		if (buffer->offset >= buffer->size) continue;
+
+		vectors[cntVectors].iov_base = buffer->buffer + buffer->offset;
+		vectors[cntVectors].iov_len = buffer->size - buffer->offset;
+		cntVectors++;
+	}
+
+	if (cntVectors == 0) return 0;
+
+	return readv(fd, &vectors[0], (int)cntVectors);
+}
+
+#endif
+
+bool byte_buffer_writev_fd(int fd, ByteBuffer** buffers, size_t cntBuffers, size_t* written)
+{
+	size_t totalBytes = 0;
+	size_t writtenBytes = 0;
+
+	for (size_t curBuffer = 0; curBuffer < cntBuffers; curBuffer++)
+	{
+		totalBytes += buffers[curBuffer]->offset;
+	}
+
+	//buffers already written completely are skipped
+	size_t skippedBuffers = 0;
+	size_t skippedBytes = 0;
+
+	while (writtenBytes < totalBytes)
+	{
+		while (skippedBytes + buffers[skippedBuffers]->offset <= writtenBytes)
+		{
+			skippedBytes += buffers[skippedBuffers]->offset;
+			skippedBuffers++;
+		}
+
+		long result = __byte_io_writev(fd, buffers + skippedBuffers, cntBuffers - skippedBuffers, writtenBytes - skippedBytes);
+
+		if (result < 0)
+		{
+			if (errno == EINTR) continue;
+
+			if (written) *written = writtenBytes;
+			return false;
+		}
+
+		writtenBytes += (size_t)result;
+	}
+
+	if (written) *written = writtenBytes;
+
+	return true;
+}
+
+bool byte_buffer_readv_fd(int fd, ByteBuffer** buffers, size_t cntBuffers, size_t* cntRead)
+{
+	long result;
+
+	//the read bytes land directly in the storage
+	for (size_t curBuffer = 0; curBuffer < cntBuffers; curBuffer++)
+	{
+		if (!byte_buffer_unshare(buffers[curBuffer])) return false;
+	}
+
+	do
+	{
+		result = __byte_io_readv(fd, buffers, cntBuffers);
+	} while (result < 0 && errno == EINTR);
+
+	if (cntRead) *cntRead = ( result > 0 ? (size_t)result : 0 );
+
+	if (result < 0) return false;
+
+	//distribute the read bytes over the offsets in the same order as the vectors
+	size_t restBytes = (size_t)result;
+	for (size_t curBuffer = 0; curBuffer < cntBuffers && restBytes > 0; curBuffer++)
+	{
+		ByteBuffer* buffer = buffers[curBuffer];
+		if (buffer->offset >= buffer->size) continue;
+
+		size_t freeBytes = buffer->size - buffer->offset;
+		size_t filledBytes = ( restBytes < freeBytes ? restBytes : freeBytes );
+
+		buffer->offset += filledBytes;
+		restBytes -= filledBytes;
+	}
+
+	return true;
+}
\ No newline at end of file
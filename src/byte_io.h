@@ -0,0 +1,18 @@
+#ifndef BYTE_IO_H
+#define BYTE_IO_H
+
+#include "byte_utils.h"
+
+/* Writes the written bytes [0, offset) of all buffers to fd with vectored writes, so several
+   buffers are sent without joining them first. Partial writes are continued and EINTR is retried.
+   Returns false on error with errno set. written holds the bytes written until then, it may be NULL.
+*/
+bool byte_buffer_writev_fd(int fd, ByteBuffer** buffers, size_t cntBuffers, size_t* written);
+
+/* Reads with one vectored read into the free bytes [offset, size) of all buffers in order and
+   advances their offsets. EINTR is retried. cntRead of 0 means end of file.
+   Returns false on error with errno set. cntRead may be NULL.
+*/
+bool byte_buffer_readv_fd(int fd, ByteBuffer** buffers, size_t cntBuffers, size_t* cntRead);
+
+#endif
\ No newline at end of file
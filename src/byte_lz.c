@@ -0,0 +1,731 @@
+#include "byte_lz.h"
+#include "byte_hash.h"
+
+#define BYTE_LZ_MIN_MATCH 4
+#define BYTE_LZ_LAST_LITERALS 5         //the block ends with literals, so the decoder can copy in words
+#define BYTE_LZ_MATCH_SEARCH_LIMIT 12   //no match starts in the last bytes of the block
+#define BYTE_LZ_HASH_LOG 12             //16 KiB table on the stack
+#define BYTE_LZ_SKIP_SHIFT 6            //the step grows by one every 64 bytes without a match
+#define BYTE_LZ_RUN_MASK 15
+
+#define BYTE_LZ_FRAME_HEADER_SIZE 6
+#define BYTE_LZ_BLOCK_HEADER_SIZE 4
+#define BYTE_LZ_BLOCK_RAW 0x80000000U
+
+static const unsigned char __byte_lz_magic[4] = { 'B', 'L', 'Z', '1' };
+
+typedef enum
+{
+	BYTE_LZ_STAGE_FRAME_HEADER,
+	BYTE_LZ_STAGE_BLOCK_HEADER,
+	BYTE_LZ_STAGE_BLOCK,
+	BYTE_LZ_STAGE_CHECKSUM
+} ByteLzStage;
+
+static inline uint32_t __byte_lz_read32(const unsigned char* bytes)
+{
+	uint32_t value;
+	memcpy(&value, bytes, sizeof(value));
+	return BYTE_BUFFER_TO_LE32(value);
+}
+
+static inline uint64_t __byte_lz_read64(const unsigned char* bytes)
+{
+	uint64_t value;
+	memcpy(&value, bytes, sizeof(value));
+	return BYTE_BUFFER_TO_LE64(value);
+}
+
+static inline void __byte_lz_write32(unsigned char* bytes, uint32_t value)
+{
+	value = BYTE_BUFFER_TO_LE32(value);
+	memcpy(bytes, &value, sizeof(value));
+}
+
+static inline size_t __byte_lz_hash(uint32_t sequence)
+{
+	return (sequence * 2654435761U) >> (32 - BYTE_LZ_HASH_LOG);
+}
+
+//count of equal bytes in front of limit
+static inline size_t __byte_lz_count(const unsigned char* in, const unsigned char* ref, const unsigned char* limit)
+{
+	const unsigned char* start = in;
+
+	while (in + 8 <= limit)
+	{
+		uint64_t diff = __byte_lz_read64(in) ^ __byte_lz_read64(ref);
+		if (diff) return (size_t)(in - start) + (size_t)__builtin_ctzll(diff) / 8;
+
+		in += 8;
+		ref += 8;
+	}
+
+	while (in < limit && *in == *ref)
+	{
+		in++;
+		ref++;
+	}
+
+	return (size_t)(in - start);
+}
+
+//the rest of a length of at least 15 as bytes of 255 and a final smaller one
+static inline unsigned char* __byte_lz_put_length(unsigned char* out, size_t length)
+{
+	if (length >= BYTE_LZ_RUN_MASK)
+	{
+		length -= BYTE_LZ_RUN_MASK;
+		for (; length >= 255; length -= 255)
+		{
+			*out++ = 255;
+		}
+		*out++ = (unsigned char)length;
+	}
+
+	return out;
+}
+
+//count of bytes __byte_lz_put_length writes for length
+static inline size_t __byte_lz_length_size(size_t length)
+{
+	return ( length >= BYTE_LZ_RUN_MASK ? (length - BYTE_LZ_RUN_MASK) / 255 + 1 : 0 );
+}
+
+//one sequence, a cntMatch of 0 writes the final literals. NULL if it does not fit.
+static unsigned char* __byte_lz_put_sequence(unsigned char* out, const unsigned char* outEnd, const unsigned char* literals,
+                                             size_t cntLiterals, size_t distance, size_t cntMatch)
+{
+	size_t matchCode = ( cntMatch > 0 ? cntMatch - BYTE_LZ_MIN_MATCH : 0 );
+	size_t sequenceSize = 1 + __byte_lz_length_size(cntLiterals) + cntLiterals + ( cntMatch > 0 ? 2 + __byte_lz_length_size(matchCode) : 0 );
+	if ((size_t)(outEnd - out) < sequenceSize) return NULL;
+
+	unsigned char* token = out++;
+	*token = (unsigned char)(( cntLiterals < BYTE_LZ_RUN_MASK ? cntLiterals : BYTE_LZ_RUN_MASK ) << 4);
+
+	out = __byte_lz_put_length(out, cntLiterals);
+	memcpy(out, literals, cntLiterals);
+	out += cntLiterals;
+
+	if (cntMatch > 0)
+	{
+		out[0] = (unsigned char)distance;
+		out[1] = (unsigned char)(distance >> 8);
+		out += 2;
+
+		*token |= (unsigned char)( matchCode < BYTE_LZ_RUN_MASK ? matchCode : BYTE_LZ_RUN_MASK );
+		out = __byte_lz_put_length(out, matchCode);
+	}
+
+	return out;
+}
+
+size_t byte_lz_compress(unsigned char* dest, size_t destSize, ByteView src)
+{
+	if (!dest || (!src.ptr && src.len > 0) || src.len > UINT32_MAX) return 0;
+
+	const unsigned char* base = src.ptr;
+	const unsigned char* end = src.ptr + src.len;
+	const unsigned char* anchor = base;
+	const unsigned char* outEnd = dest + destSize;
+	unsigned char* out = dest;
+
+	if (src.len > BYTE_LZ_MATCH_SEARCH_LIMIT)
+	{
+		//positions relative to base, unset entries point to base and fail the compare
+		uint32_t table[1 << BYTE_LZ_HASH_LOG];
+		memset(table, 0, sizeof(table));
+
+		const unsigned char* matchLimit = end - BYTE_LZ_LAST_LITERALS;
+		const unsigned char* searchLimit = end - BYTE_LZ_MATCH_SEARCH_LIMIT;
+		const unsigned char* in = base;
+
+		while (in <= searchLimit)
+		{
+			uint32_t sequence = __byte_lz_read32(in);
+			size_t hash = __byte_lz_hash(sequence);
+			const unsigned char* ref = base + table[hash];
+			table[hash] = (uint32_t)(in - base);
+
+			if (ref >= in || (size_t)(in - ref) > BYTE_LZ_MAX_DISTANCE || __byte_lz_read32(ref) != sequence)
+			{
+				in += 1 + ((size_t)(in - anchor) >> BYTE_LZ_SKIP_SHIFT);
+				continue;
+			}
+
+			while (in > anchor && ref > base && in[-1] == ref[-1])
+			{
+				in--;
+				ref--;
+			}
+
+			size_t cntMatch = BYTE_LZ_MIN_MATCH + __byte_lz_count(in + BYTE_LZ_MIN_MATCH, ref + BYTE_LZ_MIN_MATCH, matchLimit);
+
+			out = __byte_lz_put_sequence(out, outEnd, anchor, (size_t)(in - anchor), (size_t)(in - ref), cntMatch);
+			if (!out) return 0;
+
+			in += cntMatch;
+			anchor = in;
+
+			//the end of a match often starts the next one
+			if (in <= searchLimit)
+			{
+				table[__byte_lz_hash(__byte_lz_read32(in - 2))] = (uint32_t)(in - 2 - base);
+			}
+		}
+	}
+
+	out = __byte_lz_put_sequence(out, outEnd, anchor, (size_t)(end - anchor), 0, 0);
+
+	return ( out ? (size_t)(out - dest) : 0 );
+}
+
+//reads the rest of a length, false if the input ends
+static inline bool __byte_lz_get_length(const unsigned char** _in, const unsigned char* inEnd, size_t* length)
+{
+	const unsigned char* in = *_in;
+	unsigned char value;
+
+	do
+	{
+		if (in >= inEnd) return false;
+		value = *in++;
+		*length += value;
+	} while (value == 255);
+
+	*_in = in;
+
+	return true;
+}
+
+bool byte_lz_decompress(unsigned char* dest, size_t destSize, ByteView src, size_t* cntDecompressed)
+{
+	if (!dest || !src.ptr || !cntDecompressed) return false;
+
+	const unsigned char* in = src.ptr;
+	const unsigned char* inEnd = src.ptr + src.len;
+	unsigned char* out = dest;
+	unsigned char* outEnd = dest + destSize;
+
+	while (in < inEnd)
+	{
+		unsigned token = *in++;
+
+		size_t cntLiterals = token >> 4;
+		if (cntLiterals == BYTE_LZ_RUN_MASK && !__byte_lz_get_length(&in, inEnd, &cntLiterals)) return false;
+
+		//short literals are copied as one block if both sides have room
+		if (cntLiterals <= 16 && (size_t)(inEnd - in) >= 16 && (size_t)(outEnd - out) >= 16)
+		{
+			memcpy(out, in, 16);
+		}
+		else
+		{
+			if (cntLiterals > (size_t)(inEnd - in) || cntLiterals > (size_t)(outEnd - out)) return false;
+			memcpy(out, in, cntLiterals);
+		}
+
+		in += cntLiterals;
+		out += cntLiterals;
+
+		//the last sequence has no match
+		if (in == inEnd) break;
+
+		if (inEnd - in < 2) return false;
+
+		size_t distance = (size_t)in[0] | ((size_t)in[1] << 8);
+		in += 2;
+		if (distance == 0 || distance > (size_t)(out - dest)) return false;
+
+		size_t cntMatch = token & BYTE_LZ_RUN_MASK;
+		const unsigned char* ref = out - distance;
+
+		//short matches are copied as fixed 18 bytes, most sequences end here
+		if (cntMatch < BYTE_LZ_RUN_MASK && distance >= 8 && (size_t)(outEnd - out) >= 18)
+		{
+			memcpy(out, ref, 8);
+			memcpy(out + 8, ref + 8, 8);
+			memcpy(out + 16, ref + 16, 2);
+			out += cntMatch + BYTE_LZ_MIN_MATCH;
+			continue;
+		}
+
+		if (cntMatch == BYTE_LZ_RUN_MASK && !__byte_lz_get_length(&in, inEnd, &cntMatch)) return false;
+		cntMatch += BYTE_LZ_MIN_MATCH;
+
+		if (cntMatch > (size_t)(outEnd - out)) return false;
+
+		unsigned char* copyEnd = out + cntMatch;
+
+		if (distance >= 8 && (size_t)(outEnd - copyEnd) >= 8)
+		{
+			//words do not overlap, the last one may write behind the match
+			do
+			{
+				memcpy(out, ref, 8);
+				out += 8;
+				ref += 8;
+			} while (out < copyEnd);
+		}
+		else
+		{
+			//[ref, out) repeats with the distance, so the copied part doubles each round
+			while (out < copyEnd)
+			{
+				size_t cntChunk = (size_t)(out - ref);
+				if (cntChunk > (size_t)(copyEnd - out)) cntChunk = (size_t)(copyEnd - out);
+
+				memcpy(out, ref, cntChunk);
+				out += cntChunk;
+			}
+		}
+
+		out = copyEnd;
+	}
+
+	*cntDecompressed = (size_t)(out - dest);
+
+	return true;
+}
+
+static bool __byte_lz_block_size_valid(size_t blockSize)
+{
+	return blockSize >= BYTE_LZ_MIN_BLOCK_SIZE && blockSize <= BYTE_LZ_MAX_BLOCK_SIZE && (blockSize & (blockSize - 1)) == 0;
+}
+
+//false if dest could not take all bytes, e.g. a truncating buffer is full. A cut frame is useless.
+static bool __byte_lz_append(ByteBuffer* dest, const unsigned char* bytes, size_t cntBytes)
+{
+	size_t offset = dest->offset;
+	if (cntBytes > SIZE_MAX - offset) return false;
+
+	if (dest->mode == BYTE_BUFFER_GROW && !byte_buffer_reserve(dest, offset + cntBytes)) return false;
+
+	byte_buffer_append_bytes(dest, (unsigned char*)bytes, cntBytes);
+
+	return dest->offset == offset + cntBytes;
+}
+
+//stores the block compressed if that is smaller, growing buffers take the result directly
+static bool __byte_lz_encoder_put_block(ByteLzEncoder* encoder, const unsigned char* bytes, size_t cntBytes)
+{
+	ByteBuffer* dest = encoder->dest;
+	ByteView block = byte_view_of(bytes, cntBytes);
+
+	if (dest->mode == BYTE_BUFFER_GROW)
+	{
+		size_t maxSize = BYTE_LZ_BLOCK_HEADER_SIZE + cntBytes;
+		if (maxSize > SIZE_MAX - dest->offset || !byte_buffer_unshare(dest) || !byte_buffer_reserve(dest, dest->offset + maxSize)) return false;
+
+		unsigned char* out = dest->buffer + dest->offset;
+		size_t cntStored = byte_lz_compress(out + BYTE_LZ_BLOCK_HEADER_SIZE, cntBytes - 1, block);
+		uint32_t header = (uint32_t)cntStored;
+
+		if (cntStored == 0)
+		{
+			memcpy(out + BYTE_LZ_BLOCK_HEADER_SIZE, bytes, cntBytes);
+			cntStored = cntBytes;
+			header = (uint32_t)cntBytes | BYTE_LZ_BLOCK_RAW;
+		}
+
+		__byte_lz_write32(out, header);
+		dest->offset += BYTE_LZ_BLOCK_HEADER_SIZE + cntStored;
+
+		return true;
+	}
+
+	unsigned char header[BYTE_LZ_BLOCK_HEADER_SIZE];
+	size_t cntStored = byte_lz_compress(encoder->scratch, cntBytes - 1, block);
+
+	if (cntStored == 0)
+	{
+		__byte_lz_write32(header, (uint32_t)cntBytes | BYTE_LZ_BLOCK_RAW);
+		return __byte_lz_append(dest, header, sizeof(header)) && __byte_lz_append(dest, bytes, cntBytes);
+	}
+
+	__byte_lz_write32(header, (uint32_t)cntStored);
+
+	return __byte_lz_append(dest, header, sizeof(header)) && __byte_lz_append(dest, encoder->scratch, cntStored);
+}
+
+ByteLzEncoder* byte_lz_encoder_new(ByteBuffer* dest, size_t blockSize, unsigned flags)
+{
+	const MemAllocator* allocator = mem_allocator_get();
+	ByteLzEncoder* new_encoder = mem_allocator_alloc(allocator, sizeof(ByteLzEncoder));
+
+	if (new_encoder && !byte_lz_encoder_init(new_encoder, dest, blockSize, flags))
+	{
+		mem_allocator_free(allocator, new_encoder);
+		new_encoder = NULL;
+	}
+
+	if (new_encoder)
+	{
+		new_encoder->allocObj = true;
+	}
+
+	return new_encoder;
+}
+
+bool byte_lz_encoder_init(ByteLzEncoder* _encoder, ByteBuffer* dest, size_t blockSize, unsigned flags)
+{
+	ByteLzEncoder* encoder = _encoder;
+	if (!encoder) return false;
+
+	encoder->allocObj = false;
+	encoder->dest = dest;
+	encoder->blockSize = ( blockSize == 0 ? BYTE_LZ_DEFAULT_BLOCK_SIZE : blockSize );
+	encoder->flags = flags & BYTE_LZ_FLAG_CHECKSUM;
+	encoder->block = NULL;
+	encoder->cntBlock = 0;
+	encoder->scratch = NULL;
+	encoder->crc32c = 0;
+	encoder->finished = true;
+	encoder->allocator = mem_allocator_get();
+
+	if (!dest || !__byte_lz_block_size_valid(encoder->blockSize)) return false;
+
+	unsigned char header[BYTE_LZ_FRAME_HEADER_SIZE];
+	memcpy(header, __byte_lz_magic, sizeof(__byte_lz_magic));
+	header[4] = (unsigned char)__builtin_ctzll(encoder->blockSize);
+	header[5] = (unsigned char)encoder->flags;
+
+	encoder->block = mem_allocator_alloc(encoder->allocator, 2 * encoder->blockSize);
+	if (!encoder->block || !__byte_lz_append(dest, header, sizeof(header)))
+	{
+		mem_allocator_free(encoder->allocator, encoder->block);
+		encoder->block = NULL;
+		return false;
+	}
+
+	encoder->scratch = encoder->block + encoder->blockSize;
+	encoder->finished = false;
+
+	return true;
+}
+
+void byte_lz_encoder_free(ByteLzEncoder** _encoder)
+{
+	ByteLzEncoder** encoder = _encoder;
+	if (encoder && *encoder)
+	{
+		ByteLzEncoder* toDelete = *encoder;
+
+		mem_allocator_free(toDelete->allocator, toDelete->block);
+		toDelete->block = NULL;
+		toDelete->scratch = NULL;
+		toDelete->cntBlock = 0;
+		toDelete->finished = true;
+
+		if (toDelete->allocObj)
+		{
+			mem_allocator_free(toDelete->allocator, toDelete);
+			*encoder = NULL;
+		}
+	}
+}
+
+bool byte_lz_encoder_write(ByteLzEncoder* _encoder, ByteView src)
+{
+	ByteLzEncoder* encoder = _encoder;
+	if (!encoder || encoder->finished || (!src.ptr && src.len > 0)) return false;
+
+	if (encoder->flags & BYTE_LZ_FLAG_CHECKSUM)
+	{
+		encoder->crc32c = byte_crc32c_update(encoder->crc32c, src.ptr, src.len);
+	}
+
+	const unsigned char* in = src.ptr;
+	size_t remaining = src.len;
+
+	//a started block is filled up first
+	if (encoder->cntBlock > 0)
+	{
+		size_t cntTake = encoder->blockSize - encoder->cntBlock;
+		if (cntTake > remaining) cntTake = remaining;
+
+		memcpy(encoder->block + encoder->cntBlock, in, cntTake);
+		encoder->cntBlock += cntTake;
+		in += cntTake;
+		remaining -= cntTake;
+
+		if (encoder->cntBlock < encoder->blockSize) return true;
+
+		if (!__byte_lz_encoder_put_block(encoder, encoder->block, encoder->blockSize)) return false;
+		encoder->cntBlock = 0;
+	}
+
+	//complete blocks are compressed without copying them
+	for (; remaining >= encoder->blockSize; remaining -= encoder->blockSize)
+	{
+		if (!__byte_lz_encoder_put_block(encoder, in, encoder->blockSize)) return false;
+		in += encoder->blockSize;
+	}
+
+	if (remaining > 0)
+	{
+		memcpy(encoder->block, in, remaining);
+		encoder->cntBlock = remaining;
+	}
+
+	return true;
+}
+
+bool byte_lz_encoder_finish(ByteLzEncoder* _encoder)
+{
+	ByteLzEncoder* encoder = _encoder;
+	if (!encoder || encoder->finished) return false;
+
+	if (encoder->cntBlock > 0 && !__byte_lz_encoder_put_block(encoder, encoder->block, encoder->cntBlock)) return false;
+
+	encoder->cntBlock = 0;
+	encoder->finished = true;
+
+	unsigned char trailer[2 * BYTE_LZ_BLOCK_HEADER_SIZE];
+	__byte_lz_write32(trailer, 0);
+	__byte_lz_write32(trailer + BYTE_LZ_BLOCK_HEADER_SIZE, encoder->crc32c);
+
+	return __byte_lz_append(encoder->dest, trailer, ( encoder->flags & BYTE_LZ_FLAG_CHECKSUM ? 8 : 4 ));
+}
+
+ByteLzDecoder* byte_lz_decoder_new(ByteBuffer* dest)
+{
+	ByteLzDecoder* new_decoder = mem_allocator_alloc(mem_allocator_get(), sizeof(ByteLzDecoder));
+
+	byte_lz_decoder_init(new_decoder, dest);
+
+	if (new_decoder)
+	{
+		new_decoder->allocObj = true;
+	}
+
+	return new_decoder;
+}
+
+void byte_lz_decoder_init(ByteLzDecoder* _decoder, ByteBuffer* dest)
+{
+	ByteLzDecoder* decoder = _decoder;
+	if (decoder)
+	{
+		decoder->allocObj = false;
+		decoder->dest = dest;
+		decoder->status = ( dest ? BYTE_LZ_OK : BYTE_LZ_ERROR );
+		decoder->stage = BYTE_LZ_STAGE_FRAME_HEADER;
+		decoder->blockSize = 0;
+		decoder->flags = 0;
+		decoder->cntNeeded = BYTE_LZ_FRAME_HEADER_SIZE;
+		decoder->storedRaw = false;
+		decoder->staging = NULL;
+		decoder->cntStaged = 0;
+		decoder->scratch = NULL;
+		decoder->crc32c = 0;
+		decoder->allocator = mem_allocator_get();
+	}
+}
+
+void byte_lz_decoder_free(ByteLzDecoder** _decoder)
+{
+	ByteLzDecoder** decoder = _decoder;
+	if (decoder && *decoder)
+	{
+		ByteLzDecoder* toDelete = *decoder;
+
+		mem_allocator_free(toDelete->allocator, toDelete->staging);
+		toDelete->staging = NULL;
+		toDelete->scratch = NULL;
+		toDelete->cntStaged = 0;
+
+		if (toDelete->allocObj)
+		{
+			mem_allocator_free(toDelete->allocator, toDelete);
+			*decoder = NULL;
+		}
+	}
+}
+
+static bool __byte_lz_decoder_block(ByteLzDecoder* decoder, const unsigned char* block)
+{
+	ByteBuffer* dest = decoder->dest;
+	size_t cntStored = decoder->cntNeeded;
+	size_t cntDecompressed = cntStored;
+
+	if (decoder->storedRaw)
+	{
+		if (decoder->flags & BYTE_LZ_FLAG_CHECKSUM)
+		{
+			decoder->crc32c = byte_crc32c_update(decoder->crc32c, block, cntStored);
+		}
+
+		return __byte_lz_append(dest, block, cntStored);
+	}
+
+	bool isGrowing = (dest->mode == BYTE_BUFFER_GROW);
+	unsigned char* out = decoder->scratch;
+
+	if (isGrowing)
+	{
+		if (decoder->blockSize > SIZE_MAX - dest->offset || !byte_buffer_unshare(dest) || !byte_buffer_reserve(dest, dest->offset + decoder->blockSize)) return false;
+		out = dest->buffer + dest->offset;
+	}
+
+	if (!byte_lz_decompress(out, decoder->blockSize, byte_view_of(block, cntStored), &cntDecompressed)) return false;
+
+	if (decoder->flags & BYTE_LZ_FLAG_CHECKSUM)
+	{
+		decoder->crc32c = byte_crc32c_update(decoder->crc32c, out, cntDecompressed);
+	}
+
+	if (!isGrowing) return __byte_lz_append(dest, out, cntDecompressed);
+
+	dest->offset += cntDecompressed;
+
+	return true;
+}
+
+//handles a complete part of the frame and sets the next expected one
+static ByteLzStatus __byte_lz_decoder_part(ByteLzDecoder* decoder, const unsigned char* part)
+{
+	switch(decoder->stage)
+	{
+		case BYTE_LZ_STAGE_FRAME_HEADER:
+		{
+			if (memcmp(part, __byte_lz_magic, sizeof(__byte_lz_magic)) != 0 || part[4] >= sizeof(size_t) * 8 ||
+			    !__byte_lz_block_size_valid((size_t)1 << part[4]) || (part[5] & ~BYTE_LZ_FLAG_CHECKSUM) != 0) return BYTE_LZ_ERROR;
+
+			decoder->blockSize = (size_t)1 << part[4];
+			decoder->flags = part[5];
+			decoder->staging = mem_allocator_alloc(decoder->allocator, 2 * decoder->blockSize);
+			if (!decoder->staging) return BYTE_LZ_ERROR;
+
+			decoder->scratch = decoder->staging + decoder->blockSize;
+			decoder->stage = BYTE_LZ_STAGE_BLOCK_HEADER;
+			decoder->cntNeeded = BYTE_LZ_BLOCK_HEADER_SIZE;
+
+			return BYTE_LZ_OK;
+		}
+		case BYTE_LZ_STAGE_BLOCK_HEADER:
+		{
+			uint32_t header = __byte_lz_read32(part);
+
+			if (header == 0)
+			{
+				if (!(decoder->flags & BYTE_LZ_FLAG_CHECKSUM)) return BYTE_LZ_END;
+
+				decoder->stage = BYTE_LZ_STAGE_CHECKSUM;
+				decoder->cntNeeded = BYTE_LZ_BLOCK_HEADER_SIZE;
+
+				return BYTE_LZ_OK;
+			}
+
+			decoder->storedRaw = (header & BYTE_LZ_BLOCK_RAW) != 0;
+			decoder->cntNeeded = header & ~BYTE_LZ_BLOCK_RAW;
+			if (decoder->cntNeeded == 0 || decoder->cntNeeded > decoder->blockSize) return BYTE_LZ_ERROR;
+
+			decoder->stage = BYTE_LZ_STAGE_BLOCK;
+
+			return BYTE_LZ_OK;
+		}
+		case BYTE_LZ_STAGE_BLOCK:
+		{
+			if (!__byte_lz_decoder_block(decoder, part)) return BYTE_LZ_ERROR;
+
+			decoder->stage = BYTE_LZ_STAGE_BLOCK_HEADER;
+			decoder->cntNeeded = BYTE_LZ_BLOCK_HEADER_SIZE;
+
+			return BYTE_LZ_OK;
+		}
+		case BYTE_LZ_STAGE_CHECKSUM:
+		{
+			return ( __byte_lz_read32(part) == decoder->crc32c ? BYTE_LZ_END : BYTE_LZ_ERROR );
+		}
+	}
+
+	return BYTE_LZ_ERROR;
+}
+
+ByteLzStatus byte_lz_decoder_write(ByteLzDecoder* _decoder, ByteView src, size_t* consumed)
+{
+	ByteLzDecoder* decoder = _decoder;
+	size_t position = 0;
+
+	if (consumed) *consumed = 0;
+	if (!decoder) return BYTE_LZ_ERROR;
+	if (!src.ptr && src.len > 0) return decoder->status;
+
+	while (decoder->status == BYTE_LZ_OK && position < src.len)
+	{
+		size_t available = src.len - position;
+		const unsigned char* part = src.ptr + position;
+
+		if (decoder->cntStaged == 0 && available >= decoder->cntNeeded)
+		{
+			//complete in src, no copy needed
+			position += decoder->cntNeeded;
+		}
+		else
+		{
+			unsigned char* collected = ( decoder->stage == BYTE_LZ_STAGE_BLOCK ? decoder->staging : decoder->header );
+			size_t cntTake = decoder->cntNeeded - decoder->cntStaged;
+			if (cntTake > available) cntTake = available;
+
+			memcpy(collected + decoder->cntStaged, part, cntTake);
+			decoder->cntStaged += cntTake;
+			position += cntTake;
+
+			if (decoder->cntStaged < decoder->cntNeeded) break;
+
+			part = collected;
+			decoder->cntStaged = 0;
+		}
+
+		decoder->status = __byte_lz_decoder_part(decoder, part);
+	}
+
+	if (consumed) *consumed = position;
+
+	return decoder->status;
+}
+
+bool byte_buffer_append_lz_compressed(ByteBuffer* dest, ByteView src)
+{
+	if (!dest) return false;
+
+	size_t offset = dest->offset;
+	ByteLzEncoder encoder;
+	ByteLzEncoder* encoderPtr = &encoder;
+
+	bool done = byte_lz_encoder_init(&encoder, dest, 0, BYTE_LZ_FLAG_CHECKSUM) &&
+	            byte_lz_encoder_write(&encoder, src) &&
+	            byte_lz_encoder_finish(&encoder);
+
+	byte_lz_encoder_free(&encoderPtr);
+
+	if (!done)
+	{
+		dest->offset = offset;
+	}
+
+	return done;
+}
+
+bool byte_buffer_append_lz_decompressed(ByteBuffer* dest, ByteView src)
+{
+	if (!dest) return false;
+
+	size_t offset = dest->offset;
+	size_t consumed = 0;
+	ByteLzDecoder decoder;
+	ByteLzDecoder* decoderPtr = &decoder;
+
+	byte_lz_decoder_init(&decoder, dest);
+	bool done = byte_lz_decoder_write(&decoder, src, &consumed) == BYTE_LZ_END && consumed == src.len;
+
+	byte_lz_decoder_free(&decoderPtr);
+
+	if (!done)
+	{
+		dest->offset = offset;
+	}
+
+	return done;
+}
\ No newline at end of file
@@ -0,0 +1,118 @@
+#ifndef BYTE_LZ_H
+#define BYTE_LZ_H
+
+#include "byte_utils.h"
+
+/* LZ77 compression in the block format of LZ4: sequences of literals and matches of at least 4 bytes
+   within the last 64 KiB. Fast greedy matching over a hash table, no entropy coding.
+*/
+
+#define BYTE_LZ_MAX_DISTANCE 65535
+
+//size of dest that always takes the compressed block of cntBytes
+static inline size_t byte_lz_compress_bound(size_t cntBytes)
+{
+    return cntBytes + cntBytes / 255 + 16;
+}
+
+//compresses src to one block. Returns the compressed size, 0 if it does not fit into destSize or src exceeds 4 GiB.
+size_t byte_lz_compress(unsigned char* dest, size_t destSize, ByteView src);
+
+/* decompresses one block. False if the block is malformed or its result is larger than destSize,
+   the input is never read or written out of bounds then.
+*/
+bool byte_lz_decompress(unsigned char* dest, size_t destSize, ByteView src, size_t* cntDecompressed);
+
+/* Frame format for streams: "BLZ1", log2 of the block size and flags, followed by blocks of a 32 bit LE
+   header and the data. The header holds the stored size, the high bit marks blocks stored uncompressed.
+   A header of 0 ends the frame, followed by the crc32c of the content if BYTE_LZ_FLAG_CHECKSUM is set.
+   Blocks are independent, so each can be decompressed on its own.
+*/
+#define BYTE_LZ_DEFAULT_BLOCK_SIZE (64 * 1024)
+#define BYTE_LZ_MIN_BLOCK_SIZE (1 << 10)
+#define BYTE_LZ_MAX_BLOCK_SIZE (1 << 22)
+
+typedef enum
+{
+    BYTE_LZ_FLAG_CHECKSUM = 1 << 0      //crc32c of the uncompressed content at the end of the frame
+} ByteLzFlag;
+
+typedef enum
+{
+    BYTE_LZ_OK,         //input is taken, the frame is not complete yet
+    BYTE_LZ_END,        //the frame is complete
+    BYTE_LZ_ERROR       //malformed frame, wrong checksum, missing memory or dest without space
+} ByteLzStatus;
+
+/* Compresses written bytes block wise and appends the frame to dest. A complete block is appended as soon
+   as it is filled, so dest can be drained between writes, e.g. into a ByteWriter. Every append must fit
+   completely, a truncating, skipping or wrapping dest without space fails instead of cutting the frame.
+*/
+typedef struct
+{
+    bool allocObj;              //true, if byte_lz_encoder_new was called
+    ByteBuffer* dest;
+    size_t blockSize;
+    unsigned flags;
+    unsigned char* block;       //collected bytes of the next block
+    size_t cntBlock;
+    unsigned char* scratch;     //compressed block if dest is not growing
+    uint32_t crc32c;
+    bool finished;
+    const MemAllocator* allocator;      //routines for block memory and the object, global allocator at init
+} ByteLzEncoder;
+
+//blockSize must be a power of two between the min and max size, 0 for the default. NULL on error.
+ByteLzEncoder* byte_lz_encoder_new(ByteBuffer* dest, size_t blockSize, unsigned flags);
+
+//appends the frame header to dest, false on error
+bool byte_lz_encoder_init(ByteLzEncoder* encoder, ByteBuffer* dest, size_t blockSize, unsigned flags);
+
+void byte_lz_encoder_free(ByteLzEncoder** encoder);
+
+//false on missing memory, a full dest or after finish
+bool byte_lz_encoder_write(ByteLzEncoder* encoder, ByteView src);
+
+//appends the last block and the end of the frame
+bool byte_lz_encoder_finish(ByteLzEncoder* encoder);
+
+/* Takes a frame in pieces of any size and appends the decompressed blocks to dest. Complete blocks in the
+   written piece are decompressed without copying them first.
+*/
+typedef struct
+{
+    bool allocObj;              //true, if byte_lz_decoder_new was called
+    ByteBuffer* dest;
+    ByteLzStatus status;
+    int stage;                  //part of the frame expected next
+    size_t blockSize;
+    unsigned flags;
+    size_t cntNeeded;           //size of the expected part
+    bool storedRaw;             //the expected block is not compressed
+    unsigned char header[8];    //collected frame header, block header or checksum
+    unsigned char* staging;     //collected block split over writes
+    size_t cntStaged;
+    unsigned char* scratch;     //decompressed block if dest is not growing
+    uint32_t crc32c;
+    const MemAllocator* allocator;      //routines for staging memory and the object, global allocator at init
+} ByteLzDecoder;
+
+ByteLzDecoder* byte_lz_decoder_new(ByteBuffer* dest);
+
+void byte_lz_decoder_init(ByteLzDecoder* decoder, ByteBuffer* dest);
+
+void byte_lz_decoder_free(ByteLzDecoder** decoder);
+
+/* Consumes src until the frame is complete. consumed gets the count of taken bytes, which is less than
+   src.len only if the frame ended before. After an error or the end every write returns the same status.
+*/
+ByteLzStatus byte_lz_decoder_write(ByteLzDecoder* decoder, ByteView src, size_t* consumed);
+
+/* Appends src as a complete frame with checksum, or the content of the single frame in src. False on
+   error, trailing bytes behind the frame or a dest not taking the complete result, e.g. a truncating
+   buffer without space. The offset of dest is restored then.
+*/
+bool byte_buffer_append_lz_compressed(ByteBuffer* dest, ByteView src);
+bool byte_buffer_append_lz_decompressed(ByteBuffer* dest, ByteView src);
+
+#endif
\ No newline at end of file
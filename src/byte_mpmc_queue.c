@@ -0,0 +1,212 @@
+#include "byte_mpmc_queue.h"
+
+static size_t __byte_mpmc_queue_round_pow2(size_t value)
+{
+	size_t pow2 = 1;
+	while (pow2 < value && pow2 <= SIZE_MAX / 2)
+	{
+		pow2 *= 2;
+	}
+	return pow2;
+}
+
+ByteMpmcQueue* byte_mpmc_queue_new(size_t slotCount, size_t recordSize)
+{
+	const MemAllocator* allocator = mem_allocator_get();
+	ByteMpmcQueue* new_queue = mem_allocator_alloc(allocator, sizeof(ByteMpmcQueue));
+
+	if (new_queue && !byte_mpmc_queue_init_new(new_queue, slotCount, recordSize))
+	{
+		mem_allocator_free(allocator, new_queue);
+		return NULL;
+	}
+
+	if (new_queue)
+	{
+		new_queue->allocObj = true;
+	}
+
+	return new_queue;
+}
+
+bool byte_mpmc_queue_init_new(ByteMpmcQueue* _queue, size_t slotCount, size_t recordSize)
+{
+	ByteMpmcQueue* queue = _queue;
+	if (!queue) return false;
+
+	size_t cntSlots = __byte_mpmc_queue_round_pow2(slotCount);
+
+	if ( recordSize != 0 && cntSlots > SIZE_MAX / recordSize ) return false;
+
+	queue->allocObj = false;
+	queue->slotMask = cntSlots - 1;
+	queue->recordSize = recordSize;
+
+	//slots use the allocator of the storage, free releases the object with it too
+	byte_buffer_init_new(&queue->storage, BYTE_BUFFER_TRUNCATE, cntSlots * recordSize);
+
+	queue->slots = mem_allocator_alloc(queue->storage.allocator, cntSlots * sizeof(ByteMpmcSlot));
+
+	if (!queue->slots || (!queue->storage.buffer && queue->storage.size > 0))
+	{
+		ByteBuffer* storage = &queue->storage;
+		byte_buffer_free(&storage);
+		mem_allocator_free(queue->storage.allocator, queue->slots);
+		queue->slots = NULL;
+		return false;
+	}
+
+	for (size_t curSlot = 0; curSlot < cntSlots; curSlot++)
+	{
+		atomic_init(&queue->slots[curSlot].sequence, curSlot);
+		queue->slots[curSlot].length = 0;
+	}
+
+	atomic_init(&queue->enqueuePos, 0);
+	atomic_init(&queue->dequeuePos, 0);
+
+	return true;
+}
+
+void byte_mpmc_queue_free(ByteMpmcQueue** _queue)
+{
+	ByteMpmcQueue** queue = _queue;
+	if (queue && *queue)
+	{
+		ByteMpmcQueue* toDelete = *queue;
+		ByteBuffer* storage = &toDelete->storage;
+
+		byte_buffer_free(&storage);
+
+		mem_allocator_free(toDelete->storage.allocator, toDelete->slots);
+		toDelete->slots = NULL;
+
+		if (toDelete->allocObj)
+		{
+			mem_allocator_free(toDelete->storage.allocator, toDelete);
+			*queue = NULL;
+		}
+	}
+}
+
+size_t byte_mpmc_queue_slot_count(ByteMpmcQueue* queue)
+{
+	return queue->slotMask + 1;
+}
+
+unsigned char* byte_mpmc_queue_reserve(ByteMpmcQueue* _queue, size_t cntBytes, ByteMpmcReservation* reservation)
+{
+	ByteMpmcQueue* queue = _queue;
+	if (!queue || cntBytes > queue->recordSize) return NULL;
+
+	size_t pos = atomic_load_explicit(&queue->enqueuePos, memory_order_relaxed);
+
+	for (;;)
+	{
+		ByteMpmcSlot* slot = &queue->slots[pos & queue->slotMask];
+		size_t sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+		intptr_t diff = (intptr_t)sequence - (intptr_t)pos;
+
+		if (diff == 0)
+		{
+			if (atomic_compare_exchange_weak_explicit(&queue->enqueuePos, &pos, pos + 1, 
+			                                          memory_order_relaxed, memory_order_relaxed))
+			{
+				slot->length = cntBytes;
+				reservation->pos = pos;
+				reservation->length = cntBytes;
+				reservation->data = queue->storage.buffer + (pos & queue->slotMask) * queue->recordSize;
+				return reservation->data;
+			}
+		}
+		else if (diff < 0)
+		{
+			//slot still holds a record of the previous round
+			return NULL;
+		}
+		else 
+		{
+			pos = atomic_load_explicit(&queue->enqueuePos, memory_order_relaxed);
+		}
+	}
+}
+
+void byte_mpmc_queue_commit(ByteMpmcQueue* _queue, ByteMpmcReservation* reservation)
+{
+	ByteMpmcQueue* queue = _queue;
+	ByteMpmcSlot* slot = &queue->slots[reservation->pos & queue->slotMask];
+
+	atomic_store_explicit(&slot->sequence, reservation->pos + 1, memory_order_release);
+}
+
+bool byte_mpmc_queue_push(ByteMpmcQueue* queue, const unsigned char* bytes, size_t cntBytes)
+{
+	ByteMpmcReservation reservation;
+	unsigned char* data = byte_mpmc_queue_reserve(queue, cntBytes, &reservation);
+
+	if (!data) return false;
+
+	memcpy(data, bytes, cntBytes);
+
+	byte_mpmc_queue_commit(queue, &reservation);
+
+	return true;
+}
+
+const unsigned char* byte_mpmc_queue_acquire(ByteMpmcQueue* _queue, ByteMpmcReservation* reservation)
+{
+	ByteMpmcQueue* queue = _queue;
+	if (!queue) return NULL;
+
+	size_t pos = atomic_load_explicit(&queue->dequeuePos, memory_order_relaxed);
+
+	for (;;)
+	{
+		ByteMpmcSlot* slot = &queue->slots[pos & queue->slotMask];
+		size_t sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+		intptr_t diff = (intptr_t)sequence - (intptr_t)(pos + 1);
+
+		if (diff == 0)
+		{
+			if (atomic_compare_exchange_weak_explicit(&queue->dequeuePos, &pos, pos + 1, 
+			                                          memory_order_relaxed, memory_order_relaxed))
+			{
+				reservation->pos = pos;
+				reservation->length = slot->length;
+				reservation->data = queue->storage.buffer + (pos & queue->slotMask) * queue->recordSize;
+				return reservation->data;
+			}
+		}
+		else if (diff < 0)
+		{
+			//slot not committed yet
+			return NULL;
+		}
+		else 
+		{
+			pos = atomic_load_explicit(&queue->dequeuePos, memory_order_relaxed);
+		}
+	}
+}
+
+void byte_mpmc_queue_release(ByteMpmcQueue* _queue, ByteMpmcReservation* reservation)
+{
+	ByteMpmcQueue* queue = _queue;
+	ByteMpmcSlot* slot = &queue->slots[reservation->pos & queue->slotMask];
+
+	atomic_store_explicit(&slot->sequence, reservation->pos + queue->slotMask + 1, memory_order_release);
+}
+
+bool byte_mpmc_queue_pop(ByteMpmcQueue* queue, ByteBuffer* dest)
+{
+	ByteMpmcReservation reservation;
+	const unsigned char* data = byte_mpmc_queue_acquire(queue, &reservation);
+
+	if (!data) return false;
+
+	byte_buffer_append_bytes(dest, (unsigned char*)data, reservation.length);
+
+	byte_mpmc_queue_release(queue, &reservation);
+
+	return true;
+}
\ No newline at end of file
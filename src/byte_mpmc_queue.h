@@ -0,0 +1,74 @@
+#ifndef BYTE_MPMC_QUEUE_H
+#define BYTE_MPMC_QUEUE_H
+
+#include <stdatomic.h>
+
+#include "byte_utils.h"
+
+typedef struct 
+{
+    atomic_size_t sequence;     //position the slot is ready for: pos for producers, pos + 1 for consumers
+    size_t length;              //byte count of the record
+    char _pad[BYTE_CACHE_LINE_SIZE - sizeof(atomic_size_t) - sizeof(size_t)];
+} ByteMpmcSlot;
+
+/* Bounded lock-free queue of byte records for any number of producers and consumers.
+   Every record lives in a fixed slot of recordSize bytes inside the storage buffer. Producers
+   and consumers only race for a position with one CAS and copy their record in parallel.
+   Slot count is rounded up to a power of two.
+*/
+typedef struct 
+{
+    ByteBuffer storage;         //slotCount * recordSize bytes of record data. Its allocator also serves slots and the object.
+    ByteMpmcSlot* slots;        //slot state, separated from record data
+    size_t slotMask;            //slotCount - 1
+    size_t recordSize;          //max bytes per record
+    bool allocObj;              //true, if byte_mpmc_queue_new was called
+    char _padConfig[BYTE_CACHE_LINE_SIZE];
+    atomic_size_t enqueuePos;
+    char _padEnqueue[BYTE_CACHE_LINE_SIZE];
+    atomic_size_t dequeuePos;
+    char _padDequeue[BYTE_CACHE_LINE_SIZE];
+} ByteMpmcQueue;
+
+//reserved position of a producer or consumer between reserve/commit and acquire/release
+typedef struct 
+{
+    size_t pos;
+    unsigned char* data;
+    size_t length;
+} ByteMpmcReservation;
+
+//Allocates a complete Queue Object
+ByteMpmcQueue* byte_mpmc_queue_new(size_t slotCount, size_t recordSize);
+
+//Handles internal memory allocation, returns false if allocation failed
+bool byte_mpmc_queue_init_new(ByteMpmcQueue* queue, size_t slotCount, size_t recordSize);
+
+void byte_mpmc_queue_free(ByteMpmcQueue** queue);
+
+size_t byte_mpmc_queue_slot_count(ByteMpmcQueue* queue);
+
+/* --- producer side --- */
+
+/* Reserves a slot for a record of cntBytes. Returns the memory to write the record into or
+   NULL if the queue is full or the record is larger than recordSize. Must be followed by commit.
+*/
+unsigned char* byte_mpmc_queue_reserve(ByteMpmcQueue* queue, size_t cntBytes, ByteMpmcReservation* reservation);
+void byte_mpmc_queue_commit(ByteMpmcQueue* queue, ByteMpmcReservation* reservation);
+
+//reserve, copy and commit in one call. Returns false if full or too large.
+bool byte_mpmc_queue_push(ByteMpmcQueue* queue, const unsigned char* bytes, size_t cntBytes);
+
+/* --- consumer side --- */
+
+/* Acquires the oldest record. Returns the record data with its length in reservation or
+   NULL if the queue is empty. The slot is given back to producers with release.
+*/
+const unsigned char* byte_mpmc_queue_acquire(ByteMpmcQueue* queue, ByteMpmcReservation* reservation);
+void byte_mpmc_queue_release(ByteMpmcQueue* queue, ByteMpmcReservation* reservation);
+
+//acquire, append the record to dest based on its mode and release. Returns false if empty.
+bool byte_mpmc_queue_pop(ByteMpmcQueue* queue, ByteBuffer* dest);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,247 @@
+#include "byte_reader.h"
+#include "byte_varint.h"
+
+//returns the next cntBytes and moves behind them, NULL if not enough bytes are left
+static inline const unsigned char* __byte_reader_take(ByteBufferReader* reader, size_t cntBytes)
+{
+	if (cntBytes > reader->size - reader->position) return NULL;
+
+	const unsigned char* taken = reader->data + reader->position;
+	reader->position += cntBytes;
+
+	return taken;
+}
+
+void byte_reader_init(ByteBufferReader* _reader, ByteBuffer* buffer)
+{
+	ByteBufferReader* reader = _reader;
+	if (reader)
+	{
+		if (buffer)
+		{
+			//a full ring or truncated buffer has an offset at the end
+			size_t written = ( buffer->offset < buffer->size ? buffer->offset : buffer->size );
+			byte_reader_init_bytes(reader, buffer->buffer, written);
+		}
+		else
+		{
+			byte_reader_init_bytes(reader, NULL, 0);
+		}
+	}
+}
+
+void byte_reader_init_bytes(ByteBufferReader* _reader, const unsigned char* bytes, size_t cntBytes)
+{
+	ByteBufferReader* reader = _reader;
+	if (reader)
+	{
+		reader->data = bytes;
+		reader->size = ( bytes ? cntBytes : 0 );
+		reader->position = 0;
+	}
+}
+
+size_t byte_reader_position(ByteBufferReader* reader)
+{
+	return reader->position;
+}
+
+size_t byte_reader_remaining(ByteBufferReader* reader)
+{
+	return reader->size - reader->position;
+}
+
+bool byte_reader_ensure(ByteBufferReader* reader, size_t cntBytes)
+{
+	return cntBytes <= reader->size - reader->position;
+}
+
+bool byte_reader_seek(ByteBufferReader* reader, size_t position)
+{
+	if (position > reader->size) return false;
+
+	reader->position = position;
+
+	return true;
+}
+
+bool byte_reader_skip(ByteBufferReader* reader, size_t cntBytes)
+{
+	return __byte_reader_take(reader, cntBytes) != NULL;
+}
+
+bool byte_reader_read_u8(ByteBufferReader* reader, uint8_t* value)
+{
+	const unsigned char* taken = __byte_reader_take(reader, sizeof(uint8_t));
+	if (!taken) return false;
+
+	*value = *taken;
+
+	return true;
+}
+
+bool byte_reader_read_u16_le(ByteBufferReader* reader, uint16_t* value)
+{
+	const unsigned char* taken = __byte_reader_take(reader, sizeof(uint16_t));
+	if (!taken) return false;
+
+	uint16_t ordered;
+	memcpy(&ordered, taken, sizeof(ordered));
+	*value = BYTE_BUFFER_TO_LE16(ordered);
+
+	return true;
+}
+
+bool byte_reader_read_u32_le(ByteBufferReader* reader, uint32_t* value)
+{
+	const unsigned char* taken = __byte_reader_take(reader, sizeof(uint32_t));
+	if (!taken) return false;
+
+	uint32_t ordered;
+	memcpy(&ordered, taken, sizeof(ordered));
+	*value = BYTE_BUFFER_TO_LE32(ordered);
+
+	return true;
+}
+
+bool byte_reader_read_u64_le(ByteBufferReader* reader, uint64_t* value)
+{
+	const unsigned char* taken = __byte_reader_take(reader, sizeof(uint64_t));
+	if (!taken) return false;
+
+	uint64_t ordered;
+	memcpy(&ordered, taken, sizeof(ordered));
+	*value = BYTE_BUFFER_TO_LE64(ordered);
+
+	return true;
+}
+
+bool byte_reader_read_f32_le(ByteBufferReader* reader, float* value)
+{
+	uint32_t bits;
+	if (!byte_reader_read_u32_le(reader, &bits)) return false;
+
+	memcpy(value, &bits, sizeof(bits));
+
+	return true;
+}
+
+bool byte_reader_read_f64_le(ByteBufferReader* reader, double* value)
+{
+	uint64_t bits;
+	if (!byte_reader_read_u64_le(reader, &bits)) return false;
+
+	memcpy(value, &bits, sizeof(bits));
+
+	return true;
+}
+
+bool byte_reader_read_u16_be(ByteBufferReader* reader, uint16_t* value)
+{
+	const unsigned char* taken = __byte_reader_take(reader, sizeof(uint16_t));
+	if (!taken) return false;
+
+	uint16_t ordered;
+	memcpy(&ordered, taken, sizeof(ordered));
+	*value = BYTE_BUFFER_TO_BE16(ordered);
+
+	return true;
+}
+
+bool byte_reader_read_u32_be(ByteBufferReader* reader, uint32_t* value)
+{
+	const unsigned char* taken = __byte_reader_take(reader, sizeof(uint32_t));
+	if (!taken) return false;
+
+	uint32_t ordered;
+	memcpy(&ordered, taken, sizeof(ordered));
+	*value = BYTE_BUFFER_TO_BE32(ordered);
+
+	return true;
+}
+
+bool byte_reader_read_u64_be(ByteBufferReader* reader, uint64_t* value)
+{
+	const unsigned char* taken = __byte_reader_take(reader, sizeof(uint64_t));
+	if (!taken) return false;
+
+	uint64_t ordered;
+	memcpy(&ordered, taken, sizeof(ordered));
+	*value = BYTE_BUFFER_TO_BE64(ordered);
+
+	return true;
+}
+
+bool byte_reader_read_f32_be(ByteBufferReader* reader, float* value)
+{
+	uint32_t bits;
+	if (!byte_reader_read_u32_be(reader, &bits)) return false;
+
+	memcpy(value, &bits, sizeof(bits));
+
+	return true;
+}
+
+bool byte_reader_read_f64_be(ByteBufferReader* reader, double* value)
+{
+	uint64_t bits;
+	if (!byte_reader_read_u64_be(reader, &bits)) return false;
+
+	memcpy(value, &bits, sizeof(bits));
+
+	return true;
+}
+
+bool byte_reader_read_uvarint(ByteBufferReader* reader, uint64_t* value)
+{
+	size_t cntBytes = byte_varint_decode(reader->data + reader->position, reader->size - reader->position, value);
+
+	reader->position += cntBytes;
+
+	return cntBytes > 0;
+}
+
+bool byte_reader_read_svarint(ByteBufferReader* reader, int64_t* value)
+{
+	uint64_t encoded;
+	if (!byte_reader_read_uvarint(reader, &encoded)) return false;
+
+	*value = byte_varint_zigzag_decode(encoded);
+
+	return true;
+}
+
+bool byte_reader_read_bytes(ByteBufferReader* reader, unsigned char* dest, size_t cntBytes)
+{
+	const unsigned char* taken = __byte_reader_take(reader, cntBytes);
+	if (!taken) return false;
+
+	memcpy(dest, taken, cntBytes);
+
+	return true;
+}
+
+bool byte_reader_read_slice(ByteBufferReader* reader, size_t cntBytes, const unsigned char** slice)
+{
+	const unsigned char* taken = __byte_reader_take(reader, cntBytes);
+	if (!taken) return false;
+
+	*slice = taken;
+
+	return true;
+}
+
+bool byte_reader_read_view(ByteBufferReader* reader, size_t cntBytes, ByteView* view)
+{
+	const unsigned char* taken = __byte_reader_take(reader, cntBytes);
+	if (!taken) return false;
+
+	*view = byte_view_of(taken, cntBytes);
+
+	return true;
+}
+
+ByteView byte_reader_rest(ByteBufferReader* reader)
+{
+	return byte_view_of(( reader->data ? reader->data + reader->position : NULL ), reader->size - reader->position);
+}
\ No newline at end of file
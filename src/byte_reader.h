@@ -0,0 +1,59 @@
+#ifndef BYTE_READER_H
+#define BYTE_READER_H
+
+#include "byte_utils.h"
+
+/* Read cursor over the written bytes [0, offset) of a ByteBuffer or over raw bytes. The reader points
+   into the storage of the buffer, so the buffer must not grow or be freed while reading.
+   Every read checks the remaining bytes once and returns false without moving if they are not enough.
+   Parsers can check a complete record with byte_reader_ensure.
+*/
+typedef struct 
+{
+    const unsigned char* data;  //first byte of the content
+    size_t size;                //count of readable bytes
+    size_t position;            //next byte to read
+} ByteBufferReader;
+
+void byte_reader_init(ByteBufferReader* reader, ByteBuffer* buffer);
+void byte_reader_init_bytes(ByteBufferReader* reader, const unsigned char* bytes, size_t cntBytes);
+
+size_t byte_reader_position(ByteBufferReader* reader);
+size_t byte_reader_remaining(ByteBufferReader* reader);
+
+//true if at least cntBytes are left
+bool byte_reader_ensure(ByteBufferReader* reader, size_t cntBytes);
+
+//sets the absolute position, false if behind the end
+bool byte_reader_seek(ByteBufferReader* reader, size_t position);
+bool byte_reader_skip(ByteBufferReader* reader, size_t cntBytes);
+
+bool byte_reader_read_u8(ByteBufferReader* reader, uint8_t* value);
+
+//values in little (le) or big (be) endian byte order
+bool byte_reader_read_u16_le(ByteBufferReader* reader, uint16_t* value);
+bool byte_reader_read_u32_le(ByteBufferReader* reader, uint32_t* value);
+bool byte_reader_read_u64_le(ByteBufferReader* reader, uint64_t* value);
+bool byte_reader_read_f32_le(ByteBufferReader* reader, float* value);
+bool byte_reader_read_f64_le(ByteBufferReader* reader, double* value);
+bool byte_reader_read_u16_be(ByteBufferReader* reader, uint16_t* value);
+bool byte_reader_read_u32_be(ByteBufferReader* reader, uint32_t* value);
+bool byte_reader_read_u64_be(ByteBufferReader* reader, uint64_t* value);
+bool byte_reader_read_f32_be(ByteBufferReader* reader, float* value);
+bool byte_reader_read_f64_be(ByteBufferReader* reader, double* value);
+
+//LEB128 and zigzag varints, false if truncated or malformed
+bool byte_reader_read_uvarint(ByteBufferReader* reader, uint64_t* value);
+bool byte_reader_read_svarint(ByteBufferReader* reader, int64_t* value);
+
+//copies cntBytes into dest
+bool byte_reader_read_bytes(ByteBufferReader* reader, unsigned char* dest, size_t cntBytes);
+
+//returns the next cntBytes in place without copying
+bool byte_reader_read_slice(ByteBufferReader* reader, size_t cntBytes, const unsigned char** slice);
+bool byte_reader_read_view(ByteBufferReader* reader, size_t cntBytes, ByteView* view);
+
+//view of the bytes not read yet
+ByteView byte_reader_rest(ByteBufferReader* reader);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,622 @@
+#include "byte_search.h"
+#include "cpu_utils.h"
+
+#ifdef CPU_UTILS_X86
+	#include <immintrin.h>
+#endif
+
+#define BYTE_SEARCH_ONES 0x0101010101010101ULL
+#define BYTE_SEARCH_HIGHS 0x8080808080808080ULL
+
+//nonzero if one of the eight bytes of word equals the byte in pattern, false positives only above a true match
+static inline uint64_t __byte_search_word_has(uint64_t word, uint64_t pattern)
+{
+	uint64_t diff = word ^ pattern;
+	return (diff - BYTE_SEARCH_ONES) & ~diff & BYTE_SEARCH_HIGHS;
+}
+
+//eight bytes per step, the hit word is checked byte wise, so the byte order does not matter
+static size_t __byte_search_byte_scalar(const unsigned char* data, size_t size, unsigned char byte)
+{
+	uint64_t pattern = BYTE_SEARCH_ONES * byte;
+	size_t pos = 0;
+
+	for (; pos + 8 <= size; pos += 8)
+	{
+		uint64_t word;
+		memcpy(&word, data + pos, sizeof(word));
+		if (__byte_search_word_has(word, pattern)) break;
+	}
+
+	for (; pos < size; pos++)
+	{
+		if (data[pos] == byte) return pos;
+	}
+
+	return BYTE_SEARCH_NOT_FOUND;
+}
+
+static size_t __byte_search_rbyte_scalar(const unsigned char* data, size_t size, unsigned char byte)
+{
+	uint64_t pattern = BYTE_SEARCH_ONES * byte;
+	size_t pos = size;
+
+	while (pos >= 8)
+	{
+		uint64_t word;
+		memcpy(&word, data + pos - 8, sizeof(word));
+		if (__byte_search_word_has(word, pattern)) break;
+		pos -= 8;
+	}
+
+	while (pos > 0)
+	{
+		pos--;
+		if (data[pos] == byte) return pos;
+	}
+
+	return BYTE_SEARCH_NOT_FOUND;
+}
+
+//256 bit membership table of a byte set
+typedef struct
+{
+	unsigned char bits[32];
+} ByteSearchSet;
+
+static void __byte_search_set_init(ByteSearchSet* set, ByteView bytes)
+{
+	memset(set->bits, 0, sizeof(set->bits));
+
+	for (size_t curByte = 0; curByte < bytes.len; curByte++)
+	{
+		set->bits[bytes.ptr[curByte] >> 3] |= (unsigned char)(1 << (bytes.ptr[curByte] & 7));
+	}
+}
+
+static inline bool __byte_search_set_has(const ByteSearchSet* set, unsigned char byte)
+{
+	return (set->bits[byte >> 3] >> (byte & 7)) & 1;
+}
+
+static size_t __byte_search_any_scalar(const unsigned char* data, size_t size, const ByteSearchSet* set)
+{
+	for (size_t pos = 0; pos < size; pos++)
+	{
+		if (__byte_search_set_has(set, data[pos])) return pos;
+	}
+
+	return BYTE_SEARCH_NOT_FOUND;
+}
+
+static size_t __byte_search_rany_scalar(const unsigned char* data, size_t size, const ByteSearchSet* set)
+{
+	for (size_t pos = size; pos > 0; pos--)
+	{
+		if (__byte_search_set_has(set, data[pos - 1])) return pos - 1;
+	}
+
+	return BYTE_SEARCH_NOT_FOUND;
+}
+
+//candidate positions by the first byte, verified against the rest of the needle
+static size_t __byte_search_bytes_scalar(const unsigned char* data, size_t size, const unsigned char* needle, size_t cntNeedle)
+{
+	size_t cntStarts = size - cntNeedle + 1;
+	size_t pos = 0;
+
+	while (pos < cntStarts)
+	{
+		size_t found = __byte_search_byte_scalar(data + pos, cntStarts - pos, needle[0]);
+		if (found == BYTE_SEARCH_NOT_FOUND) break;
+
+		pos += found;
+		if (memcmp(data + pos + 1, needle + 1, cntNeedle - 1) == 0) return pos;
+		pos++;
+	}
+
+	return BYTE_SEARCH_NOT_FOUND;
+}
+
+static size_t __byte_search_rbytes_scalar(const unsigned char* data, size_t size, const unsigned char* needle, size_t cntNeedle)
+{
+	size_t cntStarts = size - cntNeedle + 1;
+
+	while (cntStarts > 0)
+	{
+		size_t found = __byte_search_rbyte_scalar(data, cntStarts, needle[0]);
+		if (found == BYTE_SEARCH_NOT_FOUND) break;
+
+		if (memcmp(data + found + 1, needle + 1, cntNeedle - 1) == 0) return found;
+		cntStarts = found;
+	}
+
+	return BYTE_SEARCH_NOT_FOUND;
+}
+
+#ifdef CPU_UTILS_X86
+
+/* Set lookup by nibbles: the table of the low nibble holds the high nibbles as bits, split into two tables
+   for the high nibbles 0-7 and 8-15. A byte matches if its high nibble bit is set in one of them.
+*/
+typedef struct
+{
+	unsigned char lowFirst[16];
+	unsigned char lowSecond[16];
+} ByteSearchNibbles;
+
+static const unsigned char __byte_search_high_first[16] = { 1, 2, 4, 8, 16, 32, 64, 128, 0, 0, 0, 0, 0, 0, 0, 0 };
+static const unsigned char __byte_search_high_second[16] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 4, 8, 16, 32, 64, 128 };
+
+static void __byte_search_nibbles_init(ByteSearchNibbles* nibbles, ByteView bytes)
+{
+	memset(nibbles, 0, sizeof(ByteSearchNibbles));
+
+	for (size_t curByte = 0; curByte < bytes.len; curByte++)
+	{
+		unsigned char low = bytes.ptr[curByte] & 0x0F;
+		unsigned char high = bytes.ptr[curByte] >> 4;
+
+		if (high < 8)
+		{
+			nibbles->lowFirst[low] |= (unsigned char)(1 << high);
+		}
+		else
+		{
+			nibbles->lowSecond[low] |= (unsigned char)(1 << (high - 8));
+		}
+	}
+}
+
+__attribute__((target("sse2")))
+static size_t __byte_search_byte_sse2(const unsigned char* data, size_t size, unsigned char byte)
+{
+	const __m128i pattern = _mm_set1_epi8((char)byte);
+	size_t pos = 0;
+
+	for (; pos + 16 <= size; pos += 16)
+	{
+		__m128i block = _mm_loadu_si128((const __m128i*)(data + pos));
+		unsigned mask = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(block, pattern));
+
+		if (mask) return pos + (size_t)__builtin_ctz(mask);
+	}
+
+	size_t found = __byte_search_byte_scalar(data + pos, size - pos, byte);
+	return ( found == BYTE_SEARCH_NOT_FOUND ? found : pos + found );
+}
+
+__attribute__((target("sse2")))
+static size_t __byte_search_rbyte_sse2(const unsigned char* data, size_t size, unsigned char byte)
+{
+	const __m128i pattern = _mm_set1_epi8((char)byte);
+	size_t pos = size;
+
+	while (pos >= 16)
+	{
+		pos -= 16;
+		__m128i block = _mm_loadu_si128((const __m128i*)(data + pos));
+		unsigned mask = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(block, pattern));
+
+		if (mask) return pos + 31 - (size_t)__builtin_clz(mask);
+	}
+
+	return __byte_search_rbyte_scalar(data, pos, byte);
+}
+
+//64 bytes per step, both compares are merged for a single branch
+__attribute__((target("avx2")))
+static size_t __byte_search_byte_avx2(const unsigned char* data, size_t size, unsigned char byte)
+{
+	const __m256i pattern = _mm256_set1_epi8((char)byte);
+	size_t pos = 0;
+
+	for (; pos + 64 <= size; pos += 64)
+	{
+		__m256i first = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(data + pos)), pattern);
+		__m256i second = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(data + pos + 32)), pattern);
+
+		if (_mm256_movemask_epi8(_mm256_or_si256(first, second)))
+		{
+			uint64_t mask = (uint32_t)_mm256_movemask_epi8(first) | ((uint64_t)(uint32_t)_mm256_movemask_epi8(second) << 32);
+			return pos + (size_t)__builtin_ctzll(mask);
+		}
+	}
+
+	for (; pos + 32 <= size; pos += 32)
+	{
+		unsigned mask = (unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(data + pos)), pattern));
+		if (mask) return pos + (size_t)__builtin_ctz(mask);
+	}
+
+	size_t found = __byte_search_byte_scalar(data + pos, size - pos, byte);
+	return ( found == BYTE_SEARCH_NOT_FOUND ? found : pos + found );
+}
+
+__attribute__((target("avx2")))
+static size_t __byte_search_rbyte_avx2(const unsigned char* data, size_t size, unsigned char byte)
+{
+	const __m256i pattern = _mm256_set1_epi8((char)byte);
+	size_t pos = size;
+
+	while (pos >= 64)
+	{
+		pos -= 64;
+		__m256i first = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(data + pos)), pattern);
+		__m256i second = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(data + pos + 32)), pattern);
+
+		if (_mm256_movemask_epi8(_mm256_or_si256(first, second)))
+		{
+			uint64_t mask = (uint32_t)_mm256_movemask_epi8(first) | ((uint64_t)(uint32_t)_mm256_movemask_epi8(second) << 32);
+			return pos + 63 - (size_t)__builtin_clzll(mask);
+		}
+	}
+
+	while (pos >= 32)
+	{
+		pos -= 32;
+		unsigned mask = (unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(data + pos)), pattern));
+		if (mask) return pos + 31 - (size_t)__builtin_clz(mask);
+	}
+
+	return __byte_search_rbyte_scalar(data, pos, byte);
+}
+
+__attribute__((target("ssse3")))
+static inline unsigned __byte_search_any_mask_ssse3(__m128i block, __m128i lowFirst, __m128i lowSecond, __m128i highFirst, __m128i highSecond)
+{
+	const __m128i nibble = _mm_set1_epi8(0x0F);
+	__m128i low = _mm_and_si128(block, nibble);
+	__m128i high = _mm_and_si128(_mm_srli_epi16(block, 4), nibble);
+
+	__m128i hits = _mm_or_si128(_mm_and_si128(_mm_shuffle_epi8(lowFirst, low), _mm_shuffle_epi8(highFirst, high)),
+	                            _mm_and_si128(_mm_shuffle_epi8(lowSecond, low), _mm_shuffle_epi8(highSecond, high)));
+
+	return ~(unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(hits, _mm_setzero_si128())) & 0xFFFFU;
+}
+
+__attribute__((target("ssse3")))
+static size_t __byte_search_any_ssse3(const unsigned char* data, size_t size, const ByteSearchNibbles* nibbles, const ByteSearchSet* set, bool reverse)
+{
+	const __m128i lowFirst = _mm_loadu_si128((const __m128i*)nibbles->lowFirst);
+	const __m128i lowSecond = _mm_loadu_si128((const __m128i*)nibbles->lowSecond);
+	const __m128i highFirst = _mm_loadu_si128((const __m128i*)__byte_search_high_first);
+	const __m128i highSecond = _mm_loadu_si128((const __m128i*)__byte_search_high_second);
+
+	if (reverse)
+	{
+		size_t pos = size;
+		while (pos >= 16)
+		{
+			pos -= 16;
+			unsigned mask = __byte_search_any_mask_ssse3(_mm_loadu_si128((const __m128i*)(data + pos)), lowFirst, lowSecond, highFirst, highSecond);
+			if (mask) return pos + 31 - (size_t)__builtin_clz(mask);
+		}
+
+		return __byte_search_rany_scalar(data, pos, set);
+	}
+
+	size_t pos = 0;
+	for (; pos + 16 <= size; pos += 16)
+	{
+		unsigned mask = __byte_search_any_mask_ssse3(_mm_loadu_si128((const __m128i*)(data + pos)), lowFirst, lowSecond, highFirst, highSecond);
+		if (mask) return pos + (size_t)__builtin_ctz(mask);
+	}
+
+	size_t found = __byte_search_any_scalar(data + pos, size - pos, set);
+	return ( found == BYTE_SEARCH_NOT_FOUND ? found : pos + found );
+}
+
+//vpshufb works per 128 bit lane, so the tables are broadcast into both lanes
+__attribute__((target("avx2")))
+static inline unsigned __byte_search_any_mask_avx2(__m256i block, __m256i lowFirst, __m256i lowSecond, __m256i highFirst, __m256i highSecond)
+{
+	const __m256i nibble = _mm256_set1_epi8(0x0F);
+	__m256i low = _mm256_and_si256(block, nibble);
+	__m256i high = _mm256_and_si256(_mm256_srli_epi16(block, 4), nibble);
+
+	__m256i hits = _mm256_or_si256(_mm256_and_si256(_mm256_shuffle_epi8(lowFirst, low), _mm256_shuffle_epi8(highFirst, high)),
+	                               _mm256_and_si256(_mm256_shuffle_epi8(lowSecond, low), _mm256_shuffle_epi8(highSecond, high)));
+
+	return ~(unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(hits, _mm256_setzero_si256()));
+}
+
+__attribute__((target("avx2")))
+static size_t __byte_search_any_avx2(const unsigned char* data, size_t size, const ByteSearchNibbles* nibbles, const ByteSearchSet* set, bool reverse)
+{
+	const __m256i lowFirst = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)nibbles->lowFirst));
+	const __m256i lowSecond = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)nibbles->lowSecond));
+	const __m256i highFirst = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)__byte_search_high_first));
+	const __m256i highSecond = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)__byte_search_high_second));
+
+	if (reverse)
+	{
+		size_t pos = size;
+		while (pos >= 32)
+		{
+			pos -= 32;
+			unsigned mask = __byte_search_any_mask_avx2(_mm256_loadu_si256((const __m256i*)(data + pos)), lowFirst, lowSecond, highFirst, highSecond);
+			if (mask) return pos + 31 - (size_t)__builtin_clz(mask);
+		}
+
+		return __byte_search_rany_scalar(data, pos, set);
+	}
+
+	size_t pos = 0;
+	for (; pos + 32 <= size; pos += 32)
+	{
+		unsigned mask = __byte_search_any_mask_avx2(_mm256_loadu_si256((const __m256i*)(data + pos)), lowFirst, lowSecond, highFirst, highSecond);
+		if (mask) return pos + (size_t)__builtin_ctz(mask);
+	}
+
+	size_t found = __byte_search_any_scalar(data + pos, size - pos, set);
+	return ( found == BYTE_SEARCH_NOT_FOUND ? found : pos + found );
+}
+
+/* Substring search by the first and the last byte of the needle: both are compared at once for a block of
+   start positions, only positions matching both are verified with memcmp.
+*/
+__attribute__((target("sse2")))
+static size_t __byte_search_bytes_sse2(const unsigned char* data, size_t size, const unsigned char* needle, size_t cntNeedle)
+{
+	const __m128i first = _mm_set1_epi8((char)needle[0]);
+	const __m128i last = _mm_set1_epi8((char)needle[cntNeedle - 1]);
+	size_t cntStarts = size - cntNeedle + 1;
+	size_t pos = 0;
+
+	for (; pos + 16 <= cntStarts; pos += 16)
+	{
+		__m128i blockFirst = _mm_loadu_si128((const __m128i*)(data + pos));
+		__m128i blockLast = _mm_loadu_si128((const __m128i*)(data + pos + cntNeedle - 1));
+		unsigned mask = (unsigned)_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(blockFirst, first), _mm_cmpeq_epi8(blockLast, last)));
+
+		while (mask)
+		{
+			size_t candidate = pos + (size_t)__builtin_ctz(mask);
+			if (memcmp(data + candidate + 1, needle + 1, cntNeedle - 2) == 0) return candidate;
+			mask &= mask - 1;
+		}
+	}
+
+	size_t found = __byte_search_bytes_scalar(data + pos, size - pos, needle, cntNeedle);
+	return ( found == BYTE_SEARCH_NOT_FOUND ? found : pos + found );
+}
+
+__attribute__((target("sse2")))
+static size_t __byte_search_rbytes_sse2(const unsigned char* data, size_t size, const unsigned char* needle, size_t cntNeedle)
+{
+	const __m128i first = _mm_set1_epi8((char)needle[0]);
+	const __m128i last = _mm_set1_epi8((char)needle[cntNeedle - 1]);
+	size_t pos = size - cntNeedle + 1;
+
+	while (pos >= 16)
+	{
+		pos -= 16;
+		__m128i blockFirst = _mm_loadu_si128((const __m128i*)(data + pos));
+		__m128i blockLast = _mm_loadu_si128((const __m128i*)(data + pos + cntNeedle - 1));
+		unsigned mask = (unsigned)_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(blockFirst, first), _mm_cmpeq_epi8(blockLast, last)));
+
+		while (mask)
+		{
+			unsigned bit = 31 - (unsigned)__builtin_clz(mask);
+			if (memcmp(data + pos + bit + 1, needle + 1, cntNeedle - 2) == 0) return pos + bit;
+			mask &= ~(1U << bit);
+		}
+	}
+
+	//starts below pos, the needle may reach into the already searched blocks
+	return __byte_search_rbytes_scalar(data, pos + cntNeedle - 1, needle, cntNeedle);
+}
+
+__attribute__((target("avx2")))
+static size_t __byte_search_bytes_avx2(const unsigned char* data, size_t size, const unsigned char* needle, size_t cntNeedle)
+{
+	const __m256i first = _mm256_set1_epi8((char)needle[0]);
+	const __m256i last = _mm256_set1_epi8((char)needle[cntNeedle - 1]);
+	size_t cntStarts = size - cntNeedle + 1;
+	size_t pos = 0;
+
+	for (; pos + 32 <= cntStarts; pos += 32)
+	{
+		__m256i blockFirst = _mm256_loadu_si256((const __m256i*)(data + pos));
+		__m256i blockLast = _mm256_loadu_si256((const __m256i*)(data + pos + cntNeedle - 1));
+		unsigned mask = (unsigned)_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(blockFirst, first), _mm256_cmpeq_epi8(blockLast, last)));
+
+		while (mask)
+		{
+			size_t candidate = pos + (size_t)__builtin_ctz(mask);
+			if (memcmp(data + candidate + 1, needle + 1, cntNeedle - 2) == 0) return candidate;
+			mask &= mask - 1;
+		}
+	}
+
+	size_t found = __byte_search_bytes_scalar(data + pos, size - pos, needle, cntNeedle);
+	return ( found == BYTE_SEARCH_NOT_FOUND ? found : pos + found );
+}
+
+__attribute__((target("avx2")))
+static size_t __byte_search_rbytes_avx2(const unsigned char* data, size_t size, const unsigned char* needle, size_t cntNeedle)
+{
+	const __m256i first = _mm256_set1_epi8((char)needle[0]);
+	const __m256i last = _mm256_set1_epi8((char)needle[cntNeedle - 1]);
+	size_t pos = size - cntNeedle + 1;
+
+	while (pos >= 32)
+	{
+		pos -= 32;
+		__m256i blockFirst = _mm256_loadu_si256((const __m256i*)(data + pos));
+		__m256i blockLast = _mm256_loadu_si256((const __m256i*)(data + pos + cntNeedle - 1));
+		unsigned mask = (unsigned)_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(blockFirst, first), _mm256_cmpeq_epi8(blockLast, last)));
+
+		while (mask)
+		{
+			unsigned bit = 31 - (unsigned)__builtin_clz(mask);
+			if (memcmp(data + pos + bit + 1, needle + 1, cntNeedle - 2) == 0) return pos + bit;
+			mask &= ~(1U << bit);
+		}
+	}
+
+	return __byte_search_rbytes_scalar(data, pos + cntNeedle - 1, needle, cntNeedle);
+}
+
+#endif
+
+size_t byte_view_find_byte(ByteView view, unsigned char byte)
+{
+#ifdef CPU_UTILS_X86
+	if (cpu_has_feature(CPU_FEATURE_AVX2))
+	{
+		return __byte_search_byte_avx2(view.ptr, view.len, byte);
+	}
+	else if (cpu_has_feature(CPU_FEATURE_SSE2))
+	{
+		return __byte_search_byte_sse2(view.ptr, view.len, byte);
+	}
+#endif
+
+	return __byte_search_byte_scalar(view.ptr, view.len, byte);
+}
+
+size_t byte_view_rfind_byte(ByteView view, unsigned char byte)
+{
+#ifdef CPU_UTILS_X86
+	if (cpu_has_feature(CPU_FEATURE_AVX2))
+	{
+		return __byte_search_rbyte_avx2(view.ptr, view.len, byte);
+	}
+	else if (cpu_has_feature(CPU_FEATURE_SSE2))
+	{
+		return __byte_search_rbyte_sse2(view.ptr, view.len, byte);
+	}
+#endif
+
+	return __byte_search_rbyte_scalar(view.ptr, view.len, byte);
+}
+
+static size_t __byte_search_any(ByteView view, ByteView set, bool reverse)
+{
+	if (set.len == 0) return BYTE_SEARCH_NOT_FOUND;
+
+	if (set.len == 1)
+	{
+		return ( reverse ? byte_view_rfind_byte(view, set.ptr[0]) : byte_view_find_byte(view, set.ptr[0]) );
+	}
+
+	ByteSearchSet table;
+	__byte_search_set_init(&table, set);
+
+#ifdef CPU_UTILS_X86
+	bool useAvx2 = cpu_has_feature(CPU_FEATURE_AVX2);
+	if (useAvx2 || cpu_has_feature(CPU_FEATURE_SSSE3))
+	{
+		ByteSearchNibbles nibbles;
+		__byte_search_nibbles_init(&nibbles, set);
+
+		return ( useAvx2 ? __byte_search_any_avx2(view.ptr, view.len, &nibbles, &table, reverse)
+		                 : __byte_search_any_ssse3(view.ptr, view.len, &nibbles, &table, reverse) );
+	}
+#endif
+
+	return ( reverse ? __byte_search_rany_scalar(view.ptr, view.len, &table) : __byte_search_any_scalar(view.ptr, view.len, &table) );
+}
+
+size_t byte_view_find_any_of(ByteView view, ByteView set)
+{
+	return __byte_search_any(view, set, false);
+}
+
+size_t byte_view_rfind_any_of(ByteView view, ByteView set)
+{
+	return __byte_search_any(view, set, true);
+}
+
+size_t byte_view_find_bytes(ByteView view, ByteView needle)
+{
+	if (needle.len == 0) return 0;
+	if (needle.len > view.len) return BYTE_SEARCH_NOT_FOUND;
+	if (needle.len == 1) return byte_view_find_byte(view, needle.ptr[0]);
+
+#ifdef CPU_UTILS_X86
+	if (cpu_has_feature(CPU_FEATURE_AVX2))
+	{
+		return __byte_search_bytes_avx2(view.ptr, view.len, needle.ptr, needle.len);
+	}
+	else if (cpu_has_feature(CPU_FEATURE_SSE2))
+	{
+		return __byte_search_bytes_sse2(view.ptr, view.len, needle.ptr, needle.len);
+	}
+#endif
+
+	return __byte_search_bytes_scalar(view.ptr, view.len, needle.ptr, needle.len);
+}
+
+size_t byte_view_rfind_bytes(ByteView view, ByteView needle)
+{
+	if (needle.len == 0) return view.len;
+	if (needle.len > view.len) return BYTE_SEARCH_NOT_FOUND;
+	if (needle.len == 1) return byte_view_rfind_byte(view, needle.ptr[0]);
+
+#ifdef CPU_UTILS_X86
+	if (cpu_has_feature(CPU_FEATURE_AVX2))
+	{
+		return __byte_search_rbytes_avx2(view.ptr, view.len, needle.ptr, needle.len);
+	}
+	else if (cpu_has_feature(CPU_FEATURE_SSE2))
+	{
+		return __byte_search_rbytes_sse2(view.ptr, view.len, needle.ptr, needle.len);
+	}
+#endif
+
+	return __byte_search_rbytes_scalar(view.ptr, view.len, needle.ptr, needle.len);
+}
+
+//search results inside the content behind from as buffer indices
+static size_t __byte_search_shift(size_t found, size_t from)
+{
+	return ( found == BYTE_SEARCH_NOT_FOUND ? found : from + found );
+}
+
+size_t byte_buffer_find_byte(ByteBuffer* buffer, size_t from, unsigned char byte)
+{
+	ByteView content = byte_view_from_content(buffer);
+	if (!buffer || from > content.len) return BYTE_SEARCH_NOT_FOUND;
+
+	return __byte_search_shift(byte_view_find_byte(byte_view_suffix(content, from), byte), from);
+}
+
+size_t byte_buffer_rfind_byte(ByteBuffer* buffer, size_t end, unsigned char byte)
+{
+	if (!buffer) return BYTE_SEARCH_NOT_FOUND;
+
+	return byte_view_rfind_byte(byte_view_prefix(byte_view_from_content(buffer), end), byte);
+}
+
+size_t byte_buffer_find_any_of(ByteBuffer* buffer, size_t from, unsigned char* set, size_t cntSet)
+{
+	ByteView content = byte_view_from_content(buffer);
+	if (!buffer || from > content.len) return BYTE_SEARCH_NOT_FOUND;
+
+	return __byte_search_shift(byte_view_find_any_of(byte_view_suffix(content, from), byte_view_of(set, cntSet)), from);
+}
+
+size_t byte_buffer_rfind_any_of(ByteBuffer* buffer, size_t end, unsigned char* set, size_t cntSet)
+{
+	if (!buffer) return BYTE_SEARCH_NOT_FOUND;
+
+	return byte_view_rfind_any_of(byte_view_prefix(byte_view_from_content(buffer), end), byte_view_of(set, cntSet));
+}
+
+size_t byte_buffer_find_bytes(ByteBuffer* buffer, size_t from, unsigned char* bytes, size_t cntBytes)
+{
+	ByteView content = byte_view_from_content(buffer);
+	if (!buffer || from > content.len) return BYTE_SEARCH_NOT_FOUND;
+
+	return __byte_search_shift(byte_view_find_bytes(byte_view_suffix(content, from), byte_view_of(bytes, cntBytes)), from);
+}
+
+size_t byte_buffer_rfind_bytes(ByteBuffer* buffer, size_t end, unsigned char* bytes, size_t cntBytes)
+{
+	if (!buffer) return BYTE_SEARCH_NOT_FOUND;
+
+	return byte_view_rfind_bytes(byte_view_prefix(byte_view_from_content(buffer), end), byte_view_of(bytes, cntBytes));
+}
\ No newline at end of file
@@ -0,0 +1,33 @@
+#ifndef BYTE_SEARCH_H
+#define BYTE_SEARCH_H
+
+#include "byte_utils.h"
+
+#define BYTE_SEARCH_NOT_FOUND SIZE_MAX
+
+/* Searches over views, results are indices into the view or BYTE_SEARCH_NOT_FOUND.
+   The r variants return the last occurrence. An empty needle is found at the start or the end.
+*/
+size_t byte_view_find_byte(ByteView view, unsigned char byte);
+size_t byte_view_rfind_byte(ByteView view, unsigned char byte);
+
+//any byte of set, an empty set is never found
+size_t byte_view_find_any_of(ByteView view, ByteView set);
+size_t byte_view_rfind_any_of(ByteView view, ByteView set);
+
+size_t byte_view_find_bytes(ByteView view, ByteView needle);
+size_t byte_view_rfind_bytes(ByteView view, ByteView needle);
+
+/* Searches over the written content of buffer, see byte_view_from_content. Forward searches start at from,
+   reverse searches return the last occurrence lying completely inside [0, end). Results are buffer indices.
+*/
+size_t byte_buffer_find_byte(ByteBuffer* buffer, size_t from, unsigned char byte);
+size_t byte_buffer_rfind_byte(ByteBuffer* buffer, size_t end, unsigned char byte);
+
+size_t byte_buffer_find_any_of(ByteBuffer* buffer, size_t from, unsigned char* set, size_t cntSet);
+size_t byte_buffer_rfind_any_of(ByteBuffer* buffer, size_t end, unsigned char* set, size_t cntSet);
+
+size_t byte_buffer_find_bytes(ByteBuffer* buffer, size_t from, unsigned char* bytes, size_t cntBytes);
+size_t byte_buffer_rfind_bytes(ByteBuffer* buffer, size_t end, unsigned char* bytes, size_t cntBytes);
+
+#endif
\ No newline at end of file
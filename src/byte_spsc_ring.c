@@ -0,0 +1,234 @@
+#include "byte_spsc_ring.h"
+
+static void __byte_spsc_ring_reset(ByteSpscRing* _ring)
+{
+	ByteSpscRing* ring = _ring;
+	ring->allocObj = false;
+
+	//positions count up to twice the capacity
+	if ( ring->storage.size > SIZE_MAX / 2 ) ring->storage.size = SIZE_MAX / 2;
+
+	ring->cachedTail = 0;
+	ring->cachedHead = 0;
+	atomic_init(&ring->head, 0);
+	atomic_init(&ring->tail, 0);
+}
+
+/* Positions run in [0, 2 * size), so full and empty differ and the distance stays exact for any size.
+   Free running positions would need a power of two size to keep their index when the counter wraps.
+*/
+static size_t __byte_spsc_ring_advance(size_t size, size_t position, size_t cntBytes)
+{
+	size_t next = position + cntBytes;
+	return ( next >= 2 * size ? next - 2 * size : next );
+}
+
+static size_t __byte_spsc_ring_distance(size_t size, size_t from, size_t to)
+{
+	return ( to >= from ? to - from : to + 2 * size - from );
+}
+
+static size_t __byte_spsc_ring_index(size_t size, size_t position)
+{
+	return ( position >= size ? position - size : position );
+}
+
+//free bytes seen by the producer, reloads head only if the ring looks full
+static size_t __byte_spsc_ring_producer_free(ByteSpscRing* _ring, size_t tail, size_t wanted)
+{
+	ByteSpscRing* ring = _ring;
+	size_t size = ring->storage.size;
+	size_t freeBytes = size - __byte_spsc_ring_distance(size, ring->cachedHead, tail);
+
+	if ( freeBytes < wanted )
+	{
+		ring->cachedHead = atomic_load_explicit(&ring->head, memory_order_acquire);
+		freeBytes = size - __byte_spsc_ring_distance(size, ring->cachedHead, tail);
+	}
+
+	return freeBytes;
+}
+
+//readable bytes seen by the consumer, reloads tail only if the ring looks empty
+static size_t __byte_spsc_ring_consumer_used(ByteSpscRing* _ring, size_t head, size_t wanted)
+{
+	ByteSpscRing* ring = _ring;
+	size_t size = ring->storage.size;
+	size_t usedBytes = __byte_spsc_ring_distance(size, head, ring->cachedTail);
+
+	if ( usedBytes < wanted )
+	{
+		ring->cachedTail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+		usedBytes = __byte_spsc_ring_distance(size, head, ring->cachedTail);
+	}
+
+	return usedBytes;
+}
+
+ByteSpscRing* byte_spsc_ring_new(size_t rawBuffSize)
+{
+	ByteSpscRing* new_ring = mem_allocator_alloc(mem_allocator_get(), sizeof(ByteSpscRing));
+
+	if (new_ring)
+	{
+		byte_spsc_ring_init_new(new_ring, rawBuffSize);
+		new_ring->allocObj = true;
+	}
+
+	return new_ring;
+}
+
+void byte_spsc_ring_init(ByteSpscRing* _ring, unsigned char* rawBuffer, size_t rawBuffSize)
+{
+	ByteSpscRing* ring = _ring;
+	if (ring)
+	{
+		byte_buffer_init(&ring->storage, BYTE_BUFFER_RING, rawBuffer, rawBuffSize);
+		__byte_spsc_ring_reset(ring);
+	}
+}
+
+void byte_spsc_ring_init_new(ByteSpscRing* _ring, size_t rawBuffSize)
+{
+	ByteSpscRing* ring = _ring;
+	if (ring)
+	{
+		byte_buffer_init_new(&ring->storage, BYTE_BUFFER_RING, rawBuffSize);
+		__byte_spsc_ring_reset(ring);
+	}
+}
+
+void byte_spsc_ring_free(ByteSpscRing** _ring)
+{
+	ByteSpscRing** ring = _ring;
+	if (ring && *ring)
+	{
+		ByteSpscRing* toDelete = *ring;
+		ByteBuffer* storage = &toDelete->storage;
+
+		byte_buffer_free(&storage);
+
+		if (toDelete->allocObj)
+		{
+			mem_allocator_free(toDelete->storage.allocator, toDelete);
+			*ring = NULL;
+		}
+	}
+}
+
+size_t byte_spsc_ring_capacity(ByteSpscRing* ring)
+{
+	return ring->storage.size;
+}
+
+size_t byte_spsc_ring_readable(ByteSpscRing* ring)
+{
+	size_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+	size_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+	return __byte_spsc_ring_distance(ring->storage.size, head, tail);
+}
+
+size_t byte_spsc_ring_writable(ByteSpscRing* ring)
+{
+	return ring->storage.size - byte_spsc_ring_readable(ring);
+}
+
+size_t byte_spsc_ring_write(ByteSpscRing* _ring, const unsigned char* bytes, size_t cntBytes)
+{
+	ByteSpscRing* ring = _ring;
+	if (!ring || ring->storage.size == 0) return 0;
+
+	size_t size = ring->storage.size;
+	size_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+	size_t freeBytes = __byte_spsc_ring_producer_free(ring, tail, cntBytes);
+	size_t cntWrite = ( freeBytes < cntBytes ? freeBytes : cntBytes );
+
+	if ( cntWrite == 0 ) return 0;
+
+	size_t index = __byte_spsc_ring_index(size, tail);
+	size_t untilEndBytes = size - index;
+	size_t tailBytes = ( untilEndBytes < cntWrite ? untilEndBytes : cntWrite );
+
+	memcpy(ring->storage.buffer + index, bytes, tailBytes);
+	memcpy(ring->storage.buffer, bytes + tailBytes, cntWrite - tailBytes);
+
+	atomic_store_explicit(&ring->tail, __byte_spsc_ring_advance(size, tail, cntWrite), memory_order_release);
+
+	return cntWrite;
+}
+
+size_t byte_spsc_ring_reserve(ByteSpscRing* _ring, unsigned char** space)
+{
+	ByteSpscRing* ring = _ring;
+	if (!ring || ring->storage.size == 0) return 0;
+
+	size_t size = ring->storage.size;
+	size_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+	size_t index = __byte_spsc_ring_index(size, tail);
+	size_t untilEndBytes = size - index;
+	size_t freeBytes = __byte_spsc_ring_producer_free(ring, tail, untilEndBytes);
+
+	*space = ring->storage.buffer + index;
+
+	return ( freeBytes < untilEndBytes ? freeBytes : untilEndBytes );
+}
+
+void byte_spsc_ring_publish(ByteSpscRing* _ring, size_t cntBytes)
+{
+	ByteSpscRing* ring = _ring;
+	if (ring)
+	{
+		size_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+		atomic_store_explicit(&ring->tail, __byte_spsc_ring_advance(ring->storage.size, tail, cntBytes), memory_order_release);
+	}
+}
+
+size_t byte_spsc_ring_read(ByteSpscRing* _ring, unsigned char* bytes, size_t cntBytes)
+{
+	ByteSpscRing* ring = _ring;
+	if (!ring || ring->storage.size == 0) return 0;
+
+	size_t size = ring->storage.size;
+	size_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+	size_t usedBytes = __byte_spsc_ring_consumer_used(ring, head, cntBytes);
+	size_t cntRead = ( usedBytes < cntBytes ? usedBytes : cntBytes );
+
+	if ( cntRead == 0 ) return 0;
+
+	size_t index = __byte_spsc_ring_index(size, head);
+	size_t untilEndBytes = size - index;
+	size_t tailBytes = ( untilEndBytes < cntRead ? untilEndBytes : cntRead );
+
+	memcpy(bytes, ring->storage.buffer + index, tailBytes);
+	memcpy(bytes + tailBytes, ring->storage.buffer, cntRead - tailBytes);
+
+	atomic_store_explicit(&ring->head, __byte_spsc_ring_advance(size, head, cntRead), memory_order_release);
+
+	return cntRead;
+}
+
+size_t byte_spsc_ring_peek(ByteSpscRing* _ring, const unsigned char** data)
+{
+	ByteSpscRing* ring = _ring;
+	if (!ring || ring->storage.size == 0) return 0;
+
+	size_t size = ring->storage.size;
+	size_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+	size_t index = __byte_spsc_ring_index(size, head);
+	size_t untilEndBytes = size - index;
+	size_t usedBytes = __byte_spsc_ring_consumer_used(ring, head, untilEndBytes);
+
+	*data = ring->storage.buffer + index;
+
+	return ( usedBytes < untilEndBytes ? usedBytes : untilEndBytes );
+}
+
+void byte_spsc_ring_commit(ByteSpscRing* _ring, size_t cntBytes)
+{
+	ByteSpscRing* ring = _ring;
+	if (ring)
+	{
+		size_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+		atomic_store_explicit(&ring->head, __byte_spsc_ring_advance(ring->storage.size, head, cntBytes), memory_order_release);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,67 @@
+#ifndef BYTE_SPSC_RING_H
+#define BYTE_SPSC_RING_H
+
+#include <stdatomic.h>
+
+#include "byte_utils.h"
+
+/* Lock-free ring for exactly one producer and one consumer thread.
+   Head and tail are positions in [0, 2 * capacity) with an explicit wrap, so any capacity keeps working
+   after gigabytes of throughput on 32 bit. Each side keeps a cached copy of the
+   other side's position and only reloads it if the cached value says full or empty.
+   The padding keeps producer and consumer fields on different cache lines.
+*/
+typedef struct 
+{
+    ByteBuffer storage;                                 //ring memory, mode and offset are not used. Its allocator also releases the object.
+    bool allocObj;                                      //true, if byte_spsc_ring_new was called
+    char _padStorage[BYTE_CACHE_LINE_SIZE];
+    atomic_size_t head;                                 //read position, written by consumer only
+    size_t cachedTail;                                  //consumer's last seen write position
+    char _padHead[BYTE_CACHE_LINE_SIZE];
+    atomic_size_t tail;                                 //write position, written by producer only
+    size_t cachedHead;                                  //producer's last seen read position
+    char _padTail[BYTE_CACHE_LINE_SIZE];
+} ByteSpscRing;
+
+//Allocates a complete Ring Object
+ByteSpscRing* byte_spsc_ring_new(size_t rawBuffSize);
+
+//Took outside buffer to work on it
+void byte_spsc_ring_init(ByteSpscRing* ring, unsigned char* rawBuffer, size_t rawBuffSize);
+
+//Handles internal memory allocation
+void byte_spsc_ring_init_new(ByteSpscRing* ring, size_t rawBuffSize);
+
+void byte_spsc_ring_free(ByteSpscRing** ring);
+
+size_t byte_spsc_ring_capacity(ByteSpscRing* ring);
+
+//bytes ready to read. Exact for the consumer, a lower bound for the producer.
+size_t byte_spsc_ring_readable(ByteSpscRing* ring);
+//free bytes. Exact for the producer, a lower bound for the consumer.
+size_t byte_spsc_ring_writable(ByteSpscRing* ring);
+
+/* --- producer side --- */
+
+//copies as many bytes as fit and returns the count of written bytes
+size_t byte_spsc_ring_write(ByteSpscRing* ring, const unsigned char* bytes, size_t cntBytes);
+
+/* Returns the contiguous free space at the write position for writing in place, e.g. with read(2).
+   The written bytes get visible for the consumer with byte_spsc_ring_publish.
+*/
+size_t byte_spsc_ring_reserve(ByteSpscRing* ring, unsigned char** space);
+void byte_spsc_ring_publish(ByteSpscRing* ring, size_t cntBytes);
+
+/* --- consumer side --- */
+
+//copies and consumes as many bytes as available and returns the count of read bytes
+size_t byte_spsc_ring_read(ByteSpscRing* ring, unsigned char* bytes, size_t cntBytes);
+
+/* Returns the contiguous readable bytes at the read position without consuming them.
+   The bytes are released for the producer with byte_spsc_ring_commit.
+*/
+size_t byte_spsc_ring_peek(ByteSpscRing* ring, const unsigned char** data);
+void byte_spsc_ring_commit(ByteSpscRing* ring, size_t cntBytes);
+
+#endif
\ No newline at end of file
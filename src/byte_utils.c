@@ -1,13 +1,33 @@
+#define _POSIX_C_SOURCE 200809L
+
 #include "byte_utils.h"
 
+#include <stdatomic.h>
+
+#ifndef _WIN32
+	#include <fcntl.h>
+	#include <unistd.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+#endif
+
+#define BYTE_BUFFER_GROW_MIN_SIZE 16
+#define BYTE_BUFFER_FMT_SCRATCH_SIZE 256
+
+struct ByteBufferShared
+{
+	atomic_size_t refs;
+};
+
 static void __byte_buffer_append_bytes_trunc(ByteBuffer* _buffer, unsigned char* bytes, size_t cntBytes)
 {
 	ByteBuffer* buffer = _buffer;
 	size_t curOffset = buffer->offset;
-	size_t untilEndBytes = buffer->size - curOffset;
 
 	//not space left and TRUNCMODE stopps here
-	if ( untilEndBytes == 0 ) return;
+	if ( curOffset >= buffer->size ) return;
+
+	size_t untilEndBytes = buffer->size - curOffset;
 
 	size_t cntCopyBytes = ( untilEndBytes < cntBytes ? untilEndBytes : cntBytes);
 
@@ -24,24 +44,239 @@ static void __byte_buffer_append_bytes_skip(ByteBuffer* _buffer, unsigned char*
 	__byte_buffer_append_bytes_trunc(buffer, bytes, cntBytes);
 }
 
+//copies with at most two memcpy's: tail segment from offset and the wrapped head segment from 0
 static void __byte_buffer_append_bytes_ring(ByteBuffer* _buffer, unsigned char* bytes, size_t cntBytes)
 {
 	ByteBuffer* buffer = _buffer;
+	size_t size = buffer->size;
+
+	//common case: fits without wrapping
+	if ( buffer->offset < size && cntBytes <= size - buffer->offset )
+	{
+		memcpy(buffer->buffer + buffer->offset, bytes, cntBytes);
+		buffer->offset += cntBytes;
+		return;
+	}
+
+	if ( size == 0 || cntBytes == 0 ) return;
+
+	size_t startIndex = ( buffer->offset >= size ? 0 : buffer->offset );
+
+	//only the last size bytes would survive, so we skip the bytes overwritten anyway
+	if ( cntBytes > size )
+	{
+		size_t skipBytes = cntBytes - size;
+		startIndex = (startIndex + (skipBytes % size)) % size;
+		bytes += skipBytes;
+		cntBytes = size;
+	}
+
+	size_t untilEndBytes = size - startIndex;
+	size_t tailBytes = ( untilEndBytes < cntBytes ? untilEndBytes : cntBytes );
+
+	memcpy(buffer->buffer + startIndex, bytes, tailBytes);
+	memcpy(buffer->buffer, bytes + tailBytes, cntBytes - tailBytes);
+
+	//same as appending byte by byte: the offset points behind the last written byte
+	buffer->offset = ( tailBytes == cntBytes ? startIndex + cntBytes : cntBytes - tailBytes );
+}
+
+//index of bytes inside the buffer memory or SIZE_MAX. Bytes of the buffer itself have to be found again after growing moved them.
+static size_t __byte_buffer_inner_index(ByteBuffer* _buffer, unsigned char* bytes)
+{
+	ByteBuffer* buffer = _buffer;
+	uintptr_t start = (uintptr_t)buffer->buffer;
+	uintptr_t pos = (uintptr_t)bytes;
+
+	return ( buffer->buffer && pos >= start && pos - start < buffer->size ? (size_t)(pos - start) : SIZE_MAX );
+}
+
+static void __byte_buffer_append_bytes_grow(ByteBuffer* _buffer, unsigned char* bytes, size_t cntBytes)
+{
+	ByteBuffer* buffer = _buffer;
+	size_t innerIndex = __byte_buffer_inner_index(buffer, bytes);
+
+	//on size overflow or failed allocation as much as possible will be written
+	if ( cntBytes <= SIZE_MAX - buffer->offset )
+	{
+		byte_buffer_reserve(buffer, buffer->offset + cntBytes);
+	}
+
+	if ( innerIndex != SIZE_MAX ) bytes = buffer->buffer + innerIndex;
+
+	__byte_buffer_append_bytes_trunc(buffer, bytes, cntBytes);
+}
+
+//moves the written bytes behind index by cntBytes and copies bytes into the gap. The offset grows by cntBytes.
+static void __byte_buffer_insert_bytes_grow(ByteBuffer* _buffer, size_t index, unsigned char* bytes, size_t cntBytes)
+{
+	ByteBuffer* buffer = _buffer;
+	size_t curOffset = buffer->offset;
+
+	if ( index > curOffset || cntBytes > SIZE_MAX - curOffset ) return;
+
+	//own bytes behind the written ones are moved too, so all own bytes can be found behind the gap
+	size_t innerIndex = __byte_buffer_inner_index(buffer, bytes);
+	size_t moveEnd = curOffset;
+	if ( innerIndex != SIZE_MAX )
+	{
+		if ( cntBytes > buffer->size - innerIndex ) return;
+		if ( innerIndex + cntBytes > moveEnd ) moveEnd = innerIndex + cntBytes;
+	}
+
+	if ( cntBytes > SIZE_MAX - moveEnd || !byte_buffer_reserve(buffer, moveEnd + cntBytes) ) return;
+
+	memmove(buffer->buffer + index + cntBytes, buffer->buffer + index, moveEnd - index);
+
+	if ( innerIndex == SIZE_MAX )
+	{
+		memcpy(buffer->buffer + index, bytes, cntBytes);
+	}
+	else
+	{
+		//own bytes in front of index stayed, the others moved behind the gap
+		size_t frontBytes = ( innerIndex < index ? index - innerIndex : 0 );
+		if ( frontBytes > cntBytes ) frontBytes = cntBytes;
+
+		memcpy(buffer->buffer + index, buffer->buffer + innerIndex, frontBytes);
+		memcpy(buffer->buffer + index + frontBytes, buffer->buffer + innerIndex + frontBytes + cntBytes, cntBytes - frontBytes);
+	}
+
+	buffer->offset += cntBytes;
+}
+
+static void __byte_buffer_reverse(unsigned char* bytes, size_t cntBytes)
+{
+	if ( cntBytes < 2 ) return;
+
+	for ( size_t left = 0, right = cntBytes - 1; left < right; left++, right-- )
+	{
+		unsigned char tmp = bytes[left];
+		bytes[left] = bytes[right];
+		bytes[right] = tmp;
+	}
+}
+
+//rotates the complete buffer right by cntBytes without extra memory
+static void __byte_buffer_rotate_right(ByteBuffer* _buffer, size_t cntBytes)
+{
+	ByteBuffer* buffer = _buffer;
+	size_t size = buffer->size;
+
+	if ( cntBytes == 0 || cntBytes >= size ) return;
+
+	__byte_buffer_reverse(buffer->buffer, size);
+	__byte_buffer_reverse(buffer->buffer, cntBytes);
+	__byte_buffer_reverse(buffer->buffer + cntBytes, size - cntBytes);
+}
+
+/* Inserts in place for fixed size modes, with the same result as appending the bytes 
+   and then the former rest [index, size) at index. Requires index < size.
+*/
+static void __byte_buffer_insert_bytes_inplace(ByteBuffer* _buffer, size_t index, unsigned char* bytes, size_t cntBytes)
+{
+	ByteBuffer* buffer = _buffer;
+	size_t size = buffer->size;
+	size_t restByteCnt = size - index;
 
-	for ( size_t curByte = 0; curByte < cntBytes; curByte++ )
+	switch(buffer->mode)
 	{
-		byte_buffer_append_byte(buffer, bytes[curByte]);
+		case BYTE_BUFFER_SKIP:
+			//the moved rest would never fit, so only fitting bytes are written without moving
+			if ( cntBytes < restByteCnt )
+			{
+				memcpy(buffer->buffer + index, bytes, cntBytes);
+			}
+			break;
+		case BYTE_BUFFER_RING:
+			/* bytes pushed out at the end come back at the beginning: the result are the last size bytes of
+			   [0, index) + bytes + [index, size) rotated right by cntBytes */
+			if ( cntBytes <= index )
+			{
+				memmove(buffer->buffer, buffer->buffer + cntBytes, index - cntBytes);
+				memcpy(buffer->buffer + index - cntBytes, bytes, cntBytes);
+			}
+			else 
+			{
+				memcpy(buffer->buffer, bytes + cntBytes - index, index);
+			}
+			__byte_buffer_rotate_right(buffer, cntBytes % size);
+			break;
+		case BYTE_BUFFER_TRUNCATE:
+		default:
+			if ( cntBytes >= restByteCnt )
+			{
+				memcpy(buffer->buffer + index, bytes, restByteCnt);
+			}
+			else 
+			{
+				memmove(buffer->buffer + index + cntBytes, buffer->buffer + index, restByteCnt - cntBytes);
+				memcpy(buffer->buffer + index, bytes, cntBytes);
+			}
+			break;
 	}
 }
 
+//allocator of own memory, buffers without one belong to the global allocator
+static const MemAllocator* __byte_buffer_allocator(ByteBuffer* buffer)
+{
+	return ( buffer->allocator ? buffer->allocator : mem_allocator_get() );
+}
+
+//releases own or mapped memory, outside memory is left untouched. Shared memory is released by the last reference.
+static void __byte_buffer_release_memory(ByteBuffer* _buffer)
+{
+	ByteBuffer* buffer = _buffer;
+	if (buffer->shared)
+	{
+		bool isLast = (atomic_fetch_sub_explicit(&buffer->shared->refs, 1, memory_order_acq_rel) == 1);
+
+		if (isLast)
+		{
+			mem_allocator_free(__byte_buffer_allocator(buffer), buffer->shared);
+		}
+
+		buffer->shared = NULL;
+
+		if (!isLast)
+		{
+			buffer->alloc = false;
+			buffer->mapped = false;
+			return;
+		}
+	}
+
+	if (buffer->alloc)
+	{
+		mem_allocator_free(__byte_buffer_allocator(buffer), buffer->buffer);
+	}
+#ifndef _WIN32
+	else if (buffer->mapped && buffer->buffer)
+	{
+		munmap(buffer->buffer, buffer->size);
+	}
+#endif
+
+	buffer->alloc = false;
+	buffer->mapped = false;
+}
 
 ByteBuffer* byte_buffer_new(ByteBufferMode mode, size_t rawBuffSize)
 {
-	ByteBuffer* new_buf = malloc(sizeof(ByteBuffer));
+	return byte_buffer_new_allocator(mode, rawBuffSize, NULL);
+}
+
+ByteBuffer* byte_buffer_new_allocator(ByteBufferMode mode, size_t rawBuffSize, const MemAllocator* _allocator)
+{
+	const MemAllocator* allocator = ( _allocator ? _allocator : mem_allocator_get() );
+	ByteBuffer* new_buf = mem_allocator_alloc(allocator, sizeof(ByteBuffer));
 
-	byte_buffer_init_new(new_buf, mode, rawBuffSize);
+	if (new_buf)
+	{
+		byte_buffer_init_new_allocator(new_buf, mode, rawBuffSize, allocator);
 
-	new_buf->allocObj = true;
+		new_buf->allocObj = true;
+	}
 
 	return new_buf;
 }
@@ -57,31 +292,260 @@ void byte_buffer_init(ByteBuffer* _buffer,
 	{
 		buffer->alloc = false;
 		buffer->allocObj = false;
+		buffer->mapped = false;
 		buffer->mode = mode;
 		buffer->offset = 0;
 		buffer->size = rawBuffSize;
 		buffer->buffer = rawBuffer;
+		buffer->shared = NULL;
+		buffer->allocator = mem_allocator_get();
 	}
 }
 
 
 //Handles internal memory allocation
-void byte_buffer_init_new(ByteBuffer* _buffer, 
+void byte_buffer_init_new(ByteBuffer* buffer, 
                           ByteBufferMode mode, 
                           size_t rawBuffSize)
+{
+	byte_buffer_init_new_allocator(buffer, mode, rawBuffSize, NULL);
+}
+
+void byte_buffer_init_new_allocator(ByteBuffer* _buffer, 
+                                    ByteBufferMode mode, 
+                                    size_t rawBuffSize, 
+                                    const MemAllocator* allocator)
 {
 	ByteBuffer* buffer = _buffer;
 	if (buffer)
 	{
 		buffer->alloc = true;
 		buffer->allocObj = false;
+		buffer->mapped = false;
 		buffer->mode = mode;
 		buffer->offset = 0;
 		buffer->size = rawBuffSize;
-		buffer->buffer = malloc(rawBuffSize * sizeof(unsigned char));
+		buffer->shared = NULL;
+		buffer->allocator = ( allocator ? allocator : mem_allocator_get() );
+		buffer->buffer = mem_allocator_alloc(buffer->allocator, rawBuffSize * sizeof(unsigned char));
 	}
 }
 
+void byte_buffer_init_new_arena(ByteBuffer* _buffer, 
+                                ByteBufferMode mode, 
+                                size_t rawBuffSize, 
+                                MemArena* arena)
+{
+	ByteBuffer* buffer = _buffer;
+	if (buffer)
+	{
+		unsigned char* rawBuffer = mem_arena_alloc(arena, rawBuffSize * sizeof(unsigned char));
+
+		byte_buffer_init(buffer, mode, rawBuffer, ( rawBuffer ? rawBuffSize : 0 ));
+	}
+}
+
+ByteBuffer* byte_buffer_new_arena(ByteBufferMode mode, size_t rawBuffSize, MemArena* arena)
+{
+	ByteBuffer* new_buf = mem_arena_alloc(arena, sizeof(ByteBuffer));
+
+	if (new_buf)
+	{
+		byte_buffer_init_new_arena(new_buf, mode, rawBuffSize, arena);
+
+		if (!new_buf->buffer) new_buf = NULL;
+	}
+
+	return new_buf;
+}
+
+
+bool byte_buffer_init_mapped(ByteBuffer* _buffer, 
+                             ByteBufferMode mode, 
+                             const char* fileName, 
+                             ByteBufferMapMode mapMode)
+{
+	ByteBuffer* buffer = _buffer;
+	if (!buffer || !fileName) return false;
+
+#ifdef _WIN32
+	(void)mode;
+	(void)mapMode;
+	return false;
+#else
+	bool shared = (mapMode == BYTE_BUFFER_MAP_SHARED);
+	int fd = open(fileName, shared ? O_RDWR : O_RDONLY);
+	if (fd < 0) return false;
+
+	struct stat fileStat;
+	if (fstat(fd, &fileStat) != 0 || fileStat.st_size < 0 || (uintmax_t)fileStat.st_size > SIZE_MAX)
+	{
+		close(fd);
+		return false;
+	}
+
+	size_t fileSize = (size_t)fileStat.st_size;
+	unsigned char* mapping = NULL;
+
+	if (fileSize > 0)
+	{
+		void* mapped = mmap(NULL, fileSize, PROT_READ | PROT_WRITE, shared ? MAP_SHARED : MAP_PRIVATE, fd, 0);
+		if (mapped == MAP_FAILED)
+		{
+			close(fd);
+			return false;
+		}
+		mapping = mapped;
+	}
+
+	//the mapping stays valid without the descriptor
+	close(fd);
+
+	byte_buffer_init(buffer, mode, mapping, fileSize);
+	buffer->mapped = (mapping != NULL);
+	buffer->offset = fileSize;
+
+	return true;
+#endif
+}
+
+ByteBuffer* byte_buffer_new_mapped(ByteBufferMode mode, const char* fileName, ByteBufferMapMode mapMode)
+{
+	const MemAllocator* allocator = mem_allocator_get();
+	ByteBuffer* new_buf = mem_allocator_alloc(allocator, sizeof(ByteBuffer));
+
+	if (new_buf && !byte_buffer_init_mapped(new_buf, mode, fileName, mapMode))
+	{
+		mem_allocator_free(allocator, new_buf);
+		return NULL;
+	}
+
+	if (new_buf)
+	{
+		new_buf->allocObj = true;
+	}
+
+	return new_buf;
+}
+
+bool byte_buffer_advise(ByteBuffer* _buffer, ByteBufferAdvice advice)
+{
+	ByteBuffer* buffer = _buffer;
+	if (!buffer || !buffer->mapped) return false;
+
+#ifdef _WIN32
+	(void)advice;
+	return false;
+#else
+	int posixAdvice;
+	switch(advice)
+	{
+		case BYTE_BUFFER_ADVICE_SEQUENTIAL: posixAdvice = POSIX_MADV_SEQUENTIAL; break;
+		case BYTE_BUFFER_ADVICE_RANDOM:     posixAdvice = POSIX_MADV_RANDOM; break;
+		case BYTE_BUFFER_ADVICE_WILLNEED:   posixAdvice = POSIX_MADV_WILLNEED; break;
+		case BYTE_BUFFER_ADVICE_NORMAL:
+		default:                            posixAdvice = POSIX_MADV_NORMAL; break;
+	}
+
+	return posix_madvise(buffer->buffer, buffer->size, posixAdvice) == 0;
+#endif
+}
+
+bool byte_buffer_sync(ByteBuffer* _buffer)
+{
+	ByteBuffer* buffer = _buffer;
+	if (!buffer || !buffer->mapped) return false;
+
+#ifdef _WIN32
+	return false;
+#else
+	return msync(buffer->buffer, buffer->size, MS_SYNC) == 0;
+#endif
+}
+
+ByteBuffer* byte_buffer_clone(ByteBuffer* _buffer)
+{
+	ByteBuffer* buffer = _buffer;
+	if (!buffer) return NULL;
+
+	const MemAllocator* allocator = __byte_buffer_allocator(buffer);
+	ByteBuffer* clone = mem_allocator_alloc(allocator, sizeof(ByteBuffer));
+	if (!clone) return NULL;
+
+	//storage of others, e.g. outside, arena or pool memory, can be released or reused while the clone lives
+	if (!buffer->alloc && !buffer->mapped)
+	{
+		unsigned char* copy = ( buffer->size > 0 ? mem_allocator_alloc(allocator, buffer->size) : NULL );
+		if (buffer->size > 0 && !copy)
+		{
+			mem_allocator_free(allocator, clone);
+			return NULL;
+		}
+
+		if (copy)
+		{
+			memcpy(copy, buffer->buffer, buffer->size);
+		}
+
+		*clone = *buffer;
+		clone->buffer = copy;
+		clone->alloc = true;
+		clone->allocObj = true;
+		clone->allocator = allocator;
+
+		return clone;
+	}
+
+	if (!buffer->shared)
+	{
+		buffer->shared = mem_allocator_alloc(allocator, sizeof(struct ByteBufferShared));
+		if (!buffer->shared)
+		{
+			mem_allocator_free(allocator, clone);
+			return NULL;
+		}
+		atomic_init(&buffer->shared->refs, 1);
+	}
+
+	atomic_fetch_add_explicit(&buffer->shared->refs, 1, memory_order_relaxed);
+
+	*clone = *buffer;
+	clone->allocObj = true;
+	clone->allocator = allocator;
+
+	return clone;
+}
+
+bool byte_buffer_unshare(ByteBuffer* _buffer)
+{
+	ByteBuffer* buffer = _buffer;
+	if (!buffer) return false;
+	if (!buffer->shared) return true;
+
+	//last reference, nobody else could clone it anymore
+	if (atomic_load_explicit(&buffer->shared->refs, memory_order_acquire) == 1)
+	{
+		mem_allocator_free(__byte_buffer_allocator(buffer), buffer->shared);
+		buffer->shared = NULL;
+		return true;
+	}
+
+	unsigned char* copy = NULL;
+	if (buffer->size > 0)
+	{
+		copy = mem_allocator_alloc(__byte_buffer_allocator(buffer), buffer->size * sizeof(unsigned char));
+		if (!copy) return false;
+
+		memcpy(copy, buffer->buffer, buffer->size);
+	}
+
+	__byte_buffer_release_memory(buffer);
+
+	buffer->alloc = true;
+	buffer->buffer = copy;
+
+	return true;
+}
 
 void byte_buffer_free(ByteBuffer** _buffer)
 {
@@ -89,10 +553,8 @@ void byte_buffer_free(ByteBuffer** _buffer)
 	if (buffer && *buffer)
 	{
 		ByteBuffer* toDelete = *buffer;
-		if (toDelete->alloc)
-		{
-			free(toDelete->buffer);
-		}
+
+		__byte_buffer_release_memory(toDelete);
 
 		toDelete->buffer = NULL;
 		toDelete->size = 0;
@@ -100,7 +562,7 @@ void byte_buffer_free(ByteBuffer** _buffer)
 
 		if (toDelete->allocObj)
 		{
-			free(toDelete);
+			mem_allocator_free(__byte_buffer_allocator(toDelete), toDelete);
 			*buffer = NULL;
 		}
 	}
@@ -110,7 +572,7 @@ void byte_buffer_free(ByteBuffer** _buffer)
 void byte_buffer_fill_complete(ByteBuffer* _buffer, unsigned char fillByte)
 {
 	ByteBuffer* buffer = _buffer;
-	if (buffer)
+	if (byte_buffer_unshare(buffer))
 	{
 		memset(buffer->buffer, fillByte, buffer->size);
 	}
@@ -120,7 +582,7 @@ void byte_buffer_fill_complete(ByteBuffer* _buffer, unsigned char fillByte)
 void byte_buffer_fill_to_end(ByteBuffer* _buffer, size_t index, unsigned char fillByte)
 {
 	ByteBuffer* buffer = _buffer;
-	if (buffer && index < buffer->size)
+	if (buffer && index < buffer->size && byte_buffer_unshare(buffer))
 	{
 		memset(buffer->buffer + index, fillByte, buffer->size - index);
 	}
@@ -130,7 +592,7 @@ void byte_buffer_fill_to_end(ByteBuffer* _buffer, size_t index, unsigned char fi
 void byte_buffer_fill_range(ByteBuffer* _buffer, size_t startIndex, size_t cnt, unsigned char fillByte)
 {
 	ByteBuffer* buffer = _buffer;
-	if (buffer && startIndex < buffer->size)
+	if (buffer && startIndex < buffer->size && byte_buffer_unshare(buffer))
 	{
 		size_t alignedCnt = cnt;
 		alignedCnt = ( alignedCnt + startIndex < buffer->size ? cnt : (buffer->size - startIndex));
@@ -167,12 +629,78 @@ bool byte_buffer_is_alloc(ByteBuffer* buffer)
 	return buffer->alloc;
 }
 
+bool byte_buffer_reserve(ByteBuffer* _buffer, size_t minSize)
+{
+	ByteBuffer* buffer = _buffer;
+	if (!buffer) return false;
+
+	if (minSize <= buffer->size) return true;
+
+	size_t newSize = (buffer->size < BYTE_BUFFER_GROW_MIN_SIZE ? BYTE_BUFFER_GROW_MIN_SIZE : buffer->size);
+	while (newSize < minSize)
+	{
+		newSize = ( newSize > SIZE_MAX / 2 ? minSize : newSize * 2 );
+	}
+
+	const MemAllocator* allocator = __byte_buffer_allocator(buffer);
+	unsigned char* newBuffer = NULL;
+	bool isOwn = (buffer->alloc && !buffer->shared);
+	if (isOwn)
+	{
+		newBuffer = mem_allocator_realloc(allocator, buffer->buffer, newSize * sizeof(unsigned char));
+	}
+	else 
+	{
+		//outside, mapped or shared memory could not be resized, so we switch to own memory
+		newBuffer = mem_allocator_alloc(allocator, newSize * sizeof(unsigned char));
+		if (newBuffer && buffer->buffer)
+		{
+			memcpy(newBuffer, buffer->buffer, buffer->size);
+		}
+	}
+
+	if (!newBuffer) return false;
+
+	if (!isOwn)
+	{
+		__byte_buffer_release_memory(buffer);
+	}
+
+	buffer->alloc = true;
+	buffer->buffer = newBuffer;
+	buffer->size = newSize;
+
+	return true;
+}
+
+void byte_buffer_shrink_to_fit(ByteBuffer* _buffer)
+{
+	ByteBuffer* buffer = _buffer;
+	if (buffer && buffer->alloc && buffer->offset < buffer->size && byte_buffer_unshare(buffer))
+	{
+		if (buffer->offset == 0)
+		{
+			mem_allocator_free(__byte_buffer_allocator(buffer), buffer->buffer);
+			buffer->buffer = NULL;
+			buffer->size = 0;
+			return;
+		}
+
+		unsigned char* newBuffer = mem_allocator_realloc(__byte_buffer_allocator(buffer), buffer->buffer, buffer->offset * sizeof(unsigned char));
+		if (newBuffer)
+		{
+			buffer->buffer = newBuffer;
+			buffer->size = buffer->offset;
+		}
+	}
+}
+
 
 //adding byte or bytes to the buffer
 void byte_buffer_append_byte(ByteBuffer* _buffer, unsigned char byte)
 {
 	ByteBuffer* buffer = _buffer;
-	if (buffer)
+	if (byte_buffer_unshare(buffer))
 	{
 		size_t usedOffset = buffer->offset;
 		bool isOverflow = (usedOffset >= buffer->size);
@@ -187,6 +715,9 @@ void byte_buffer_append_byte(ByteBuffer* _buffer, unsigned char byte)
 				case BYTE_BUFFER_RING:  usedOffset = 0;
 										buffer->offset = usedOffset + 1;
 										break;
+				case BYTE_BUFFER_GROW:  if ( !byte_buffer_reserve(buffer, usedOffset + 1) ) return;
+										buffer->offset++;
+										break;
 				default: return;
 			}
 		}
@@ -201,7 +732,7 @@ void byte_buffer_append_byte(ByteBuffer* _buffer, unsigned char byte)
 void byte_buffer_append_bytes(ByteBuffer* _buffer, unsigned char* bytes, size_t cntBytes)
 {
 	ByteBuffer* buffer = _buffer;
-	if (buffer)
+	if (byte_buffer_unshare(buffer))
 	{	
 		switch(buffer->mode)
 		{
@@ -214,6 +745,9 @@ void byte_buffer_append_bytes(ByteBuffer* _buffer, unsigned char* bytes, size_t
 			case BYTE_BUFFER_RING: 
 				__byte_buffer_append_bytes_ring(buffer, bytes, cntBytes);
 				break;
+			case BYTE_BUFFER_GROW: 
+				__byte_buffer_append_bytes_grow(buffer, bytes, cntBytes);
+				break;
 			default: 
 				__byte_buffer_append_bytes_trunc(buffer, bytes, cntBytes);
 				break;
@@ -222,23 +756,101 @@ void byte_buffer_append_bytes(ByteBuffer* _buffer, unsigned char* bytes, size_t
 	}
 }
 
+//formats into scratch if the result fits, otherwise into memory of allocator. If *formatted differs from scratch
+//it must be free'd by caller. Returns the length without terminating zero.
+static int __byte_buffer_format_va(const MemAllocator* allocator, char** formatted, char* scratch, size_t scratchSize, const char* fmt, va_list argptr)
+{
+	va_list args_copy;
+	va_copy(args_copy, argptr);
+
+	int formattedSize = vsnprintf(scratch, scratchSize, fmt, argptr);
+	char * bytebuffer = ( formattedSize >= 0 ? scratch : NULL );
+
+	//only results larger than scratch need a second pass
+	if (formattedSize >= 0 && (size_t)formattedSize >= scratchSize)
+	{
+		bytebuffer = mem_allocator_alloc(allocator, (size_t)formattedSize + 1);
+
+		if (bytebuffer)
+		{
+			vsnprintf(bytebuffer, (size_t)formattedSize + 1, fmt, args_copy);
+		}
+	}
+
+	va_end(args_copy);
+
+	*formatted = bytebuffer;
+
+	return formattedSize;
+}
+
+//formats direct into the free space. Only growing buffers have free space without content, so other modes
+//go over the stack and write only results into the buffer which would not fit into the scratch.
 static void byte_buffer_append_bytes_fmt_va(ByteBuffer* buffer, const char* fmt, va_list argptr)
 {
 	va_list args_copy;
 	va_copy(args_copy, argptr);
 
-	int buffsize = vsnprintf(NULL, 0, fmt, argptr) + 1;
-	char * bytebuffer = malloc(buffsize);
+	if (buffer->mode == BYTE_BUFFER_GROW)
+	{
+		size_t freeBytes = ( buffer->offset < buffer->size ? buffer->size - buffer->offset : 0 );
+		char* freeSpace = ( freeBytes > 0 ? (char*)&buffer->buffer[buffer->offset] : NULL );
 
-	vsnprintf(bytebuffer, buffsize, fmt, args_copy);
+		int formattedSize = vsnprintf(freeSpace, freeBytes, fmt, argptr);
 
-	byte_buffer_append_bytes(buffer, (unsigned char*)bytebuffer, buffsize-1);
+		if (formattedSize >= 0 && (size_t)formattedSize < freeBytes)
+		{
+			buffer->offset += (size_t)formattedSize;
+		}
+		//second pass only on overflow, with room for the terminating zero
+		else if (formattedSize >= 0 && byte_buffer_reserve(buffer, buffer->offset + (size_t)formattedSize + 1))
+		{
+			vsnprintf((char*)&buffer->buffer[buffer->offset], (size_t)formattedSize + 1, fmt, args_copy);
+			buffer->offset += (size_t)formattedSize;
+		}
+	}
+	else
+	{
+		char scratch[BYTE_BUFFER_FMT_SCRATCH_SIZE];
+		int formattedSize = vsnprintf(scratch, sizeof(scratch), fmt, argptr);
+		size_t freeBytes = ( buffer->offset < buffer->size ? buffer->size - buffer->offset : 0 );
 
-	free(bytebuffer);
+		if (formattedSize >= 0 && (size_t)formattedSize < sizeof(scratch))
+		{
+			byte_buffer_append_bytes(buffer, (unsigned char*)&scratch[0], (size_t)formattedSize);
+		}
+		else if (formattedSize >= 0 && (size_t)formattedSize < freeBytes)
+		{
+			//the byte behind the result is content and gets overwritten by the terminating zero
+			size_t zeroIdx = buffer->offset + (size_t)formattedSize;
+			unsigned char overwritten = buffer->buffer[zeroIdx];
+
+			vsnprintf((char*)&buffer->buffer[buffer->offset], (size_t)formattedSize + 1, fmt, args_copy);
+
+			buffer->buffer[zeroIdx] = overwritten;
+			buffer->offset = zeroIdx;
+		}
+		else if (formattedSize >= 0)
+		{
+			const MemAllocator* allocator = __byte_buffer_allocator(buffer);
+			char * bytebuffer = mem_allocator_alloc(allocator, (size_t)formattedSize + 1);
+
+			if (bytebuffer)
+			{
+				vsnprintf(bytebuffer, (size_t)formattedSize + 1, fmt, args_copy);
+				byte_buffer_append_bytes(buffer, (unsigned char*)bytebuffer, (size_t)formattedSize);
+				mem_allocator_free(allocator, bytebuffer);
+			}
+		}
+	}
+
+	va_end(args_copy);
 }
 
 void byte_buffer_append_bytes_fmt(ByteBuffer* buffer, const char* fmt, ...)
 {
+	if (!byte_buffer_unshare(buffer)) return;
+
 	va_list args;
 	va_start(args, fmt);
 
@@ -248,6 +860,176 @@ void byte_buffer_append_bytes_fmt(ByteBuffer* buffer, const char* fmt, ...)
 }
 
 
+//fixed size values: a single unaligned store if the value fits before the end, otherwise the mode decides
+static inline void __byte_buffer_put(ByteBuffer* buffer, const void* bytes, size_t cntBytes)
+{
+	if (buffer && !buffer->shared && buffer->offset < buffer->size && cntBytes < buffer->size - buffer->offset)
+	{
+		memcpy(buffer->buffer + buffer->offset, bytes, cntBytes);
+		buffer->offset += cntBytes;
+	}
+	else
+	{
+		byte_buffer_append_bytes(buffer, (unsigned char*)bytes, cntBytes);
+	}
+}
+
+static inline bool __byte_buffer_get(ByteBuffer* buffer, size_t index, void* bytes, size_t cntBytes)
+{
+	if (!buffer) return false;
+
+	size_t contentSize = ( buffer->mode == BYTE_BUFFER_GROW ? buffer->offset : buffer->size );
+	if (index > contentSize || cntBytes > contentSize - index) return false;
+
+	memcpy(bytes, buffer->buffer + index, cntBytes);
+
+	return true;
+}
+
+void byte_buffer_put_u16_le(ByteBuffer* buffer, uint16_t value)
+{
+	uint16_t ordered = BYTE_BUFFER_TO_LE16(value);
+	__byte_buffer_put(buffer, &ordered, sizeof(ordered));
+}
+
+void byte_buffer_put_u32_le(ByteBuffer* buffer, uint32_t value)
+{
+	uint32_t ordered = BYTE_BUFFER_TO_LE32(value);
+	__byte_buffer_put(buffer, &ordered, sizeof(ordered));
+}
+
+void byte_buffer_put_u64_le(ByteBuffer* buffer, uint64_t value)
+{
+	uint64_t ordered = BYTE_BUFFER_TO_LE64(value);
+	__byte_buffer_put(buffer, &ordered, sizeof(ordered));
+}
+
+void byte_buffer_put_f32_le(ByteBuffer* buffer, float value)
+{
+	uint32_t bits;
+	memcpy(&bits, &value, sizeof(bits));
+	byte_buffer_put_u32_le(buffer, bits);
+}
+
+void byte_buffer_put_f64_le(ByteBuffer* buffer, double value)
+{
+	uint64_t bits;
+	memcpy(&bits, &value, sizeof(bits));
+	byte_buffer_put_u64_le(buffer, bits);
+}
+
+void byte_buffer_put_u16_be(ByteBuffer* buffer, uint16_t value)
+{
+	uint16_t ordered = BYTE_BUFFER_TO_BE16(value);
+	__byte_buffer_put(buffer, &ordered, sizeof(ordered));
+}
+
+void byte_buffer_put_u32_be(ByteBuffer* buffer, uint32_t value)
+{
+	uint32_t ordered = BYTE_BUFFER_TO_BE32(value);
+	__byte_buffer_put(buffer, &ordered, sizeof(ordered));
+}
+
+void byte_buffer_put_u64_be(ByteBuffer* buffer, uint64_t value)
+{
+	uint64_t ordered = BYTE_BUFFER_TO_BE64(value);
+	__byte_buffer_put(buffer, &ordered, sizeof(ordered));
+}
+
+void byte_buffer_put_f32_be(ByteBuffer* buffer, float value)
+{
+	uint32_t bits;
+	memcpy(&bits, &value, sizeof(bits));
+	byte_buffer_put_u32_be(buffer, bits);
+}
+
+void byte_buffer_put_f64_be(ByteBuffer* buffer, double value)
+{
+	uint64_t bits;
+	memcpy(&bits, &value, sizeof(bits));
+	byte_buffer_put_u64_be(buffer, bits);
+}
+
+bool byte_buffer_get_u16_le(ByteBuffer* buffer, size_t index, uint16_t* value)
+{
+	uint16_t ordered;
+	if (!__byte_buffer_get(buffer, index, &ordered, sizeof(ordered))) return false;
+	*value = BYTE_BUFFER_TO_LE16(ordered);
+	return true;
+}
+
+bool byte_buffer_get_u32_le(ByteBuffer* buffer, size_t index, uint32_t* value)
+{
+	uint32_t ordered;
+	if (!__byte_buffer_get(buffer, index, &ordered, sizeof(ordered))) return false;
+	*value = BYTE_BUFFER_TO_LE32(ordered);
+	return true;
+}
+
+bool byte_buffer_get_u64_le(ByteBuffer* buffer, size_t index, uint64_t* value)
+{
+	uint64_t ordered;
+	if (!__byte_buffer_get(buffer, index, &ordered, sizeof(ordered))) return false;
+	*value = BYTE_BUFFER_TO_LE64(ordered);
+	return true;
+}
+
+bool byte_buffer_get_f32_le(ByteBuffer* buffer, size_t index, float* value)
+{
+	uint32_t bits;
+	if (!byte_buffer_get_u32_le(buffer, index, &bits)) return false;
+	memcpy(value, &bits, sizeof(bits));
+	return true;
+}
+
+bool byte_buffer_get_f64_le(ByteBuffer* buffer, size_t index, double* value)
+{
+	uint64_t bits;
+	if (!byte_buffer_get_u64_le(buffer, index, &bits)) return false;
+	memcpy(value, &bits, sizeof(bits));
+	return true;
+}
+
+bool byte_buffer_get_u16_be(ByteBuffer* buffer, size_t index, uint16_t* value)
+{
+	uint16_t ordered;
+	if (!__byte_buffer_get(buffer, index, &ordered, sizeof(ordered))) return false;
+	*value = BYTE_BUFFER_TO_BE16(ordered);
+	return true;
+}
+
+bool byte_buffer_get_u32_be(ByteBuffer* buffer, size_t index, uint32_t* value)
+{
+	uint32_t ordered;
+	if (!__byte_buffer_get(buffer, index, &ordered, sizeof(ordered))) return false;
+	*value = BYTE_BUFFER_TO_BE32(ordered);
+	return true;
+}
+
+bool byte_buffer_get_u64_be(ByteBuffer* buffer, size_t index, uint64_t* value)
+{
+	uint64_t ordered;
+	if (!__byte_buffer_get(buffer, index, &ordered, sizeof(ordered))) return false;
+	*value = BYTE_BUFFER_TO_BE64(ordered);
+	return true;
+}
+
+bool byte_buffer_get_f32_be(ByteBuffer* buffer, size_t index, float* value)
+{
+	uint32_t bits;
+	if (!byte_buffer_get_u32_be(buffer, index, &bits)) return false;
+	memcpy(value, &bits, sizeof(bits));
+	return true;
+}
+
+bool byte_buffer_get_f64_be(ByteBuffer* buffer, size_t index, double* value)
+{
+	uint64_t bits;
+	if (!byte_buffer_get_u64_be(buffer, index, &bits)) return false;
+	memcpy(value, &bits, sizeof(bits));
+	return true;
+}
+
 //replace set byte or bytes from given index
 void byte_buffer_replace_byte(ByteBuffer* _buffer, size_t index, unsigned char byte)
 {
@@ -285,12 +1067,20 @@ void byte_buffer_replace_bytes_fmt(ByteBuffer* _buffer, size_t index, unsigned c
 	ByteBuffer* buffer = _buffer;
 	if (buffer)
 	{	
-		size_t oldOffset = buffer->offset;
-		buffer->offset = index;
+		//the bytes behind index are content, so the result is not formatted in place
+		char scratch[BYTE_BUFFER_FMT_SCRATCH_SIZE];
+		char* formatted = NULL;
+		int formattedSize = __byte_buffer_format_va(__byte_buffer_allocator(buffer), &formatted, &scratch[0], sizeof(scratch), (const char*)fmt, args);
 
-		byte_buffer_append_bytes_fmt_va(buffer, fmt, args);
+		if (formatted)
+		{
+			byte_buffer_replace_bytes(buffer, index, (unsigned char*)formatted, formattedSize);
+		}
 
-		buffer->offset = oldOffset;
+		if (formatted != &scratch[0])
+		{
+			mem_allocator_free(__byte_buffer_allocator(buffer), formatted);
+		}
 	}
 
 	va_end(args);
@@ -300,45 +1090,35 @@ void byte_buffer_replace_bytes_fmt(ByteBuffer* _buffer, size_t index, unsigned c
 void byte_buffer_insert_byte(ByteBuffer* _buffer, size_t index, unsigned char byte)
 {
 	ByteBuffer* buffer = _buffer;
-	if (buffer && index < buffer->size)
-	{	
-		size_t oldOffset = buffer->offset;
-		buffer->offset = index;
+	if (!byte_buffer_unshare(buffer)) return;
 
-		size_t restByteCnt = buffer->size - buffer->offset;
-		unsigned char *restBytes = malloc(restByteCnt * sizeof(unsigned char));
-		
-		memcpy(restBytes, buffer->buffer + buffer->offset, restByteCnt);
-
-		byte_buffer_append_byte(buffer, byte);
-		
-		byte_buffer_append_bytes(buffer, restBytes, restByteCnt);
-
-		free(restBytes);
-
-		buffer->offset = oldOffset;
+	if (buffer && buffer->mode == BYTE_BUFFER_GROW)
+	{
+		__byte_buffer_insert_bytes_grow(buffer, index, &byte, 1);
+	}
+	else if (buffer && buffer->mode == BYTE_BUFFER_SKIP && index < buffer->size)
+	{
+		//a single byte always fits, the moved rest never
+		buffer->buffer[index] = byte;
+	}
+	else if (buffer && index < buffer->size)
+	{	
+		__byte_buffer_insert_bytes_inplace(buffer, index, &byte, 1);
 	}
 }
 
 void byte_buffer_insert_bytes(ByteBuffer* _buffer, size_t index, unsigned char* bytes, size_t cntBytes)
 {
 	ByteBuffer* buffer = _buffer;
-	if (buffer && index < buffer->size)
-	{	
-		size_t oldOffset = buffer->offset;
-		buffer->offset = index;
-
-		size_t restByteCnt = buffer->size - buffer->offset;
-		unsigned char *restBytes = malloc(restByteCnt * sizeof(unsigned char));
-		
-		memcpy(restBytes, buffer->buffer + buffer->offset, restByteCnt);
-
-		byte_buffer_append_bytes(buffer, bytes, cntBytes);
-		byte_buffer_append_bytes(buffer, restBytes, restByteCnt);
+	if (!byte_buffer_unshare(buffer)) return;
 
-		free(restBytes);
-
-		buffer->offset = oldOffset;
+	if (buffer && buffer->mode == BYTE_BUFFER_GROW)
+	{
+		__byte_buffer_insert_bytes_grow(buffer, index, bytes, cntBytes);
+	}
+	else if (buffer && index < buffer->size)
+	{	
+		__byte_buffer_insert_bytes_inplace(buffer, index, bytes, cntBytes);
 	}
 }
 
@@ -347,22 +1127,21 @@ static void byte_buffer_insert_bytes_fmt_va(ByteBuffer* _buffer, size_t index, u
 	
 	ByteBuffer* buffer = _buffer;
 	
-	if (buffer && index < buffer->size)
-	{	
-		size_t oldOffset = buffer->offset;
-		buffer->offset = index;
-
-		size_t restByteCnt = buffer->size - buffer->offset;
-		unsigned char *restBytes = malloc(restByteCnt * sizeof(unsigned char));
-		
-		memcpy(restBytes, buffer->buffer + buffer->offset, restByteCnt);
-
-		byte_buffer_append_bytes_fmt_va(buffer, fmt, argptr);
-		byte_buffer_append_bytes(buffer, restBytes, restByteCnt);
+	if (buffer && (buffer->mode == BYTE_BUFFER_GROW || index < buffer->size))
+	{
+		char scratch[BYTE_BUFFER_FMT_SCRATCH_SIZE];
+		char* formatted = NULL;
+		int formattedSize = __byte_buffer_format_va(__byte_buffer_allocator(buffer), &formatted, &scratch[0], sizeof(scratch), (const char*)fmt, argptr);
 
-		free(restBytes);
+		if (formatted)
+		{
+			byte_buffer_insert_bytes(buffer, index, (unsigned char*)formatted, formattedSize);
+		}
 
-		buffer->offset = oldOffset;
+		if (formatted != &scratch[0])
+		{
+			mem_allocator_free(__byte_buffer_allocator(buffer), formatted);
+		}
 	}
 }
 
@@ -411,13 +1190,108 @@ void byte_buffer_prepend_bytes_fmt(ByteBuffer* _buffer, unsigned char* fmt, ...)
 
 }
 
+ByteView byte_view_of(const unsigned char* bytes, size_t cntBytes)
+{
+	ByteView view = { bytes, ( bytes ? cntBytes : 0 ) };
+	return view;
+}
+
+ByteView byte_view_from_buffer(ByteBuffer* buffer)
+{
+	return ( buffer ? byte_view_of(buffer->buffer, buffer->size) : byte_view_of(NULL, 0) );
+}
+
+ByteView byte_view_from_content(ByteBuffer* buffer)
+{
+	if (!buffer) return byte_view_of(NULL, 0);
+
+	//a full ring or truncated buffer has an offset at the end
+	return byte_view_of(buffer->buffer, ( buffer->offset < buffer->size ? buffer->offset : buffer->size ));
+}
+
+ByteView byte_view_slice(ByteView view, size_t start, size_t cntBytes)
+{
+	if (start > view.len)
+	{
+		start = view.len;
+	}
+
+	size_t restBytes = view.len - start;
+
+	return byte_view_of(( view.ptr ? view.ptr + start : NULL ), ( cntBytes < restBytes ? cntBytes : restBytes ));
+}
+
+ByteView byte_view_prefix(ByteView view, size_t cntBytes)
+{
+	return byte_view_slice(view, 0, cntBytes);
+}
+
+ByteView byte_view_suffix(ByteView view, size_t start)
+{
+	return byte_view_slice(view, start, SIZE_MAX);
+}
+
+bool byte_view_equals(ByteView viewA, ByteView viewB)
+{
+	return viewA.len == viewB.len && (viewA.len == 0 || memcmp(viewA.ptr, viewB.ptr, viewA.len) == 0);
+}
+
+void byte_buffer_append_view(ByteBuffer* _dest, ByteView src)
+{
+	ByteBuffer* dest = _dest;
+	if (dest && src.len > 0)
+	{	
+		byte_buffer_append_bytes(dest, (unsigned char*)src.ptr, src.len);
+	}
+}
+
+void byte_buffer_prepend_view(ByteBuffer* _dest, ByteView src)
+{
+	ByteBuffer* dest = _dest;
+	if (dest && src.len > 0)
+	{	
+		byte_buffer_prepend_bytes(dest, (unsigned char*)src.ptr, src.len);
+	}
+}
+
+void byte_buffer_replace_view(ByteBuffer* _dest, ByteView src, size_t index)
+{
+	ByteBuffer* dest = _dest;
+	if (dest && src.len > 0)
+	{	
+		byte_buffer_replace_bytes(dest, index, (unsigned char*)src.ptr, src.len);
+	}
+}
+
+void byte_buffer_insert_view(ByteBuffer* _dest, ByteView src, size_t index)
+{
+	ByteBuffer* dest = _dest;
+	if (dest && src.len > 0)
+	{	
+		byte_buffer_insert_bytes(dest, index, (unsigned char*)src.ptr, src.len);
+	}
+}
+
+ByteBuffer* byte_buffer_join_view(ByteView viewA, ByteView viewB, ByteBufferMode resultMode)
+{
+	ByteBuffer* result = byte_buffer_new( resultMode, viewA.len + viewB.len );
+
+	if (result)
+	{
+		byte_buffer_append_view(result, viewA);
+		byte_buffer_append_view(result, viewB);
+	}
+
+	return result;
+}
+
 void byte_buffer_append_buffer(ByteBuffer* _dest, ByteBuffer* _src)
 {
 	ByteBuffer* dest = _dest;
 	ByteBuffer* src = _src;
-	if (dest && dest)
+	if (dest && src)
 	{	
-		byte_buffer_append_bytes(dest, src->buffer, src->size);
+		byte_buffer_append_view(dest, byte_view_from_buffer(src));
 	}
 }
 
@@ -425,9 +1299,9 @@ void byte_buffer_prepend_buffer(ByteBuffer* _dest, ByteBuffer* _src)
 {
 	ByteBuffer* dest = _dest;
 	ByteBuffer* src = _src;
-	if (dest && dest)
+	if (dest && src)
 	{	
-		byte_buffer_prepend_bytes(dest, src->buffer, src->size);
+		byte_buffer_prepend_view(dest, byte_view_from_buffer(src));
 	}
 }
 
@@ -435,9 +1309,9 @@ void byte_buffer_replace_buffer(ByteBuffer* _dest, ByteBuffer* _src, size_t inde
 {
 	ByteBuffer* dest = _dest;
 	ByteBuffer* src = _src;
-	if (dest && dest)
+	if (dest && src)
 	{	
-		byte_buffer_replace_bytes(dest, index, src->buffer, src->size);
+		byte_buffer_replace_view(dest, byte_view_from_buffer(src), index);
 	}
 }
 
@@ -445,9 +1319,9 @@ void byte_buffer_insert_buffer(ByteBuffer* _dest, ByteBuffer* _src, size_t index
 {
 	ByteBuffer* dest = _dest;
 	ByteBuffer* src = _src;
-	if (dest && dest)
+	if (dest && src)
 	{	
-		byte_buffer_insert_bytes(dest, index, src->buffer, src->size);
+		byte_buffer_insert_view(dest, byte_view_from_buffer(src), index);
 	}
 }
 
@@ -459,9 +1333,61 @@ ByteBuffer* byte_buffer_join_buffer(ByteBuffer* _bufferA, ByteBuffer* _bufferB,
 
 	if (bufferA && bufferB)
 	{	
-		result = byte_buffer_new( resultMode, bufferA->size + bufferB->size );
-		byte_buffer_append_buffer(result, bufferA);
-		byte_buffer_append_buffer(result, bufferB);
+		result = byte_buffer_join_view(byte_view_from_buffer(bufferA), byte_view_from_buffer(bufferB), resultMode);
+	}
+
+	return result;
+}
+
+void byte_buffer_append_content(ByteBuffer* _dest, ByteBuffer* _src)
+{
+	ByteBuffer* dest = _dest;
+	ByteBuffer* src = _src;
+	if (dest && src)
+	{	
+		byte_buffer_append_view(dest, byte_view_from_content(src));
+	}
+}
+
+void byte_buffer_prepend_content(ByteBuffer* _dest, ByteBuffer* _src)
+{
+	ByteBuffer* dest = _dest;
+	ByteBuffer* src = _src;
+	if (dest && src)
+	{	
+		byte_buffer_prepend_view(dest, byte_view_from_content(src));
+	}
+}
+
+void byte_buffer_replace_content(ByteBuffer* _dest, ByteBuffer* _src, size_t index)
+{
+	ByteBuffer* dest = _dest;
+	ByteBuffer* src = _src;
+	if (dest && src)
+	{	
+		byte_buffer_replace_view(dest, byte_view_from_content(src), index);
+	}
+}
+
+void byte_buffer_insert_content(ByteBuffer* _dest, ByteBuffer* _src, size_t index)
+{
+	ByteBuffer* dest = _dest;
+	ByteBuffer* src = _src;
+	if (dest && src)
+	{	
+		byte_buffer_insert_view(dest, byte_view_from_content(src), index);
+	}
+}
+
+ByteBuffer* byte_buffer_join_content(ByteBuffer* _bufferA, ByteBuffer* _bufferB, ByteBufferMode resultMode)
+{
+	ByteBuffer* bufferA = _bufferA;
+	ByteBuffer* bufferB = _bufferB;
+	ByteBuffer* result = NULL;
+
+	if (bufferA && bufferB)
+	{	
+		result = byte_buffer_join_view(byte_view_from_content(bufferA), byte_view_from_content(bufferB), resultMode);
 	}
 
 	return result;
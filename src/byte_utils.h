@@ -6,28 +6,94 @@
 #include <stdarg.h>
 #include <stdio.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <string.h>
+#include "arena_utils.h"
+#include "alloc_utils.h"
+
+#ifndef BYTE_CACHE_LINE_SIZE
+    #define BYTE_CACHE_LINE_SIZE 64     //used as padding between fields written by different threads
+#endif
+
+//converts between host and little (LE) or big (BE) endian byte order, works in both directions
+#if defined(__GNUC__) || defined(__clang__)
+    #define BYTE_BUFFER_BSWAP16(value) __builtin_bswap16(value)
+    #define BYTE_BUFFER_BSWAP32(value) __builtin_bswap32(value)
+    #define BYTE_BUFFER_BSWAP64(value) __builtin_bswap64(value)
+#else
+    #define BYTE_BUFFER_BSWAP16(value) ((uint16_t)(((value) >> 8) | ((value) << 8)))
+    #define BYTE_BUFFER_BSWAP32(value) ((((value) & 0xFF000000U) >> 24) | (((value) & 0x00FF0000U) >> 8) | \
+                                        (((value) & 0x0000FF00U) << 8) | (((value) & 0x000000FFU) << 24))
+    #define BYTE_BUFFER_BSWAP64(value) (((uint64_t)BYTE_BUFFER_BSWAP32((uint32_t)(value)) << 32) | \
+                                        (uint64_t)BYTE_BUFFER_BSWAP32((uint32_t)((value) >> 32)))
+#endif
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    #define BYTE_BUFFER_TO_LE16(value) BYTE_BUFFER_BSWAP16(value)
+    #define BYTE_BUFFER_TO_LE32(value) BYTE_BUFFER_BSWAP32(value)
+    #define BYTE_BUFFER_TO_LE64(value) BYTE_BUFFER_BSWAP64(value)
+    #define BYTE_BUFFER_TO_BE16(value) (value)
+    #define BYTE_BUFFER_TO_BE32(value) (value)
+    #define BYTE_BUFFER_TO_BE64(value) (value)
+#else
+    #define BYTE_BUFFER_TO_LE16(value) (value)
+    #define BYTE_BUFFER_TO_LE32(value) (value)
+    #define BYTE_BUFFER_TO_LE64(value) (value)
+    #define BYTE_BUFFER_TO_BE16(value) BYTE_BUFFER_BSWAP16(value)
+    #define BYTE_BUFFER_TO_BE32(value) BYTE_BUFFER_BSWAP32(value)
+    #define BYTE_BUFFER_TO_BE64(value) BYTE_BUFFER_BSWAP64(value)
+#endif
 
 typedef enum
 {
     BYTE_BUFFER_TRUNCATE,   //truncates buffer values to buffer size
     BYTE_BUFFER_SKIP,       //skip apppending or inserting if overflow would be happened
-    BYTE_BUFFER_RING        //starts at beginning if overflow would be happened
+    BYTE_BUFFER_RING,       //starts at beginning if overflow would be happened
+    BYTE_BUFFER_GROW        //expands the capacity if overflow would be happened. Insert moves only bytes until offset.
 } ByteBufferMode;
 
+typedef enum
+{
+    BYTE_BUFFER_MAP_READ,   //file is opened read only, changes stay private (copy on write)
+    BYTE_BUFFER_MAP_SHARED  //file is opened read write, changes are written back to the file
+} ByteBufferMapMode;
+
+typedef enum
+{
+    BYTE_BUFFER_ADVICE_NORMAL,
+    BYTE_BUFFER_ADVICE_SEQUENTIAL,  //aggressive read ahead, pages can be dropped after use
+    BYTE_BUFFER_ADVICE_RANDOM,      //no read ahead
+    BYTE_BUFFER_ADVICE_WILLNEED     //starts loading the pages now
+} ByteBufferAdvice;
+
+struct ByteBufferShared;
+
 typedef struct 
 {
     bool allocObj;              //true, if byte_buffer_new was called
     bool alloc;                 //true, if byte_buffer_new or byte_buffer_init_new were called
+    bool mapped;                //true, if buffer is a file mapping of byte_buffer_init_mapped
     ByteBufferMode mode;    //mode of buffer
     size_t offset;              //current intern offset
     size_t size;                //capacity of the buffer
     unsigned char* buffer;      //the rawBuffer Data
+    struct ByteBufferShared* shared;    //reference count of storage shared by byte_buffer_clone, NULL if not shared
+    const MemAllocator* allocator;      //routines for own memory and the object, global allocator at init if NULL
 } ByteBuffer;
 
+//non owning range of bytes, e.g. a part of a ByteBuffer. Stays valid as long as the viewed memory.
+typedef struct 
+{
+    const unsigned char* ptr;
+    size_t len;
+} ByteView;
+
 //Allocates a complete Buffer Object
 ByteBuffer* byte_buffer_new(ByteBufferMode mode, size_t rawBuffSize);
 
+//Allocates a complete Buffer Object, object and own memory are taken from allocator, NULL uses the global one
+ByteBuffer* byte_buffer_new_allocator(ByteBufferMode mode, size_t rawBuffSize, const MemAllocator* allocator);
+
 //Took outside buffer to work on it
 void byte_buffer_init(ByteBuffer* buffer, 
                       ByteBufferMode mode, 
@@ -39,6 +105,51 @@ void byte_buffer_init_new(ByteBuffer* buffer,
                           ByteBufferMode mode, 
                           size_t rawBuffSize);
 
+//Handles internal memory allocation with allocator, NULL uses the global one
+void byte_buffer_init_new_allocator(ByteBuffer* buffer, 
+                                    ByteBufferMode mode, 
+                                    size_t rawBuffSize, 
+                                    const MemAllocator* allocator);
+
+/* Takes the storage from arena. Free does not release it, mem_arena_reset does and invalidates the buffer.
+   Growing copies the content into own memory.
+*/
+void byte_buffer_init_new_arena(ByteBuffer* buffer, 
+                                ByteBufferMode mode, 
+                                size_t rawBuffSize, 
+                                MemArena* arena);
+
+//Buffer Object and storage taken from arena, NULL on error
+ByteBuffer* byte_buffer_new_arena(ByteBufferMode mode, size_t rawBuffSize, MemArena* arena);
+
+/* Maps the complete file into the buffer, pages are loaded on first access. Offset is set to the
+   file size. An empty file results in an empty buffer. Growing copies the mapping into own memory.
+   Returns false if the file could not be opened or mapped.
+*/
+bool byte_buffer_init_mapped(ByteBuffer* buffer, 
+                             ByteBufferMode mode, 
+                             const char* fileName, 
+                             ByteBufferMapMode mapMode);
+
+//Allocates a complete Buffer Object over a file mapping, NULL on error
+ByteBuffer* byte_buffer_new_mapped(ByteBufferMode mode, const char* fileName, ByteBufferMapMode mapMode);
+
+//access pattern hint for file mappings, returns false if not mapped or not supported
+bool byte_buffer_advise(ByteBuffer* buffer, ByteBufferAdvice advice);
+
+//writes changes of a shared file mapping back to the file and waits for completion
+bool byte_buffer_sync(ByteBuffer* buffer);
+
+/* New buffer object sharing the storage of buffer instead of copying it. The storage is reference counted
+   and the first change of one of the sharing buffers (append, put, replace, insert, prepend, fill, clear,
+   growth) copies it before. byte_buffer_free releases the reference. Storage the buffer does not own,
+   e.g. outside, arena or pool memory, is copied right away. Returns NULL on error.
+*/
+ByteBuffer* byte_buffer_clone(ByteBuffer* buffer);
+
+//copies shared storage, so the buffer can be changed directly. False if allocation failed.
+bool byte_buffer_unshare(ByteBuffer* buffer);
+
 void byte_buffer_free(ByteBuffer** buffer);
 
 void byte_buffer_clear(ByteBuffer* buffer);
@@ -56,11 +167,45 @@ ByteBufferMode byte_buffer_mode_get(ByteBuffer* buffer);
 
 bool byte_buffer_is_alloc(ByteBuffer* buffer);
 
+/* Ensures a capacity of at least minSize bytes. The capacity is doubled until it fits, so
+   repeated appends in BYTE_BUFFER_GROW mode are amortized O(1). Outside memory from
+   byte_buffer_init is copied into own memory on first growth. Returns false if allocation failed.
+*/
+bool byte_buffer_reserve(ByteBuffer* buffer, size_t minSize);
+//reduces the capacity of own memory to the current offset
+void byte_buffer_shrink_to_fit(ByteBuffer* buffer);
+
 //adding byte or bytes to the buffer
 void byte_buffer_append_byte(ByteBuffer* buffer, unsigned char byte);
 void byte_buffer_append_bytes(ByteBuffer* buffer, unsigned char* bytes, size_t cntBytes);
 void byte_buffer_append_bytes_fmt(ByteBuffer* buffer, const char* fmt, ...);
 
+//appends the value in little (le) or big (be) endian byte order, overflow is handled by mode
+void byte_buffer_put_u16_le(ByteBuffer* buffer, uint16_t value);
+void byte_buffer_put_u32_le(ByteBuffer* buffer, uint32_t value);
+void byte_buffer_put_u64_le(ByteBuffer* buffer, uint64_t value);
+void byte_buffer_put_f32_le(ByteBuffer* buffer, float value);
+void byte_buffer_put_f64_le(ByteBuffer* buffer, double value);
+void byte_buffer_put_u16_be(ByteBuffer* buffer, uint16_t value);
+void byte_buffer_put_u32_be(ByteBuffer* buffer, uint32_t value);
+void byte_buffer_put_u64_be(ByteBuffer* buffer, uint64_t value);
+void byte_buffer_put_f32_be(ByteBuffer* buffer, float value);
+void byte_buffer_put_f64_be(ByteBuffer* buffer, double value);
+
+/* reads the value at index in little (le) or big (be) endian byte order. Returns false if the value
+   does not lie completely inside the content (the capacity, in BYTE_BUFFER_GROW mode until offset).
+*/
+bool byte_buffer_get_u16_le(ByteBuffer* buffer, size_t index, uint16_t* value);
+bool byte_buffer_get_u32_le(ByteBuffer* buffer, size_t index, uint32_t* value);
+bool byte_buffer_get_u64_le(ByteBuffer* buffer, size_t index, uint64_t* value);
+bool byte_buffer_get_f32_le(ByteBuffer* buffer, size_t index, float* value);
+bool byte_buffer_get_f64_le(ByteBuffer* buffer, size_t index, double* value);
+bool byte_buffer_get_u16_be(ByteBuffer* buffer, size_t index, uint16_t* value);
+bool byte_buffer_get_u32_be(ByteBuffer* buffer, size_t index, uint32_t* value);
+bool byte_buffer_get_u64_be(ByteBuffer* buffer, size_t index, uint64_t* value);
+bool byte_buffer_get_f32_be(ByteBuffer* buffer, size_t index, float* value);
+bool byte_buffer_get_f64_be(ByteBuffer* buffer, size_t index, double* value);
+
 //replace set byte or bytes from given index
 void byte_buffer_replace_byte(ByteBuffer* buffer, size_t index, unsigned char byte);
 void byte_buffer_replace_bytes(ByteBuffer* buffer, size_t index, unsigned char* bytes, size_t cntBytes);
@@ -76,6 +221,28 @@ void byte_buffer_prepend_byte(ByteBuffer* buffer, unsigned char byte);
 void byte_buffer_prepend_bytes(ByteBuffer* buffer, unsigned char* bytes, size_t cntBytes);
 void byte_buffer_prepend_bytes_fmt(ByteBuffer* buffer, unsigned char* fmt, ...);
 
+//views over bytes or the complete buffer [0, size)
+ByteView byte_view_of(const unsigned char* bytes, size_t cntBytes);
+ByteView byte_view_from_buffer(ByteBuffer* buffer);
+//view over the written bytes [0, offset)
+ByteView byte_view_from_content(ByteBuffer* buffer);
+
+//parts of a view, start and length are clamped to the view
+ByteView byte_view_slice(ByteView view, size_t start, size_t cntBytes);
+ByteView byte_view_prefix(ByteView view, size_t cntBytes);
+ByteView byte_view_suffix(ByteView view, size_t start);
+
+bool byte_view_equals(ByteView viewA, ByteView viewB);
+
+//buffer operations with a view as source. The view must not point into dest.
+void byte_buffer_append_view(ByteBuffer* dest, ByteView src);
+void byte_buffer_prepend_view(ByteBuffer* dest, ByteView src);
+void byte_buffer_replace_view(ByteBuffer* dest, ByteView src, size_t index);
+void byte_buffer_insert_view(ByteBuffer* dest, ByteView src, size_t index);
+
+//Merges two views into a new buffer of their length, which must be free'd by caller.
+ByteBuffer* byte_buffer_join_view(ByteView viewA, ByteView viewB, ByteBufferMode resultMode);
+
 void byte_buffer_append_buffer(ByteBuffer* dest, ByteBuffer* src);
 void byte_buffer_prepend_buffer(ByteBuffer* dest, ByteBuffer* src);
 void byte_buffer_replace_buffer(ByteBuffer* dest, ByteBuffer* src, size_t index);
@@ -86,4 +253,13 @@ void byte_buffer_insert_buffer(ByteBuffer* dest, ByteBuffer* src, size_t index);
 */
 ByteBuffer* byte_buffer_join_buffer(ByteBuffer* bufferA, ByteBuffer* bufferB, ByteBufferMode resultMode);
 
+//like the _buffer functions, but only the written bytes [0, offset) of src are used
+void byte_buffer_append_content(ByteBuffer* dest, ByteBuffer* src);
+void byte_buffer_prepend_content(ByteBuffer* dest, ByteBuffer* src);
+void byte_buffer_replace_content(ByteBuffer* dest, ByteBuffer* src, size_t index);
+void byte_buffer_insert_content(ByteBuffer* dest, ByteBuffer* src, size_t index);
+
+//Merges the written bytes of two buffers into a new buffer of their summed offsets, which must be free'd by caller.
+ByteBuffer* byte_buffer_join_content(ByteBuffer* bufferA, ByteBuffer* bufferB, ByteBufferMode resultMode);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,254 @@
+#include "byte_varint.h"
+#include "cpu_utils.h"
+
+#ifdef CPU_UTILS_X86
+	#include <immintrin.h>
+#endif
+
+void byte_buffer_put_uvarint(ByteBuffer* buffer, uint64_t value)
+{
+	unsigned char encoded[BYTE_VARINT_MAX_SIZE];
+	size_t cntBytes = 0;
+
+	while (value >= 0x80)
+	{
+		encoded[cntBytes++] = (unsigned char)(value | 0x80);
+		value >>= 7;
+	}
+
+	encoded[cntBytes++] = (unsigned char)value;
+
+	byte_buffer_append_bytes(buffer, &encoded[0], cntBytes);
+}
+
+void byte_buffer_put_svarint(ByteBuffer* buffer, int64_t value)
+{
+	byte_buffer_put_uvarint(buffer, byte_varint_zigzag_encode(value));
+}
+
+size_t byte_varint_decode(const unsigned char* bytes, size_t cntBytes, uint64_t* value)
+{
+	uint64_t result = 0;
+	size_t maxBytes = ( cntBytes < BYTE_VARINT_MAX_SIZE ? cntBytes : BYTE_VARINT_MAX_SIZE );
+
+	for (size_t curByte = 0; curByte < maxBytes; curByte++)
+	{
+		unsigned char byte = bytes[curByte];
+
+		//the tenth byte holds only the highest bit
+		if (curByte == BYTE_VARINT_MAX_SIZE - 1 && byte > 1) return 0;
+
+		result |= (uint64_t)(byte & 0x7F) << (7 * curByte);
+
+		if ((byte & 0x80) == 0)
+		{
+			*value = result;
+			return curByte + 1;
+		}
+	}
+
+	return 0;
+}
+
+size_t byte_buffer_get_uvarint(ByteBuffer* buffer, size_t index, uint64_t* value)
+{
+	if (!buffer) return 0;
+
+	size_t contentSize = ( buffer->mode == BYTE_BUFFER_GROW ? buffer->offset : buffer->size );
+	if (index >= contentSize) return 0;
+
+	return byte_varint_decode(buffer->buffer + index, contentSize - index, value);
+}
+
+size_t byte_buffer_get_svarint(ByteBuffer* buffer, size_t index, int64_t* value)
+{
+	uint64_t encoded = 0;
+	size_t cntBytes = byte_buffer_get_uvarint(buffer, index, &encoded);
+
+	if (cntBytes > 0)
+	{
+		*value = byte_varint_zigzag_decode(encoded);
+	}
+
+	return cntBytes;
+}
+
+static size_t __byte_varint_decode_bulk_scalar(const unsigned char* bytes, size_t cntBytes, uint64_t* values, size_t maxValues, size_t* consumed)
+{
+	size_t cntValues = 0;
+	size_t curByte = 0;
+
+	while (cntValues < maxValues && curByte < cntBytes)
+	{
+		size_t varintSize = byte_varint_decode(bytes + curByte, cntBytes - curByte, &values[cntValues]);
+
+		if (varintSize == 0) break;
+
+		curByte += varintSize;
+		cntValues++;
+	}
+
+	*consumed = curByte;
+
+	return cntValues;
+}
+
+#ifdef CPU_UTILS_X86
+
+/* Blocks of 16 or 32 bytes: the movemask of the high bits marks all varint ends at once. A block without
+   continuation bits holds only single byte varints and is widened with vector instructions. Otherwise all
+   varints ending inside the block are decoded; up to 8 bytes by compacting the 7 bit groups of one
+   unaligned load, longer ones by the scalar decoder.
+*/
+
+//len <= 8 bytes from a little endian load
+static inline uint64_t __byte_varint_compact(const unsigned char* bytes, size_t len)
+{
+	uint64_t word;
+	memcpy(&word, bytes, sizeof(word));
+
+	word &= ( len == 8 ? ~0ULL : (1ULL << (8 * len)) - 1 ) & 0x7F7F7F7F7F7F7F7FULL;
+
+	word = (word & 0x007F007F007F007FULL) | ((word & 0x7F007F007F007F00ULL) >> 1);
+	word = (word & 0x00003FFF00003FFFULL) | ((word & 0x3FFF00003FFF0000ULL) >> 2);
+	word = (word & 0x000000000FFFFFFFULL) | ((word & 0x0FFFFFFF00000000ULL) >> 4);
+
+	return word;
+}
+
+//decodes all varints ending inside the block. Returns false if the block has a malformed varint.
+static inline bool __byte_varint_decode_block(const unsigned char* bytes, const unsigned char* end, uint64_t endMask, 
+                                              uint64_t* values, size_t* cntValues, size_t* curByte)
+{
+	size_t start = 0;
+
+	while (endMask)
+	{
+		size_t last = (size_t)__builtin_ctzll(endMask);
+		size_t len = last - start + 1;
+		const unsigned char* varint = bytes + start;
+
+		if (len <= 8 && varint + 8 <= end)
+		{
+			values[(*cntValues)++] = __byte_varint_compact(varint, len);
+		}
+		else if (byte_varint_decode(varint, len, &values[*cntValues]) == len)
+		{
+			(*cntValues)++;
+		}
+		else
+		{
+			return false;
+		}
+
+		*curByte += len;
+		start = last + 1;
+		endMask &= endMask - 1;
+	}
+
+	//a block without any end holds more than BYTE_VARINT_MAX_SIZE continuation bytes
+	return start > 0;
+}
+
+__attribute__((target("sse2")))
+static size_t __byte_varint_decode_bulk_sse2(const unsigned char* bytes, size_t cntBytes, uint64_t* values, size_t maxValues, size_t* consumed)
+{
+	size_t cntValues = 0;
+	size_t curByte = 0;
+	const unsigned char* end = bytes + cntBytes;
+	const __m128i zero = _mm_setzero_si128();
+
+	while (curByte + 16 <= cntBytes && cntValues + 16 <= maxValues)
+	{
+		const unsigned char* block = bytes + curByte;
+		__m128i chunk = _mm_loadu_si128((const __m128i*)block);
+		unsigned continuation = (unsigned)_mm_movemask_epi8(chunk);
+
+		if (continuation == 0)
+		{
+			__m128i lo16 = _mm_unpacklo_epi8(chunk, zero);
+			__m128i hi16 = _mm_unpackhi_epi8(chunk, zero);
+			__m128i parts32[4] = { _mm_unpacklo_epi16(lo16, zero), _mm_unpackhi_epi16(lo16, zero),
+			                       _mm_unpacklo_epi16(hi16, zero), _mm_unpackhi_epi16(hi16, zero) };
+
+			for (size_t curPart = 0; curPart < 4; curPart++)
+			{
+				_mm_storeu_si128((__m128i*)&values[cntValues], _mm_unpacklo_epi32(parts32[curPart], zero));
+				_mm_storeu_si128((__m128i*)&values[cntValues + 2], _mm_unpackhi_epi32(parts32[curPart], zero));
+				cntValues += 4;
+			}
+
+			curByte += 16;
+			continue;
+		}
+
+		if (!__byte_varint_decode_block(block, end, ~continuation & 0xFFFFU, values, &cntValues, &curByte)) break;
+	}
+
+	*consumed = curByte;
+
+	return cntValues;
+}
+
+__attribute__((target("avx2")))
+static size_t __byte_varint_decode_bulk_avx2(const unsigned char* bytes, size_t cntBytes, uint64_t* values, size_t maxValues, size_t* consumed)
+{
+	size_t cntValues = 0;
+	size_t curByte = 0;
+	const unsigned char* end = bytes + cntBytes;
+
+	while (curByte + 32 <= cntBytes && cntValues + 32 <= maxValues)
+	{
+		const unsigned char* block = bytes + curByte;
+		__m256i chunk = _mm256_loadu_si256((const __m256i*)block);
+		uint64_t continuation = (uint32_t)_mm256_movemask_epi8(chunk);
+
+		if (continuation == 0)
+		{
+			//four bytes widened to four 64 bit values per step
+			for (size_t curPart = 0; curPart < 32; curPart += 4)
+			{
+				uint32_t part;
+				memcpy(&part, block + curPart, sizeof(part));
+				_mm256_storeu_si256((__m256i*)&values[cntValues], _mm256_cvtepu8_epi64(_mm_cvtsi32_si128((int)part)));
+				cntValues += 4;
+			}
+
+			curByte += 32;
+			continue;
+		}
+
+		if (!__byte_varint_decode_block(block, end, ~continuation & 0xFFFFFFFFULL, values, &cntValues, &curByte)) break;
+	}
+
+	*consumed = curByte;
+
+	return cntValues;
+}
+
+#endif
+
+size_t byte_varint_decode_bulk(const unsigned char* bytes, size_t cntBytes, uint64_t* values, size_t maxValues, size_t* consumed)
+{
+	size_t cntValues = 0;
+	size_t curByte = 0;
+
+#ifdef CPU_UTILS_X86
+	if (cpu_has_feature(CPU_FEATURE_AVX2))
+	{
+		cntValues = __byte_varint_decode_bulk_avx2(bytes, cntBytes, values, maxValues, &curByte);
+	}
+	else if (cpu_has_feature(CPU_FEATURE_SSE2))
+	{
+		cntValues = __byte_varint_decode_bulk_sse2(bytes, cntBytes, values, maxValues, &curByte);
+	}
+#endif
+
+	//the tail and malformed varints
+	size_t tailBytes = 0;
+	cntValues += __byte_varint_decode_bulk_scalar(bytes + curByte, cntBytes - curByte, values + cntValues, maxValues - cntValues, &tailBytes);
+
+	*consumed = curByte + tailBytes;
+
+	return cntValues;
+}
\ No newline at end of file
@@ -0,0 +1,38 @@
+#ifndef BYTE_VARINT_H
+#define BYTE_VARINT_H
+
+#include "byte_utils.h"
+
+#define BYTE_VARINT_MAX_SIZE 10     //bytes of a 64 bit value in LEB128
+
+//maps signed to unsigned values with small magnitudes staying small: 0, -1, 1, -2 => 0, 1, 2, 3
+static inline uint64_t byte_varint_zigzag_encode(int64_t value)
+{
+    return ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+}
+
+static inline int64_t byte_varint_zigzag_decode(uint64_t value)
+{
+    return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+}
+
+//appends the value as unsigned LEB128 or zigzag encoded LEB128, overflow is handled by mode
+void byte_buffer_put_uvarint(ByteBuffer* buffer, uint64_t value);
+void byte_buffer_put_svarint(ByteBuffer* buffer, int64_t value);
+
+/* decodes one varint at index of the content. Returns the count of consumed bytes, 
+   0 if the varint is truncated or longer than 64 bit.
+*/
+size_t byte_buffer_get_uvarint(ByteBuffer* buffer, size_t index, uint64_t* value);
+size_t byte_buffer_get_svarint(ByteBuffer* buffer, size_t index, int64_t* value);
+
+//decodes one varint from raw bytes, same result as byte_buffer_get_uvarint
+size_t byte_varint_decode(const unsigned char* bytes, size_t cntBytes, uint64_t* value);
+
+/* decodes a run of varints into values until maxValues are decoded or the bytes end. Stops in front of
+   a truncated or malformed varint. Uses SSE2 or AVX2 if the cpu supports it. Returns the count of decoded
+   values, consumed gets the count of used bytes.
+*/
+size_t byte_varint_decode_bulk(const unsigned char* bytes, size_t cntBytes, uint64_t* values, size_t maxValues, size_t* consumed);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,317 @@
+#include "byte_writer.h"
+#include "byte_io.h"
+
+#include <errno.h>
+
+#include <time.h>
+
+#define BYTE_WRITER_FMT_SCRATCH_SIZE 256
+
+static double __byte_writer_now()
+{
+	struct timespec now;
+	timespec_get(&now, TIME_UTC);
+	return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+}
+
+static void* __byte_writer_flush_thread(void* _writer)
+{
+	ByteWriter* writer = _writer;
+
+	pthread_mutex_lock(&writer->lock);
+
+	for (;;)
+	{
+		while (!writer->pending && !writer->stop)
+		{
+			pthread_cond_wait(&writer->flushRequest, &writer->lock);
+		}
+
+		if (!writer->pending) break;
+
+		ByteBuffer* pending = writer->pending;
+
+		//write without lock, the producer keeps filling the active buffer
+		pthread_mutex_unlock(&writer->lock);
+
+		size_t written = 0;
+		double start = __byte_writer_now();
+		bool success = byte_buffer_writev_fd(writer->fd, &pending, 1, &written);
+		double writeTime = __byte_writer_now() - start;
+
+		pthread_mutex_lock(&writer->lock);
+
+		if (!success && writer->error == 0)
+		{
+			writer->error = errno;
+		}
+
+		writer->stats.bytesWritten += written;
+		writer->stats.writeSeconds += writeTime;
+		writer->stats.cntFlushes++;
+
+		pending->offset = 0;
+		writer->pending = NULL;
+
+		pthread_cond_broadcast(&writer->flushDone);
+	}
+
+	pthread_mutex_unlock(&writer->lock);
+
+	return NULL;
+}
+
+//hands the active buffer over to the flush thread. Waits only if the other buffer is still written.
+static void __byte_writer_swap(ByteWriter* _writer)
+{
+	ByteWriter* writer = _writer;
+
+	pthread_mutex_lock(&writer->lock);
+
+	if (writer->pending)
+	{
+		double start = __byte_writer_now();
+
+		while (writer->pending)
+		{
+			pthread_cond_wait(&writer->flushDone, &writer->lock);
+		}
+
+		writer->stats.stallSeconds += __byte_writer_now() - start;
+	}
+
+	writer->pending = writer->active;
+	writer->active = ( writer->active == &writer->buffers[0] ? &writer->buffers[1] : &writer->buffers[0] );
+
+	pthread_cond_signal(&writer->flushRequest);
+	pthread_mutex_unlock(&writer->lock);
+}
+
+ByteWriter* byte_writer_new(int fd, size_t bufferSize)
+{
+	const MemAllocator* allocator = mem_allocator_get();
+	ByteWriter* new_writer = mem_allocator_alloc(allocator, sizeof(ByteWriter));
+
+	if (new_writer && !byte_writer_init(new_writer, fd, bufferSize))
+	{
+		mem_allocator_free(allocator, new_writer);
+		return NULL;
+	}
+
+	if (new_writer)
+	{
+		new_writer->allocObj = true;
+	}
+
+	return new_writer;
+}
+
+static void __byte_writer_free_buffers(ByteWriter* writer)
+{
+	ByteBuffer* buffer = &writer->buffers[0];
+	byte_buffer_free(&buffer);
+	buffer = &writer->buffers[1];
+	byte_buffer_free(&buffer);
+}
+
+bool byte_writer_init(ByteWriter* _writer, int fd, size_t bufferSize)
+{
+	ByteWriter* writer = _writer;
+	if (!writer || bufferSize == 0) return false;
+
+	memset(writer, 0, sizeof(ByteWriter));
+
+	writer->fd = fd;
+	writer->allocator = mem_allocator_get();
+
+	byte_buffer_init_new_allocator(&writer->buffers[0], BYTE_BUFFER_TRUNCATE, bufferSize, writer->allocator);
+	byte_buffer_init_new_allocator(&writer->buffers[1], BYTE_BUFFER_TRUNCATE, bufferSize, writer->allocator);
+
+	writer->active = &writer->buffers[0];
+	writer->startTime = __byte_writer_now();
+
+	if (!writer->buffers[0].buffer || !writer->buffers[1].buffer)
+	{
+		__byte_writer_free_buffers(writer);
+		return false;
+	}
+
+	pthread_mutex_init(&writer->producerLock, NULL);
+	pthread_mutex_init(&writer->lock, NULL);
+	pthread_cond_init(&writer->flushRequest, NULL);
+	pthread_cond_init(&writer->flushDone, NULL);
+
+	if (pthread_create(&writer->thread, NULL, __byte_writer_flush_thread, writer) != 0)
+	{
+		pthread_cond_destroy(&writer->flushDone);
+		pthread_cond_destroy(&writer->flushRequest);
+		pthread_mutex_destroy(&writer->lock);
+		pthread_mutex_destroy(&writer->producerLock);
+		__byte_writer_free_buffers(writer);
+		return false;
+	}
+
+	return true;
+}
+
+void byte_writer_free(ByteWriter** _writer)
+{
+	ByteWriter** writer = _writer;
+	if (writer && *writer)
+	{
+		ByteWriter* toDelete = *writer;
+
+		byte_writer_flush(toDelete);
+
+		pthread_mutex_lock(&toDelete->lock);
+		toDelete->stop = true;
+		pthread_cond_signal(&toDelete->flushRequest);
+		pthread_mutex_unlock(&toDelete->lock);
+
+		pthread_join(toDelete->thread, NULL);
+
+		pthread_cond_destroy(&toDelete->flushDone);
+		pthread_cond_destroy(&toDelete->flushRequest);
+		pthread_mutex_destroy(&toDelete->lock);
+		pthread_mutex_destroy(&toDelete->producerLock);
+
+		__byte_writer_free_buffers(toDelete);
+
+		toDelete->active = NULL;
+
+		if (toDelete->allocObj)
+		{
+			mem_allocator_free(toDelete->allocator, toDelete);
+			*writer = NULL;
+		}
+	}
+}
+
+void byte_writer_append_byte(ByteWriter* writer, unsigned char byte)
+{
+	byte_writer_append_bytes(writer, &byte, 1);
+}
+
+void byte_writer_append_bytes(ByteWriter* _writer, unsigned char* bytes, size_t cntBytes)
+{
+	ByteWriter* writer = _writer;
+	if (!writer) return;
+
+	pthread_mutex_lock(&writer->producerLock);
+
+	//appends larger than the free space are split over several buffers, but stay in one piece in the output
+	while (cntBytes > 0)
+	{
+		ByteBuffer* active = writer->active;
+		size_t freeBytes = active->size - active->offset;
+
+		if (freeBytes == 0)
+		{
+			__byte_writer_swap(writer);
+			continue;
+		}
+
+		size_t cntCopy = ( cntBytes < freeBytes ? cntBytes : freeBytes );
+
+		byte_buffer_append_bytes(active, bytes, cntCopy);
+
+		bytes += cntCopy;
+		cntBytes -= cntCopy;
+	}
+
+	pthread_mutex_unlock(&writer->producerLock);
+}
+
+void byte_writer_append_bytes_fmt(ByteWriter* _writer, const char* fmt, ...)
+{
+	ByteWriter* writer = _writer;
+	if (!writer) return;
+
+	char scratch[BYTE_WRITER_FMT_SCRATCH_SIZE];
+	char* formatted = &scratch[0];
+
+	va_list args;
+	va_start(args, fmt);
+
+	int formattedSize = vsnprintf(formatted, sizeof(scratch), fmt, args);
+
+	va_end(args);
+
+	//only long lines need a second pass into heap memory
+	if (formattedSize >= (int)sizeof(scratch))
+	{
+		formatted = mem_allocator_alloc(writer->allocator, (size_t)formattedSize + 1);
+
+		va_start(args, fmt);
+
+		if (formatted)
+		{
+			vsnprintf(formatted, (size_t)formattedSize + 1, fmt, args);
+		}
+
+		va_end(args);
+	}
+
+	if (formatted && formattedSize > 0)
+	{
+		byte_writer_append_bytes(writer, (unsigned char*)formatted, (size_t)formattedSize);
+	}
+
+	if (formatted != &scratch[0])
+	{
+		mem_allocator_free(writer->allocator, formatted);
+	}
+}
+
+bool byte_writer_flush(ByteWriter* _writer)
+{
+	ByteWriter* writer = _writer;
+	if (!writer) return false;
+
+	pthread_mutex_lock(&writer->producerLock);
+
+	if (writer->active->offset > 0)
+	{
+		__byte_writer_swap(writer);
+	}
+
+	pthread_mutex_unlock(&writer->producerLock);
+
+	pthread_mutex_lock(&writer->lock);
+
+	while (writer->pending)
+	{
+		pthread_cond_wait(&writer->flushDone, &writer->lock);
+	}
+
+	bool success = (writer->error == 0);
+
+	pthread_mutex_unlock(&writer->lock);
+
+	return success;
+}
+
+int byte_writer_error(ByteWriter* _writer)
+{
+	ByteWriter* writer = _writer;
+
+	pthread_mutex_lock(&writer->lock);
+	int error = writer->error;
+	pthread_mutex_unlock(&writer->lock);
+
+	return error;
+}
+
+void byte_writer_stats(ByteWriter* _writer, ByteWriterStats* stats)
+{
+	ByteWriter* writer = _writer;
+
+	pthread_mutex_lock(&writer->lock);
+
+	*stats = writer->stats;
+
+	pthread_mutex_unlock(&writer->lock);
+
+	stats->elapsedSeconds = __byte_writer_now() - writer->startTime;
+	stats->bytesPerSecond = ( stats->writeSeconds > 0. ? (double)stats->bytesWritten / stats->writeSeconds : 0. );
+}
\ No newline at end of file
@@ -0,0 +1,64 @@
+#ifndef BYTE_WRITER_H
+#define BYTE_WRITER_H
+
+#include <pthread.h>
+
+#include "byte_utils.h"
+
+typedef struct 
+{
+    size_t bytesWritten;        //bytes written to fd
+    size_t cntFlushes;          //count of written buffers
+    double elapsedSeconds;      //since init
+    double writeSeconds;        //time the flush thread spent in write calls
+    double stallSeconds;        //time producers waited for a free buffer
+    double bytesPerSecond;      //bytesWritten / writeSeconds
+} ByteWriterStats;
+
+/* Double buffered writer: producers fill the active buffer while a background thread writes
+   the other one to fd. Producers only wait if the active buffer is full and the flush of the
+   other one is still running. Several producer threads can share a writer, their appends are
+   serialized and each append stays in one piece. The fd is not closed by the writer.
+*/
+typedef struct 
+{
+    bool allocObj;              //true, if byte_writer_new was called
+    int fd;
+    ByteBuffer buffers[2];
+    ByteBuffer* active;         //buffer filled by producers, guarded by producerLock
+    ByteBuffer* pending;        //buffer handed over to the flush thread, NULL if none
+    bool stop;
+    int error;                  //errno of the first failed write
+    pthread_t thread;
+    pthread_mutex_t producerLock; //held by a producer during a complete append or flush
+    pthread_mutex_t lock;       //hand over between producers and the flush thread
+    pthread_cond_t flushRequest;
+    pthread_cond_t flushDone;
+    ByteWriterStats stats;
+    double startTime;
+    const MemAllocator* allocator; //routines for buffers, temporary lines and the object, global allocator at init
+} ByteWriter;
+
+//Allocates a complete Writer Object, NULL on error
+ByteWriter* byte_writer_new(int fd, size_t bufferSize);
+
+//Allocates both buffers and starts the flush thread, false on error
+bool byte_writer_init(ByteWriter* writer, int fd, size_t bufferSize);
+
+//writes the rest, stops the flush thread and frees the buffers
+void byte_writer_free(ByteWriter** writer);
+
+//adding byte or bytes to the active buffer
+void byte_writer_append_byte(ByteWriter* writer, unsigned char byte);
+void byte_writer_append_bytes(ByteWriter* writer, unsigned char* bytes, size_t cntBytes);
+void byte_writer_append_bytes_fmt(ByteWriter* writer, const char* fmt, ...);
+
+//hands the active buffer over and waits until everything is written. False if a write failed.
+bool byte_writer_flush(ByteWriter* writer);
+
+//errno of the first failed write, 0 if all writes succeeded
+int byte_writer_error(ByteWriter* writer);
+
+void byte_writer_stats(ByteWriter* writer, ByteWriterStats* stats);
+
+#endif
\ No newline at end of file
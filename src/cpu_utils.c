@@ -0,0 +1,48 @@
+#include "cpu_utils.h"
+
+#include <stdatomic.h>
+
+static atomic_uint __cpu_disabled_features = 0;
+
+static unsigned __cpu_detect_features()
+{
+	unsigned features = 0;
+
+#ifdef CPU_UTILS_X86
+	__builtin_cpu_init();
+
+	if (__builtin_cpu_supports("sse2"))  features |= CPU_FEATURE_SSE2;
+	if (__builtin_cpu_supports("ssse3")) features |= CPU_FEATURE_SSSE3;
+	if (__builtin_cpu_supports("sse4.1")) features |= CPU_FEATURE_SSE41;
+	if (__builtin_cpu_supports("sse4.2")) features |= CPU_FEATURE_SSE42;
+	if (__builtin_cpu_supports("avx2"))  features |= CPU_FEATURE_AVX2;
+	if (__builtin_cpu_supports("bmi2"))  features |= CPU_FEATURE_BMI2;
+#endif
+
+	return features;
+}
+
+unsigned cpu_features()
+{
+	//detection is idempotent, so a race on first use only does the work twice
+	static atomic_uint detected = 0;
+	static atomic_bool isDetected = false;
+
+	if (!atomic_load_explicit(&isDetected, memory_order_acquire))
+	{
+		atomic_store_explicit(&detected, __cpu_detect_features(), memory_order_relaxed);
+		atomic_store_explicit(&isDetected, true, memory_order_release);
+	}
+
+	return atomic_load_explicit(&detected, memory_order_relaxed) & ~atomic_load_explicit(&__cpu_disabled_features, memory_order_relaxed);
+}
+
+bool cpu_has_feature(CpuFeature feature)
+{
+	return (cpu_features() & (unsigned)feature) != 0;
+}
+
+void cpu_features_disable(unsigned features)
+{
+	atomic_store_explicit(&__cpu_disabled_features, features, memory_order_relaxed);
+}
\ No newline at end of file
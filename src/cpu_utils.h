@@ -0,0 +1,28 @@
+#ifndef CPU_UTILS_H
+#define CPU_UTILS_H
+
+#include <stdbool.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #define CPU_UTILS_X86 1     //SIMD kernels with target attributes are available
+#endif
+
+typedef enum
+{
+    CPU_FEATURE_SSE2   = 1 << 0,
+    CPU_FEATURE_SSSE3  = 1 << 1,
+    CPU_FEATURE_SSE41  = 1 << 2,
+    CPU_FEATURE_SSE42  = 1 << 3,
+    CPU_FEATURE_AVX2   = 1 << 4,
+    CPU_FEATURE_BMI2   = 1 << 5
+} CpuFeature;
+
+//features of the running cpu as CpuFeature bits, without the disabled ones
+unsigned cpu_features();
+
+bool cpu_has_feature(CpuFeature feature);
+
+//hides features from cpu_features, used by tests and benchmarks to run the fallback paths. 0 enables all again.
+void cpu_features_disable(unsigned features);
+
+#endif
\ No newline at end of file
@@ -1,45 +1,55 @@
 #include "file_path_utils.h"
 
-char * path_from_full_filepath(const char * full_file_path) {
+//copies count chars of string, taken from arena or the global allocator if arena is NULL
+static char * __copy_string_part(MemArena * arena, const char * string, size_t count) {
+	char *part = (arena ? mem_arena_alloc_aligned(arena, (count+1)*sizeof(char), 1) : mem_alloc((count+1)*sizeof(char)));
+	if ( part ) {
+		memcpy(part, string, count);
+		part[count] = '\0';
+	}
+	return part;
+}
+
+static char * __path_from_full_filepath(MemArena * arena, const char * full_file_path) {
 	const char *pLastSlash = strrchr(full_file_path, '/');
 	char *path = NULL;
 	if ( pLastSlash ) {
 		size_t count = pLastSlash - full_file_path;
 		count++;
-		path = malloc((count+1)*sizeof(char));
-		strncpy(path, full_file_path, count);
-		path[count] = '\0';
+		path = __copy_string_part(arena, full_file_path, count);
 	}
 	
 	return path;
 }
 
-char * file_from_full_filepath(const char * full_file_path) {
+static char * __file_from_full_filepath(MemArena * arena, const char * full_file_path) {
 	const char *pLastSlash = strrchr(full_file_path, '/');
 	if ( !pLastSlash ) { pLastSlash = full_file_path; }
 	else { pLastSlash++; }
 	
 	char * file = NULL;
-	if (strlen(pLastSlash) > 0) {
-		file = copy_string(pLastSlash);
+	size_t count = strlen(pLastSlash);
+	if (count > 0) {
+		file = __copy_string_part(arena, pLastSlash, count);
 	}
 	return file;
 }
 
-char * type_from_filename(const char * file_name) {
+static char * __type_from_filename(MemArena * arena, const char * file_name) {
 
 	const char *pLastPoint = strrchr(file_name, '.');
 	if ( !pLastPoint ) { pLastPoint = file_name; }
 	else { pLastPoint++; }
 	char *type = NULL;
-	if ( strlen(pLastPoint) > 0) {
-		type = copy_string(pLastPoint);
+	size_t count = strlen(pLastPoint);
+	if ( count > 0) {
+		type = __copy_string_part(arena, pLastPoint, count);
 	}
 	
 	return type;
 }
 
-char * name_from_filename(const char * file_name) {
+static char * __name_from_filename(MemArena * arena, const char * file_name) {
 
 	const char *pLastSlash = strrchr(file_name, '/');
 	if ( !pLastSlash ) { pLastSlash = file_name; }
@@ -49,10 +59,39 @@ char * name_from_filename(const char * file_name) {
 	size_t count = 0;
 	if ( !pLastPoint ) { count = strlen(pLastSlash); }
 	else { count = pLastPoint - pLastSlash; }
-	char *name = malloc((count+1)*sizeof(char));
-	strncpy(name, pLastSlash, count);
-	name[count] = '\0';
-	return name;
+	return __copy_string_part(arena, pLastSlash, count);
+}
+
+char * path_from_full_filepath(const char * full_file_path) {
+	return __path_from_full_filepath(NULL, full_file_path);
+}
+
+char * file_from_full_filepath(const char * full_file_path) {
+	return __file_from_full_filepath(NULL, full_file_path);
+}
+
+char * type_from_filename(const char * file_name) {
+	return __type_from_filename(NULL, file_name);
+}
+
+char * name_from_filename(const char * file_name) {
+	return __name_from_filename(NULL, file_name);
+}
+
+char * path_from_full_filepath_arena(MemArena * arena, const char * full_file_path) {
+	return ( arena ? __path_from_full_filepath(arena, full_file_path) : NULL );
+}
+
+char * file_from_full_filepath_arena(MemArena * arena, const char * full_file_path) {
+	return ( arena ? __file_from_full_filepath(arena, full_file_path) : NULL );
+}
+
+char * type_from_filename_arena(MemArena * arena, const char * file_name) {
+	return ( arena ? __type_from_filename(arena, file_name) : NULL );
+}
+
+char * name_from_filename_arena(MemArena * arena, const char * file_name) {
+	return ( arena ? __name_from_filename(arena, file_name) : NULL );
 }
 
 int u_file_exists(const char* file_name)
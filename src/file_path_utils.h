@@ -7,11 +7,18 @@
 #include "string_utils.h"
 
 
+//results are taken from the global allocator, release them with mem_free
 char * path_from_full_filepath(const char * full_file_path);
 char * file_from_full_filepath(const char * full_file_path);
 char * type_from_filename(const char * file_name);
 char * name_from_filename(const char * file_name);
 
+//variants taking the memory from arena, released with mem_arena_reset instead of free
+char * path_from_full_filepath_arena(MemArena * arena, const char * full_file_path);
+char * file_from_full_filepath_arena(MemArena * arena, const char * full_file_path);
+char * type_from_filename_arena(MemArena * arena, const char * file_name);
+char * name_from_filename_arena(MemArena * arena, const char * file_name);
+
 int u_file_exists(const char* file_name);
 
 #endif
\ No newline at end of file
@@ -2,31 +2,68 @@
 
 char * copy_string(const char * string) {
 	size_t size = strlen(string) + 1;
-	char * copy = malloc(size*sizeof(char));
+	char * copy = mem_alloc(size*sizeof(char));
 	memcpy(copy, string, size);
 	return copy;
 }
 
+#define FORMAT_STRING_SCRATCH_SIZE 256
+
 char * format_string_new(const char * msg, ...) {
 	va_list vl;
 	va_start(vl, msg);
-	int buffsize = vsnprintf(NULL, 0, msg, vl);
+	char * buffer = format_string_va_new(msg, vl);
 	va_end(vl);
+	return buffer;
+}
+
+char * format_string_va_new(const char * msg, va_list argptr)  {
+	va_list argptr_copy;
+	va_copy(argptr_copy, argptr);
+	char scratch[FORMAT_STRING_SCRATCH_SIZE];
+	int buffsize = vsnprintf(scratch, FORMAT_STRING_SCRATCH_SIZE, msg, argptr);
 	buffsize += 1;
-	char * buffer = malloc(buffsize);
+	char * buffer = (buffsize > 0 ? mem_alloc(buffsize) : NULL);
+	if (buffer && buffsize <= FORMAT_STRING_SCRATCH_SIZE) {
+		//short strings are formatted once into scratch
+		memcpy(buffer, scratch, buffsize);
+	} else if (buffer) {
+		vsnprintf(buffer, buffsize, msg, argptr_copy);
+	}
+	va_end(argptr_copy);
+	return buffer;
+}
+
+char * copy_string_arena(MemArena * arena, const char * string) {
+	size_t size = strlen(string) + 1;
+	char * copy = mem_arena_alloc_aligned(arena, size*sizeof(char), 1);
+	if (copy) {
+		memcpy(copy, string, size);
+	}
+	return copy;
+}
+
+char * format_string_arena(MemArena * arena, const char * msg, ...) {
+	va_list vl;
 	va_start(vl, msg);
-	vsnprintf(buffer, buffsize, msg, vl);
-	va_end( vl);
+	char * buffer = format_string_va_arena(arena, msg, vl);
+	va_end(vl);
 	return buffer;
 }
 
-char * format_string_va_new(const char * msg, va_list argptr)  {
+char * format_string_va_arena(MemArena * arena, const char * msg, va_list argptr)  {
 	va_list argptr_copy;
 	va_copy(argptr_copy, argptr);
-	int buffsize = vsnprintf(NULL, 0, msg, argptr);
+	char scratch[FORMAT_STRING_SCRATCH_SIZE];
+	int buffsize = vsnprintf(scratch, FORMAT_STRING_SCRATCH_SIZE, msg, argptr);
 	buffsize += 1;
-	char * buffer = malloc(buffsize);
-	vsnprintf(buffer, buffsize, msg, argptr_copy);
+	char * buffer = (buffsize > 0 ? mem_arena_alloc_aligned(arena, buffsize, 1) : NULL);
+	if (buffer && buffsize <= FORMAT_STRING_SCRATCH_SIZE) {
+		memcpy(buffer, scratch, buffsize);
+	} else if (buffer) {
+		vsnprintf(buffer, buffsize, msg, argptr_copy);
+	}
+	va_end(argptr_copy);
 	return buffer;
 }
 
@@ -6,10 +6,17 @@
 #include <stdio.h>
 #include <stdarg.h>
 #include <stdbool.h>
+#include "arena_utils.h"
+#include "alloc_utils.h"
 
+//new strings are taken from the global allocator, release them with mem_free
 char * copy_string(const char * string);
 char * format_string_new(const char * msg, ...);
 char * format_string_va_new(const char * msg, va_list argptr);
+//variants taking the memory from arena, released with mem_arena_reset instead of free
+char * copy_string_arena(MemArena * arena, const char * string);
+char * format_string_arena(MemArena * arena, const char * msg, ...);
+char * format_string_va_arena(MemArena * arena, const char * msg, va_list argptr);
 bool name_match(const unsigned char *search, const unsigned char *base);
 bool is_not_blank(const char * string);
 
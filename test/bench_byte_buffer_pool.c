@@ -0,0 +1,117 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
+
+#include "defs.h"
+#include "byte_buffer_pool.h"
+
+#define BENCH_POOL_OPS (2 * 1000 * 1000)
+#define BENCH_POOL_LIVE 16
+
+typedef struct 
+{
+	ByteBufferPool *pool;       //NULL for byte_buffer_new/free
+	size_t cntOps;
+	size_t seed;
+} BenchPoolThread;
+
+static double __bench_pool_now()
+{
+	struct timespec now;
+	timespec_get(&now, TIME_UTC);
+	return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+}
+
+//short lived buffers of 64 bytes to 16 KiB with a few kept alive like in a request path
+static void* __bench_pool_worker(void* _thread)
+{
+	BenchPoolThread *thread = _thread;
+	ByteBuffer *live[BENCH_POOL_LIVE] = { NULL };
+	size_t state = thread->seed;
+
+	for (size_t curOp = 0; curOp < thread->cntOps; curOp++)
+	{
+		state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+		size_t size = (size_t)64 << ((state >> 33) % 9);
+		size_t slot = (state >> 45) % BENCH_POOL_LIVE;
+
+		if (live[slot])
+		{
+			if (thread->pool) byte_buffer_free_pooled(&live[slot]);
+			else byte_buffer_free(&live[slot]);
+		}
+
+		live[slot] = ( thread->pool ? byte_buffer_new_pooled(thread->pool, BYTE_BUFFER_TRUNCATE, size) 
+		                            : byte_buffer_new(BYTE_BUFFER_TRUNCATE, size) );
+
+		byte_buffer_append_bytes(live[slot], (unsigned char *)"REQUEST", 7);
+	}
+
+	for (size_t curSlot = 0; curSlot < BENCH_POOL_LIVE; curSlot++)
+	{
+		if (thread->pool) byte_buffer_free_pooled(&live[curSlot]);
+		else byte_buffer_free(&live[curSlot]);
+	}
+
+	return NULL;
+}
+
+//million new/free pairs per second
+static double __bench_pool_run(ByteBufferPool* pool, size_t cntThreads)
+{
+	pthread_t threads[16];
+	BenchPoolThread threadData[16];
+
+	double start = __bench_pool_now();
+
+	for (size_t curThread = 0; curThread < cntThreads; curThread++)
+	{
+		threadData[curThread].pool = pool;
+		threadData[curThread].cntOps = BENCH_POOL_OPS / cntThreads;
+		threadData[curThread].seed = curThread + 1;
+		pthread_create(&threads[curThread], NULL, __bench_pool_worker, &threadData[curThread]);
+	}
+
+	for (size_t curThread = 0; curThread < cntThreads; curThread++)
+	{
+		pthread_join(threads[curThread], NULL);
+	}
+
+	double elapsed = __bench_pool_now() - start;
+
+	return (double)BENCH_POOL_OPS / elapsed / 1e6;
+}
+
+static void bench_pool()
+{
+	size_t threadCounts[] = { 1, 4, 16 };
+
+	printf("%d new/free pairs [Mops/s]\n", BENCH_POOL_OPS);
+	printf("%8s %10s %10s %8s %10s %10s\n", "threads", "malloc", "pooled", "ratio", "hits", "misses");
+
+	for (size_t curCount = 0; curCount < sizeof(threadCounts) / sizeof(threadCounts[0]); curCount++)
+	{
+		ByteBufferPool *pool = byte_buffer_pool_new();
+
+		double mallocRate = __bench_pool_run(NULL, threadCounts[curCount]);
+		double pooledRate = __bench_pool_run(pool, threadCounts[curCount]);
+
+		ByteBufferPoolStats stats;
+		byte_buffer_pool_stats(pool, &stats);
+
+		printf("%8zu %10.1f %10.1f %8.2f %10zu %10zu\n", threadCounts[curCount], mallocRate, pooledRate, pooledRate / mallocRate, stats.hits, stats.misses);
+
+		byte_buffer_pool_free(&pool);
+	}
+}
+
+int main(int argc, char **argv) {
+	UNUSED(argc);
+	UNUSED(argv);
+
+	bench_pool();
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,126 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "defs.h"
+#include "cpu_utils.h"
+#include "byte_codec.h"
+#include "test_utils.h"
+
+#define BENCH_CODEC_SIZE (12 * 1024 * 1024)
+#define BENCH_CODEC_ROUNDS 10
+
+static double __bench_codec_now()
+{
+	struct timespec now;
+	timespec_get(&now, TIME_UTC);
+	return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+}
+
+typedef enum
+{
+	BENCH_CODEC_BASE64_ENCODE,
+	BENCH_CODEC_BASE64_DECODE,
+	BENCH_CODEC_HEX_ENCODE,
+	BENCH_CODEC_HEX_DECODE,
+	BENCH_CODEC_BUFFER_BASE64_ENCODE
+} BenchCodecKind;
+
+typedef struct
+{
+	ByteView data;
+	ByteView base64;
+	ByteView hex;
+	unsigned char* dest;
+	ByteBuffer* buffer;
+} BenchCodecData;
+
+static size_t __bench_codec_run(BenchCodecKind kind, BenchCodecData* bench)
+{
+	size_t cntDecoded = 0;
+
+	switch(kind)
+	{
+		case BENCH_CODEC_BASE64_ENCODE: return byte_base64_encode(bench->dest, bench->data);
+		case BENCH_CODEC_BASE64_DECODE: byte_base64_decode(bench->dest, bench->base64, &cntDecoded); return cntDecoded;
+		case BENCH_CODEC_HEX_ENCODE:    return byte_hex_encode(bench->dest, bench->data);
+		case BENCH_CODEC_HEX_DECODE:    byte_hex_decode(bench->dest, bench->hex, &cntDecoded); return cntDecoded;
+		case BENCH_CODEC_BUFFER_BASE64_ENCODE:
+			byte_buffer_clear(bench->buffer);
+			byte_buffer_append_base64_encoded(bench->buffer, bench->data);
+			return bench->buffer->offset;
+	}
+
+	return 0;
+}
+
+//GB of binary data per second
+static double __bench_codec_rate(BenchCodecKind kind, BenchCodecData* bench, unsigned disabledFeatures)
+{
+	cpu_features_disable(disabledFeatures);
+
+	size_t sink = 0;
+	double start = __bench_codec_now();
+
+	for (size_t curRound = 0; curRound < BENCH_CODEC_ROUNDS; curRound++)
+	{
+		sink ^= __bench_codec_run(kind, bench);
+	}
+
+	double elapsed = __bench_codec_now() - start;
+
+	cpu_features_disable(0);
+
+	if (sink == 0x5A5A5A5A) printf(" ");
+
+	return (double)BENCH_CODEC_SIZE * BENCH_CODEC_ROUNDS / elapsed / 1e9;
+}
+
+static void __bench_codec_line(const char* name, BenchCodecKind kind, BenchCodecData* bench)
+{
+	printf("%24s %8.2f %8.2f %8.2f\n", name,
+	       __bench_codec_rate(kind, bench, ~0U),
+	       __bench_codec_rate(kind, bench, CPU_FEATURE_AVX2),
+	       __bench_codec_rate(kind, bench, 0));
+}
+
+static void bench_codec()
+{
+	unsigned char* data = malloc(BENCH_CODEC_SIZE);
+	unsigned char* base64 = malloc(byte_base64_encoded_size(BENCH_CODEC_SIZE));
+	unsigned char* hex = malloc(byte_hex_encoded_size(BENCH_CODEC_SIZE));
+
+	test_random_fill(data, BENCH_CODEC_SIZE);
+
+	BenchCodecData bench;
+	bench.data = byte_view_of(data, BENCH_CODEC_SIZE);
+	bench.base64 = byte_view_of(base64, byte_base64_encode(base64, bench.data));
+	bench.hex = byte_view_of(hex, byte_hex_encode(hex, bench.data));
+	bench.dest = malloc(byte_hex_encoded_size(BENCH_CODEC_SIZE));
+	bench.buffer = byte_buffer_new(BYTE_BUFFER_GROW, byte_base64_encoded_size(BENCH_CODEC_SIZE));
+
+	printf("codec %d MiB [GB/s of binary data], cpu ssse3: %d avx2: %d\n", BENCH_CODEC_SIZE / (1024 * 1024),
+	       cpu_has_feature(CPU_FEATURE_SSSE3), cpu_has_feature(CPU_FEATURE_AVX2));
+	printf("%24s %8s %8s %8s\n", "", "scalar", "ssse3", "avx2");
+	__bench_codec_line("base64 encode", BENCH_CODEC_BASE64_ENCODE, &bench);
+	__bench_codec_line("base64 decode", BENCH_CODEC_BASE64_DECODE, &bench);
+	__bench_codec_line("hex encode", BENCH_CODEC_HEX_ENCODE, &bench);
+	__bench_codec_line("hex decode", BENCH_CODEC_HEX_DECODE, &bench);
+	__bench_codec_line("buffer base64 encode", BENCH_CODEC_BUFFER_BASE64_ENCODE, &bench);
+
+	free(data);
+	free(base64);
+	free(hex);
+	free(bench.dest);
+	byte_buffer_free(&bench.buffer);
+}
+
+int main(int argc, char **argv) {
+	UNUSED(argc);
+	UNUSED(argv);
+
+	bench_codec();
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,116 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+#include <time.h>
+
+#include "defs.h"
+#include "byte_format.h"
+#include "test_utils.h"
+
+#define BENCH_FORMAT_BUFFER_SIZE (64 * 1024)
+#define BENCH_FORMAT_VALUES (4 * 1024 * 1024)
+
+typedef enum
+{
+	BENCH_FORMAT_I64,
+	BENCH_FORMAT_U64,
+	BENCH_FORMAT_HEX,
+	BENCH_FORMAT_F64
+} BenchFormatKind;
+
+static double __bench_format_now()
+{
+	struct timespec now;
+	timespec_get(&now, TIME_UTC);
+	return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+}
+
+//appends all values either with the serializers or with the matching fmt call. Returns million values per second.
+static double __bench_format(BenchFormatKind kind, bool useFmt, uint64_t* values, size_t cntValues)
+{
+	ByteBuffer *buffer = byte_buffer_new(BYTE_BUFFER_TRUNCATE, BENCH_FORMAT_BUFFER_SIZE);
+	size_t written = 0;
+
+	double start = __bench_format_now();
+
+	for (size_t curValue = 0; curValue < cntValues; curValue++)
+	{
+		if (buffer->offset + 32 > buffer->size)
+		{
+			written += buffer->offset;
+			buffer->offset = 0;
+		}
+
+		uint64_t value = values[curValue];
+		double f64Value = (double)(int64_t)value / 1e6;
+
+		switch (kind)
+		{
+			case BENCH_FORMAT_I64:
+				if (useFmt) byte_buffer_append_bytes_fmt(buffer, "%" PRId64, (int64_t)value);
+				else byte_buffer_append_i64(buffer, (int64_t)value);
+				break;
+			case BENCH_FORMAT_U64:
+				if (useFmt) byte_buffer_append_bytes_fmt(buffer, "%" PRIu64, value);
+				else byte_buffer_append_u64(buffer, value);
+				break;
+			case BENCH_FORMAT_HEX:
+				if (useFmt) byte_buffer_append_bytes_fmt(buffer, "%" PRIx64, value);
+				else byte_buffer_append_hex(buffer, value);
+				break;
+			case BENCH_FORMAT_F64:
+				//%.17g is the printf way to get a value which reads back exactly
+				if (useFmt) byte_buffer_append_bytes_fmt(buffer, "%.17g", f64Value);
+				else byte_buffer_append_f64(buffer, f64Value);
+				break;
+		}
+	}
+
+	double elapsed = __bench_format_now() - start;
+
+	//keeps the compiler from dropping the appends
+	volatile size_t sink = written + buffer->offset;
+	UNUSED(sink);
+
+	byte_buffer_free(&buffer);
+
+	return (double)cntValues / elapsed / 1e6;
+}
+
+static void bench_format()
+{
+	uint64_t* values = malloc(BENCH_FORMAT_VALUES * sizeof(uint64_t));
+	uint64_t state = TEST_RANDOM_SEED;
+
+	//mixed magnitudes, small values are the common case in logs
+	for (size_t curValue = 0; curValue < BENCH_FORMAT_VALUES; curValue++)
+	{
+		uint64_t random = test_random_next(&state);
+		values[curValue] = random >> (random % 60);
+	}
+
+	const char* names[] = { "i64", "u64", "hex", "f64" };
+
+	printf("%zu values [Mvalues/s]\n", (size_t)BENCH_FORMAT_VALUES);
+	printf("%6s %12s %12s %8s\n", "kind", "fmt", "direct", "speedup");
+
+	for (BenchFormatKind kind = BENCH_FORMAT_I64; kind <= BENCH_FORMAT_F64; kind++)
+	{
+		double fmtRate = __bench_format(kind, true, values, BENCH_FORMAT_VALUES);
+		double directRate = __bench_format(kind, false, values, BENCH_FORMAT_VALUES);
+
+		printf("%6s %12.1f %12.1f %8.2f\n", names[kind], fmtRate, directRate, directRate / fmtRate);
+	}
+
+	free(values);
+}
+
+int main(int argc, char **argv) {
+	UNUSED(argc);
+	UNUSED(argv);
+
+	bench_format();
+
+	return 0;
+}
\ No newline at end of file
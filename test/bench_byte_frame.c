@@ -0,0 +1,144 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "defs.h"
+#include "cpu_utils.h"
+#include "byte_frame.h"
+#include "test_utils.h"
+
+#define BENCH_FRAME_SIZE (32 * 1024 * 1024)
+#define BENCH_FRAME_ROUNDS 5
+#define BENCH_FRAME_BULK 256
+
+static double __bench_frame_now()
+{
+	struct timespec now;
+	timespec_get(&now, TIME_UTC);
+	return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+}
+
+typedef enum
+{
+	BENCH_FRAME_COPY,
+	BENCH_FRAME_NEXT,
+	BENCH_FRAME_BULK_READ
+} BenchFrameKind;
+
+//records of the data, the copy variant takes each record into its own buffer as before
+static size_t __bench_frame_run(BenchFrameKind kind, ByteView data)
+{
+	size_t sink = 0;
+
+	switch(kind)
+	{
+		case BENCH_FRAME_COPY:
+		{
+			const unsigned char* pos = data.ptr;
+			const unsigned char* end = data.ptr + data.len;
+			const unsigned char* found;
+
+			while ((found = memchr(pos, '\n', (size_t)(end - pos))) != NULL)
+			{
+				ByteBuffer *record = byte_buffer_new(BYTE_BUFFER_GROW, (size_t)(found - pos) + 1);
+				byte_buffer_clear(record);
+				byte_buffer_append_bytes(record, (unsigned char*)pos, (size_t)(found - pos));
+				sink += record->offset;
+				byte_buffer_free(&record);
+				pos = found + 1;
+			}
+			break;
+		}
+		case BENCH_FRAME_NEXT:
+		{
+			ByteFrameReader frames;
+			ByteView record;
+			byte_frame_init_delimited(&frames, data, byte_view_of((const unsigned char*)"\n", 1));
+
+			while (byte_frame_next(&frames, &record) == BYTE_FRAME_OK)
+			{
+				sink += record.len;
+			}
+			break;
+		}
+		case BENCH_FRAME_BULK_READ:
+		{
+			ByteFrameReader frames;
+			ByteView records[BENCH_FRAME_BULK];
+			ByteFrameStatus status = BYTE_FRAME_OK;
+			byte_frame_init_delimited(&frames, data, byte_view_of((const unsigned char*)"\n", 1));
+
+			while (status == BYTE_FRAME_OK)
+			{
+				size_t cntRecords = byte_frame_next_bulk(&frames, records, BENCH_FRAME_BULK, &status);
+				for (size_t curRecord = 0; curRecord < cntRecords; curRecord++)
+				{
+					sink += records[curRecord].len;
+				}
+			}
+			break;
+		}
+	}
+
+	return sink;
+}
+
+//GB per second
+static double __bench_frame_rate(BenchFrameKind kind, ByteView data, unsigned disabledFeatures)
+{
+	cpu_features_disable(disabledFeatures);
+
+	size_t sink = 0;
+	double start = __bench_frame_now();
+
+	for (size_t curRound = 0; curRound < BENCH_FRAME_ROUNDS; curRound++)
+	{
+		sink ^= __bench_frame_run(kind, data);
+	}
+
+	double elapsed = __bench_frame_now() - start;
+
+	cpu_features_disable(0);
+
+	if (sink == 0x5A5A5A5A) printf(" ");
+
+	return (double)data.len * BENCH_FRAME_ROUNDS / elapsed / 1e9;
+}
+
+static void bench_frame_lines(size_t maxLine)
+{
+	unsigned char* bytes = malloc(BENCH_FRAME_SIZE);
+	uint64_t state = TEST_RANDOM_SEED;
+
+	for (size_t curByte = 0; curByte < BENCH_FRAME_SIZE; curByte++)
+	{
+		uint64_t random = test_random_next(&state);
+		bytes[curByte] = (unsigned char)( random % maxLine == 0 ? '\n' : 'a' + random % 26 );
+	}
+
+	ByteView data = byte_view_of(bytes, BENCH_FRAME_SIZE);
+
+	printf("%10zu %10.2f %10.2f %10.2f %10.2f %10.2f\n", maxLine,
+	       __bench_frame_rate(BENCH_FRAME_COPY, data, 0),
+	       __bench_frame_rate(BENCH_FRAME_NEXT, data, 0),
+	       __bench_frame_rate(BENCH_FRAME_BULK_READ, data, ~0U),
+	       __bench_frame_rate(BENCH_FRAME_BULK_READ, data, CPU_FEATURE_AVX2),
+	       __bench_frame_rate(BENCH_FRAME_BULK_READ, data, 0));
+
+	free(bytes);
+}
+
+int main(int argc, char **argv) {
+	UNUSED(argc);
+	UNUSED(argv);
+
+	printf("newline records of %d MiB [GB/s], cpu avx2: %d\n", BENCH_FRAME_SIZE / (1024 * 1024), cpu_has_feature(CPU_FEATURE_AVX2));
+	printf("%10s %10s %10s %10s %10s %10s\n", "avg line", "copy", "next", "bulk scal", "bulk sse2", "bulk avx2");
+
+	bench_frame_lines(16);
+	bench_frame_lines(64);
+	bench_frame_lines(1024);
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,134 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "defs.h"
+#include "cpu_utils.h"
+#include "byte_hash.h"
+#include "test_utils.h"
+
+#define BENCH_HASH_SIZE (16 * 1024 * 1024)
+#define BENCH_HASH_ROUNDS 20
+
+static double __bench_hash_now()
+{
+	struct timespec now;
+	timespec_get(&now, TIME_UTC);
+	return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+}
+
+//the usual bytewise table crc as baseline
+static uint32_t benchHashTable[256];
+
+static uint32_t __bench_hash_crc32c_bytewise(const unsigned char* bytes, size_t cntBytes)
+{
+	uint32_t crc = 0xFFFFFFFFU;
+
+	for (size_t curByte = 0; curByte < cntBytes; curByte++)
+	{
+		crc = (crc >> 8) ^ benchHashTable[(crc ^ bytes[curByte]) & 0xFF];
+	}
+
+	return ~crc;
+}
+
+typedef enum
+{
+	BENCH_HASH_MEMCPY,
+	BENCH_HASH_BYTEWISE,
+	BENCH_HASH_CRC32C,
+	BENCH_HASH_XXH64,
+	BENCH_HASH_HASHER
+} BenchHashKind;
+
+static uint64_t __bench_hash_run(BenchHashKind kind, ByteBuffer* buffer, unsigned char* copy)
+{
+	switch(kind)
+	{
+		case BENCH_HASH_MEMCPY:   memcpy(copy, buffer->buffer, BENCH_HASH_SIZE); return copy[BENCH_HASH_SIZE - 1];
+		case BENCH_HASH_BYTEWISE: return __bench_hash_crc32c_bytewise(buffer->buffer, BENCH_HASH_SIZE);
+		case BENCH_HASH_CRC32C:   return byte_buffer_crc32c(buffer);
+		case BENCH_HASH_XXH64:    return byte_buffer_xxh64(buffer, 0);
+		case BENCH_HASH_HASHER:
+		{
+			ByteBufferHasher hasher;
+			byte_buffer_hasher_init(&hasher, BYTE_HASH_CRC32C | BYTE_HASH_XXH64, 0);
+			byte_buffer_hasher_update(&hasher, buffer);
+			return hasher.crc32c ^ byte_buffer_hasher_xxh64(&hasher);
+		}
+	}
+
+	return 0;
+}
+
+//GB per second
+static double __bench_hash_rate(BenchHashKind kind, ByteBuffer* buffer, unsigned char* copy, unsigned disabledFeatures)
+{
+	cpu_features_disable(disabledFeatures);
+
+	uint64_t sink = 0;
+	double start = __bench_hash_now();
+
+	for (size_t curRound = 0; curRound < BENCH_HASH_ROUNDS; curRound++)
+	{
+		sink ^= __bench_hash_run(kind, buffer, copy);
+	}
+
+	double elapsed = __bench_hash_now() - start;
+
+	cpu_features_disable(0);
+
+	if (sink == 0x5A5A5A5A) printf(" ");
+
+	return (double)BENCH_HASH_SIZE * BENCH_HASH_ROUNDS / elapsed / 1e9;
+}
+
+static void bench_hash()
+{
+	for (uint32_t curByte = 0; curByte < 256; curByte++)
+	{
+		uint32_t crc = curByte;
+		for (int curBit = 0; curBit < 8; curBit++)
+		{
+			crc = (crc >> 1) ^ (0x82F63B78U & (0U - (crc & 1)));
+		}
+		benchHashTable[curByte] = crc;
+	}
+
+	ByteBuffer *buffer = byte_buffer_new(BYTE_BUFFER_TRUNCATE, BENCH_HASH_SIZE);
+	byte_buffer_clear(buffer);
+	unsigned char* copy = malloc(BENCH_HASH_SIZE);
+
+	uint64_t state = TEST_RANDOM_SEED;
+	for (size_t curByte = 0; curByte < BENCH_HASH_SIZE; curByte++)
+	{
+		byte_buffer_append_byte(buffer, (unsigned char)test_random_next(&state));
+	}
+
+	if (byte_buffer_crc32c(buffer) != __bench_hash_crc32c_bytewise(buffer->buffer, BENCH_HASH_SIZE))
+	{
+		printf("crc32c mismatch\n");
+		exit(1);
+	}
+
+	printf("hash %d MiB [GB/s], cpu sse4.2: %d\n", BENCH_HASH_SIZE / (1024 * 1024), cpu_has_feature(CPU_FEATURE_SSE42));
+	printf("%24s %8.2f\n", "memcpy", __bench_hash_rate(BENCH_HASH_MEMCPY, buffer, copy, 0));
+	printf("%24s %8.2f\n", "crc32c bytewise table", __bench_hash_rate(BENCH_HASH_BYTEWISE, buffer, copy, 0));
+	printf("%24s %8.2f\n", "crc32c slice by 8", __bench_hash_rate(BENCH_HASH_CRC32C, buffer, copy, ~0U));
+	printf("%24s %8.2f\n", "crc32c sse4.2", __bench_hash_rate(BENCH_HASH_CRC32C, buffer, copy, 0));
+	printf("%24s %8.2f\n", "xxh64", __bench_hash_rate(BENCH_HASH_XXH64, buffer, copy, 0));
+	printf("%24s %8.2f\n", "hasher crc32c + xxh64", __bench_hash_rate(BENCH_HASH_HASHER, buffer, copy, 0));
+
+	free(copy);
+	byte_buffer_free(&buffer);
+}
+
+int main(int argc, char **argv) {
+	UNUSED(argc);
+	UNUSED(argv);
+
+	bench_hash();
+
+	return 0;
+}
\ No newline at end of file
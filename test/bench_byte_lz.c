@@ -0,0 +1,123 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "defs.h"
+#include "byte_lz.h"
+#include "test_utils.h"
+
+#define BENCH_LZ_SIZE (16 * 1024 * 1024)
+#define BENCH_LZ_ROUNDS 5
+
+static double __bench_lz_now()
+{
+	struct timespec now;
+	timespec_get(&now, TIME_UTC);
+	return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+}
+
+typedef enum
+{
+	BENCH_LZ_MEMCPY,
+	BENCH_LZ_COMPRESS,
+	BENCH_LZ_DECOMPRESS
+} BenchLzKind;
+
+//GB of uncompressed data per second, both directions over the frame
+static double __bench_lz_rate(BenchLzKind kind, ByteView data, ByteBuffer* compressed, ByteBuffer* result)
+{
+	double start = __bench_lz_now();
+
+	for (size_t curRound = 0; curRound < BENCH_LZ_ROUNDS; curRound++)
+	{
+		switch(kind)
+		{
+			case BENCH_LZ_MEMCPY:
+				memcpy(result->buffer, data.ptr, data.len);
+				break;
+			case BENCH_LZ_COMPRESS:
+				byte_buffer_clear(compressed);
+				byte_buffer_append_lz_compressed(compressed, data);
+				break;
+			case BENCH_LZ_DECOMPRESS:
+				byte_buffer_clear(result);
+				if (!byte_buffer_append_lz_decompressed(result, byte_view_from_content(compressed)))
+				{
+					printf("decompression failed\n");
+					exit(1);
+				}
+				break;
+		}
+	}
+
+	return (double)data.len * BENCH_LZ_ROUNDS / (__bench_lz_now() - start) / 1e9;
+}
+
+static void bench_lz_data(const char* name, unsigned char* bytes)
+{
+	ByteView data = byte_view_of(bytes, BENCH_LZ_SIZE);
+	ByteBuffer *compressed = byte_buffer_new(BYTE_BUFFER_GROW, byte_lz_compress_bound(BENCH_LZ_SIZE));
+	ByteBuffer *result = byte_buffer_new(BYTE_BUFFER_GROW, BENCH_LZ_SIZE + BYTE_LZ_DEFAULT_BLOCK_SIZE);
+
+	double memcpyRate = __bench_lz_rate(BENCH_LZ_MEMCPY, data, compressed, result);
+	double compressRate = __bench_lz_rate(BENCH_LZ_COMPRESS, data, compressed, result);
+	double decompressRate = __bench_lz_rate(BENCH_LZ_DECOMPRESS, data, compressed, result);
+
+	if (!byte_view_equals(byte_view_from_content(result), data))
+	{
+		printf("round trip mismatch\n");
+		exit(1);
+	}
+
+	printf("%16s %8.1f%% %10.2f %10.2f %10.2f\n", name, 100.0 * (double)compressed->offset / BENCH_LZ_SIZE,
+	       compressRate, decompressRate, memcpyRate);
+
+	byte_buffer_free(&compressed);
+	byte_buffer_free(&result);
+}
+
+static void bench_lz()
+{
+	static const char* words[] = { "the ", "buffer ", "is ", "written ", "to ", "a ", "file ", "with ", "offset ", "size ",
+	                               "mode ", "grow ", "ring ", "and ", "of ", "0x1F ", "42 ", ", ", ".\n", "error " };
+	unsigned char* bytes = malloc(BENCH_LZ_SIZE);
+	uint64_t state = TEST_RANDOM_SEED;
+
+	printf("lz frames of %d MiB [GB/s of uncompressed data]\n", BENCH_LZ_SIZE / (1024 * 1024));
+	printf("%16s %9s %10s %10s %10s\n", "data", "ratio", "compress", "decompress", "memcpy");
+
+	for (size_t curByte = 0; curByte < BENCH_LZ_SIZE;)
+	{
+		const char* word = words[test_random_next(&state) % (sizeof(words) / sizeof(words[0]))];
+		for (size_t curChar = 0; word[curChar] && curByte < BENCH_LZ_SIZE; curChar++)
+		{
+			bytes[curByte++] = (unsigned char)word[curChar];
+		}
+	}
+	bench_lz_data("text", bytes);
+
+	for (size_t curByte = 0; curByte < BENCH_LZ_SIZE; curByte++)
+	{
+		uint64_t random = test_random_next(&state);
+		bytes[curByte] = (unsigned char)( curByte % 64 < 48 ? curByte / 4096 : random );
+	}
+	bench_lz_data("mixed", bytes);
+
+	for (size_t curByte = 0; curByte < BENCH_LZ_SIZE; curByte++)
+	{
+		bytes[curByte] = (unsigned char)test_random_next(&state);
+	}
+	bench_lz_data("random", bytes);
+
+	free(bytes);
+}
+
+int main(int argc, char **argv) {
+	UNUSED(argc);
+	UNUSED(argv);
+
+	bench_lz();
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,136 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <sched.h>
+
+#include "defs.h"
+#include "byte_mpmc_queue.h"
+
+#define BENCH_MPMC_MAX_THREADS 32
+#define BENCH_MPMC_RECORDS ((size_t)4 * 1024 * 1024)
+#define BENCH_MPMC_RECORD_SIZE 64
+
+typedef struct 
+{
+	ByteMpmcQueue *queue;
+	size_t cntRecords;
+	atomic_size_t *cntConsumed;
+	size_t cntTotal;
+} BenchMpmcThread;
+
+static double __bench_mpmc_now()
+{
+	struct timespec now;
+	timespec_get(&now, TIME_UTC);
+	return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+}
+
+static void* __bench_mpmc_producer(void* _thread)
+{
+	BenchMpmcThread* thread = _thread;
+	unsigned char record[BENCH_MPMC_RECORD_SIZE];
+	memset(&record[0], 'R', sizeof(record));
+
+	for (size_t curRecord = 0; curRecord < thread->cntRecords; curRecord++)
+	{
+		size_t cntBytes = 16 + (curRecord % (BENCH_MPMC_RECORD_SIZE - 16));
+		while (!byte_mpmc_queue_push(thread->queue, &record[0], cntBytes))
+		{
+			sched_yield();
+		}
+	}
+
+	return NULL;
+}
+
+static void* __bench_mpmc_consumer(void* _thread)
+{
+	BenchMpmcThread* thread = _thread;
+	ByteMpmcReservation reservation;
+	size_t checksum = 0;
+
+	while (atomic_load_explicit(thread->cntConsumed, memory_order_relaxed) < thread->cntTotal)
+	{
+		const unsigned char *data = byte_mpmc_queue_acquire(thread->queue, &reservation);
+		if (!data)
+		{
+			sched_yield();
+			continue;
+		}
+
+		checksum += data[reservation.length - 1];
+
+		byte_mpmc_queue_release(thread->queue, &reservation);
+		atomic_fetch_add_explicit(thread->cntConsumed, 1, memory_order_relaxed);
+	}
+
+	thread->cntRecords = checksum;
+
+	return NULL;
+}
+
+//cntThreads producers and cntThreads consumers move BENCH_MPMC_RECORDS records
+static double __bench_mpmc_run(size_t cntThreads)
+{
+	ByteMpmcQueue *queue = byte_mpmc_queue_new(4096, BENCH_MPMC_RECORD_SIZE);
+	atomic_size_t cntConsumed;
+	atomic_init(&cntConsumed, 0);
+
+	pthread_t producers[BENCH_MPMC_MAX_THREADS];
+	pthread_t consumers[BENCH_MPMC_MAX_THREADS];
+	BenchMpmcThread producerData[BENCH_MPMC_MAX_THREADS];
+	BenchMpmcThread consumerData[BENCH_MPMC_MAX_THREADS];
+
+	size_t cntPerProducer = BENCH_MPMC_RECORDS / cntThreads;
+	size_t cntTotal = cntPerProducer * cntThreads;
+
+	double start = __bench_mpmc_now();
+
+	for (size_t curThread = 0; curThread < cntThreads; curThread++)
+	{
+		producerData[curThread] = (BenchMpmcThread){ queue, cntPerProducer, &cntConsumed, cntTotal };
+		consumerData[curThread] = (BenchMpmcThread){ queue, 0, &cntConsumed, cntTotal };
+
+		pthread_create(&producers[curThread], NULL, __bench_mpmc_producer, &producerData[curThread]);
+		pthread_create(&consumers[curThread], NULL, __bench_mpmc_consumer, &consumerData[curThread]);
+	}
+
+	for (size_t curThread = 0; curThread < cntThreads; curThread++)
+	{
+		pthread_join(producers[curThread], NULL);
+		pthread_join(consumers[curThread], NULL);
+	}
+
+	double elapsed = __bench_mpmc_now() - start;
+
+	byte_mpmc_queue_free(&queue);
+
+	return (double)cntTotal / elapsed / 1e6;
+}
+
+static void bench_mpmc_scaling()
+{
+	printf("mpmc queue %d byte records, producers = consumers [Mrecords/s]\n", BENCH_MPMC_RECORD_SIZE);
+	printf("%8s %12s %8s\n", "threads", "rate", "scale");
+
+	double baseRate = 0.;
+
+	for (size_t cntThreads = 1; cntThreads <= BENCH_MPMC_MAX_THREADS; cntThreads *= 2)
+	{
+		double rate = __bench_mpmc_run(cntThreads);
+		if (cntThreads == 1) baseRate = rate;
+
+		printf("%8zu %12.2f %8.2f\n", cntThreads, rate, rate / baseRate);
+	}
+}
+
+int main(int argc, char **argv) {
+	UNUSED(argc);
+	UNUSED(argv);
+
+	bench_mpmc_scaling();
+
+	return 0;
+}
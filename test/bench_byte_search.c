@@ -0,0 +1,144 @@
+#define _GNU_SOURCE
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "defs.h"
+#include "cpu_utils.h"
+#include "byte_search.h"
+#include "test_utils.h"
+
+#define BENCH_SEARCH_SIZE (8 * 1024 * 1024)
+#define BENCH_SEARCH_ROUNDS 40
+
+typedef enum
+{
+	BENCH_SEARCH_BYTE,
+	BENCH_SEARCH_RBYTE,
+	BENCH_SEARCH_ANY,
+	BENCH_SEARCH_BYTES,
+	BENCH_SEARCH_RBYTES
+} BenchSearchKind;
+
+static const char* benchSearchNames[] = { "find_byte", "rfind_byte", "find_any_of", "find_bytes", "rfind_bytes" };
+
+static unsigned char benchNeedle[] = "needle!";
+static unsigned char benchSet[] = "\r\n\t;|";
+static unsigned char benchReverseNeedle[8];    //start of the data, the reverse search has to pass everything
+
+static double __bench_search_now()
+{
+	struct timespec now;
+	timespec_get(&now, TIME_UTC);
+	return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+}
+
+static size_t __bench_search_libc(BenchSearchKind kind, const unsigned char* data)
+{
+	const unsigned char* found = NULL;
+
+	switch(kind)
+	{
+		case BENCH_SEARCH_BYTE:   found = memchr(data, '!', BENCH_SEARCH_SIZE); break;
+		case BENCH_SEARCH_RBYTE:  found = memrchr(data, '#', BENCH_SEARCH_SIZE); break;
+		case BENCH_SEARCH_ANY:    found = data + strcspn((const char*)data, (const char*)benchSet); break;
+		case BENCH_SEARCH_BYTES:  found = memmem(data, BENCH_SEARCH_SIZE, benchNeedle, sizeof(benchNeedle) - 1); break;
+		case BENCH_SEARCH_RBYTES: return BYTE_SEARCH_NOT_FOUND;
+	}
+
+	return ( found ? (size_t)(found - data) : BYTE_SEARCH_NOT_FOUND );
+}
+
+static size_t __bench_search_own(BenchSearchKind kind, const unsigned char* data)
+{
+	ByteView view = byte_view_of(data, BENCH_SEARCH_SIZE);
+
+	switch(kind)
+	{
+		case BENCH_SEARCH_BYTE:   return byte_view_find_byte(view, '!');
+		case BENCH_SEARCH_RBYTE:  return byte_view_rfind_byte(view, '#');
+		case BENCH_SEARCH_ANY:    return byte_view_find_any_of(view, byte_view_of(benchSet, sizeof(benchSet) - 1));
+		case BENCH_SEARCH_BYTES:  return byte_view_find_bytes(view, byte_view_of(benchNeedle, sizeof(benchNeedle) - 1));
+		case BENCH_SEARCH_RBYTES: return byte_view_rfind_bytes(view, byte_view_of(benchReverseNeedle, sizeof(benchReverseNeedle)));
+	}
+
+	return BYTE_SEARCH_NOT_FOUND;
+}
+
+//GB per second of the own search with disabledFeatures or of the libc counterpart
+static double __bench_search_rate(BenchSearchKind kind, const unsigned char* data, unsigned disabledFeatures, bool libc, size_t expected)
+{
+	cpu_features_disable(disabledFeatures);
+
+	double start = __bench_search_now();
+
+	for (size_t curRound = 0; curRound < BENCH_SEARCH_ROUNDS; curRound++)
+	{
+		size_t found = ( libc ? __bench_search_libc(kind, data) : __bench_search_own(kind, data) );
+
+		if (found != expected)
+		{
+			printf("%s returned %zu instead of %zu\n", benchSearchNames[kind], found, expected);
+			exit(1);
+		}
+	}
+
+	double elapsed = __bench_search_now() - start;
+
+	cpu_features_disable(0);
+
+	return (double)BENCH_SEARCH_SIZE * BENCH_SEARCH_ROUNDS / elapsed / 1e9;
+}
+
+static void bench_search()
+{
+	//text without the searched bytes, hits are placed at the far end of each direction
+	unsigned char* data = malloc(BENCH_SEARCH_SIZE + 1);
+	uint64_t state = TEST_RANDOM_SEED;
+	for (size_t curByte = 0; curByte < BENCH_SEARCH_SIZE; curByte++)
+	{
+		data[curByte] = (unsigned char)('a' + test_random_next(&state) % 26);
+	}
+	data[BENCH_SEARCH_SIZE] = '\0';
+
+	size_t needlePos = BENCH_SEARCH_SIZE - sizeof(benchNeedle);
+	memcpy(data + needlePos, benchNeedle, sizeof(benchNeedle) - 1);
+	data[0] = '#';
+	data[BENCH_SEARCH_SIZE - 1] = '\n';
+	memcpy(benchReverseNeedle, data, sizeof(benchReverseNeedle));
+
+	size_t expected[] = { needlePos + 6, 0, BENCH_SEARCH_SIZE - 1, needlePos, 0 };
+
+	printf("search %d MiB [GB/s], cpu avx2: %d\n", BENCH_SEARCH_SIZE / (1024 * 1024), cpu_has_feature(CPU_FEATURE_AVX2));
+	printf("%12s %10s %10s %10s %10s\n", "", "scalar", "sse", "avx2", "libc");
+
+	for (int kind = BENCH_SEARCH_BYTE; kind <= BENCH_SEARCH_RBYTES; kind++)
+	{
+		double scalarRate = __bench_search_rate(kind, data, ~0U, false, expected[kind]);
+		double sseRate = __bench_search_rate(kind, data, CPU_FEATURE_AVX2, false, expected[kind]);
+		double avx2Rate = __bench_search_rate(kind, data, 0, false, expected[kind]);
+
+		//no memrmem in libc
+		if (kind == BENCH_SEARCH_RBYTES)
+		{
+			printf("%12s %10.2f %10.2f %10.2f %10s\n", benchSearchNames[kind], scalarRate, sseRate, avx2Rate, "-");
+			continue;
+		}
+
+		double libcRate = __bench_search_rate(kind, data, 0, true, expected[kind]);
+
+		printf("%12s %10.2f %10.2f %10.2f %10.2f\n", benchSearchNames[kind], scalarRate, sseRate, avx2Rate, libcRate);
+	}
+
+	free(data);
+}
+
+int main(int argc, char **argv) {
+	UNUSED(argc);
+	UNUSED(argv);
+
+	bench_search();
+
+	return 0;
+}
\ No newline at end of file
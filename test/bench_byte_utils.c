@@ -0,0 +1,82 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "defs.h"
+#include "byte_utils.h"
+
+#define BENCH_BUFFER_SIZE (64 * 1024)
+#define BENCH_TOTAL_BYTES ((size_t)512 * 1024 * 1024)
+
+static double __bench_bb_now()
+{
+	struct timespec now;
+	timespec_get(&now, TIME_UTC);
+	return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+}
+
+//appends chunks until totalBytes are written. TRUNCATE restarts at 0 like a ring would do.
+static double __bench_bb_append(ByteBufferMode mode, unsigned char* chunk, size_t chunkSize, size_t totalBytes)
+{
+	ByteBuffer *buffer = byte_buffer_new(mode, BENCH_BUFFER_SIZE);
+	byte_buffer_clear(buffer);
+
+	size_t cntAppends = totalBytes / chunkSize;
+
+	double start = __bench_bb_now();
+
+	for (size_t curAppend = 0; curAppend < cntAppends; curAppend++)
+	{
+		if (mode == BYTE_BUFFER_TRUNCATE && buffer->offset + chunkSize > buffer->size)
+		{
+			buffer->offset = 0;
+		}
+
+		byte_buffer_append_bytes(buffer, chunk, chunkSize);
+	}
+
+	double elapsed = __bench_bb_now() - start;
+
+	//keeps the compiler from dropping the appends
+	volatile unsigned char sink = buffer->buffer[buffer->offset % buffer->size];
+	UNUSED(sink);
+
+	byte_buffer_free(&buffer);
+
+	return (double)(cntAppends * chunkSize) / elapsed / (1024. * 1024.);
+}
+
+static void bench_bb_append_ring()
+{
+	size_t chunkSizes[] = { 1, 7, 16, 64, 256, 1500, 4096, 100000 };
+	size_t cntChunkSizes = sizeof(chunkSizes) / sizeof(chunkSizes[0]);
+
+	unsigned char* chunk = malloc(100000);
+	memset(chunk, 'A', 100000);
+
+	printf("append_bytes %d KiB buffer [MiB/s]\n", BENCH_BUFFER_SIZE / 1024);
+	printf("%10s %12s %12s %8s\n", "chunk", "TRUNCATE", "RING", "ratio");
+
+	for (size_t curSize = 0; curSize < cntChunkSizes; curSize++)
+	{
+		size_t chunkSize = chunkSizes[curSize];
+		size_t totalBytes = ( chunkSize < 16 ? BENCH_TOTAL_BYTES / 8 : BENCH_TOTAL_BYTES );
+
+		double truncRate = __bench_bb_append(BYTE_BUFFER_TRUNCATE, chunk, chunkSize, totalBytes);
+		double ringRate = __bench_bb_append(BYTE_BUFFER_RING, chunk, chunkSize, totalBytes);
+
+		printf("%10zu %12.1f %12.1f %8.2f\n", chunkSize, truncRate, ringRate, ringRate / truncRate);
+	}
+
+	free(chunk);
+}
+
+int main(int argc, char **argv) {
+	UNUSED(argc);
+	UNUSED(argv);
+
+	bench_bb_append_ring();
+
+	return 0;
+}
@@ -0,0 +1,96 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "defs.h"
+#include "cpu_utils.h"
+#include "byte_varint.h"
+#include "test_utils.h"
+
+#define BENCH_VARINT_VALUES (1024 * 1024)
+#define BENCH_VARINT_ROUNDS 50
+
+static double __bench_varint_now()
+{
+	struct timespec now;
+	timespec_get(&now, TIME_UTC);
+	return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+}
+
+//values below maxBits bits, so maxBits 7 gives only single byte varints
+static ByteBuffer* __bench_varint_encode(unsigned maxBits)
+{
+	ByteBuffer *encoded = byte_buffer_new(BYTE_BUFFER_GROW, 16);
+	byte_buffer_clear(encoded);
+
+	uint64_t state = TEST_RANDOM_SEED;
+	for (size_t curValue = 0; curValue < BENCH_VARINT_VALUES; curValue++)
+	{
+		uint64_t random = test_random_next(&state);
+		byte_buffer_put_uvarint(encoded, (random >> (64 - maxBits)) >> (random % maxBits));
+	}
+
+	return encoded;
+}
+
+//million values per second
+static double __bench_varint_decode(ByteBuffer* encoded, uint64_t* values, unsigned disabledFeatures)
+{
+	cpu_features_disable(disabledFeatures);
+
+	size_t consumed = 0;
+	size_t cntDecoded = 0;
+
+	double start = __bench_varint_now();
+
+	for (size_t curRound = 0; curRound < BENCH_VARINT_ROUNDS; curRound++)
+	{
+		cntDecoded += byte_varint_decode_bulk(encoded->buffer, encoded->offset, values, BENCH_VARINT_VALUES, &consumed);
+	}
+
+	double elapsed = __bench_varint_now() - start;
+
+	cpu_features_disable(0);
+
+	if (cntDecoded != (size_t)BENCH_VARINT_VALUES * BENCH_VARINT_ROUNDS)
+	{
+		printf("decode failed\n");
+		exit(1);
+	}
+
+	return (double)cntDecoded / elapsed / 1e6;
+}
+
+static void bench_varint_bulk()
+{
+	unsigned maxBits[] = { 7, 14, 28, 64 };
+	uint64_t* values = malloc(BENCH_VARINT_VALUES * sizeof(uint64_t));
+
+	printf("bulk decode %d varints [Mvalues/s], cpu avx2: %d\n", BENCH_VARINT_VALUES, cpu_has_feature(CPU_FEATURE_AVX2));
+	printf("%8s %10s %10s %10s\n", "maxBits", "scalar", "sse2", "avx2");
+
+	for (size_t curBits = 0; curBits < sizeof(maxBits) / sizeof(maxBits[0]); curBits++)
+	{
+		ByteBuffer *encoded = __bench_varint_encode(maxBits[curBits]);
+
+		double scalarRate = __bench_varint_decode(encoded, values, ~0U);
+		double sse2Rate = __bench_varint_decode(encoded, values, CPU_FEATURE_AVX2);
+		double avx2Rate = __bench_varint_decode(encoded, values, 0);
+
+		printf("%8u %10.1f %10.1f %10.1f\n", maxBits[curBits], scalarRate, sse2Rate, avx2Rate);
+
+		byte_buffer_free(&encoded);
+	}
+
+	free(values);
+}
+
+int main(int argc, char **argv) {
+	UNUSED(argc);
+	UNUSED(argv);
+
+	bench_varint_bulk();
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,241 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "defs.h"
+#include "arena_utils.h"
+#include "string_utils.h"
+#include "file_path_utils.h"
+#include "byte_utils.h"
+
+static void test_arena_alloc()
+{
+	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
+
+	MemArena *arena = mem_arena_new(256);
+
+	assert(arena->chunkSize == 256);
+	assert(mem_arena_used(arena) == 0);
+
+	unsigned char *first = mem_arena_alloc(arena, 3);
+	unsigned char *second = mem_arena_alloc(arena, 8);
+
+	assert(first != NULL && second != NULL);
+	assert(((uintptr_t)first % MEM_ARENA_DEFAULT_ALIGN) == 0);
+	assert(((uintptr_t)second % MEM_ARENA_DEFAULT_ALIGN) == 0);
+	assert(second >= first + 3);
+	assert(mem_arena_used(arena) == 11);
+
+	unsigned char *aligned = mem_arena_alloc_aligned(arena, 10, 64);
+	assert(((uintptr_t)aligned % 64) == 0);
+
+	unsigned char *packed = mem_arena_alloc_aligned(arena, 1, 1);
+	unsigned char *packedNext = mem_arena_alloc_aligned(arena, 1, 1);
+	assert(packedNext == packed + 1);
+
+	assert(mem_arena_alloc_aligned(arena, 1, 3) == NULL);
+
+	//sizes overflowing the chunk size fail
+	size_t usedBefore = mem_arena_used(arena);
+	assert(mem_arena_alloc(arena, SIZE_MAX - 8) == NULL);
+	assert(mem_arena_alloc(arena, SIZE_MAX) == NULL);
+	assert(mem_arena_alloc_aligned(arena, SIZE_MAX - 8, 64) == NULL);
+	assert(mem_arena_used(arena) == usedBefore);
+
+	//more than fits into one chunk, next chunk is taken
+	for (int cnt = 0; cnt < 100; ++cnt)
+	{
+		unsigned char *part = mem_arena_alloc(arena, 32);
+		assert(part != NULL);
+		memset(part, cnt, 32);
+	}
+
+	//larger than the chunk size gets an own chunk
+	unsigned char *large = mem_arena_alloc(arena, 4096);
+	assert(large != NULL);
+	memset(large, 0xAB, 4096);
+
+	mem_arena_reset(arena);
+	assert(mem_arena_used(arena) == 0);
+
+	//chunks are reused after reset
+	unsigned char *again = mem_arena_alloc(arena, 3);
+	assert(again == first);
+
+	mem_arena_free(&arena);
+	assert(arena == NULL);
+
+	MemArena stackArena;
+	mem_arena_init(&stackArena, 0);
+	assert(stackArena.chunkSize == MEM_ARENA_DEFAULT_CHUNK_SIZE);
+	assert(mem_arena_alloc(&stackArena, 100) != NULL);
+	mem_arena_free(&(MemArena *){&stackArena});
+	assert(stackArena.first == NULL);
+
+	DEBUG_LOG("<<<\n");
+}
+
+static void test_arena_strings()
+{
+	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
+
+	MemArena *arena = mem_arena_new(64);
+
+	char *copy = copy_string_arena(arena, "arena string");
+	assert(strcmp(copy, "arena string") == 0);
+
+	char *formatted = format_string_arena(arena, "%s-%d", "value", 42);
+	assert(strcmp(formatted, "value-42") == 0);
+
+	char longText[600];
+	memset(longText, 'x', sizeof(longText) - 1);
+	longText[sizeof(longText) - 1] = '\0';
+
+	char *longFormatted = format_string_arena(arena, "<%s>", longText);
+	assert(strlen(longFormatted) == 601);
+	assert(longFormatted[0] == '<' && longFormatted[600] == '>');
+
+	const char *fullPath = "/home/user/data/file.tar.gz";
+
+	char *path = path_from_full_filepath_arena(arena, fullPath);
+	assert(strcmp(path, "/home/user/data/") == 0);
+
+	char *file = file_from_full_filepath_arena(arena, fullPath);
+	assert(strcmp(file, "file.tar.gz") == 0);
+
+	char *type = type_from_filename_arena(arena, file);
+	assert(strcmp(type, "gz") == 0);
+
+	char *name = name_from_filename_arena(arena, fullPath);
+	assert(strcmp(name, "file.tar") == 0);
+
+	assert(path_from_full_filepath_arena(arena, "nopath") == NULL);
+	assert(file_from_full_filepath_arena(arena, "/dir/") == NULL);
+
+	//heap variants still behave the same
+	char *heapPath = path_from_full_filepath(fullPath);
+	char *heapName = name_from_filename(fullPath);
+	assert(strcmp(heapPath, path) == 0);
+	assert(strcmp(heapName, name) == 0);
+	free(heapPath);
+	free(heapName);
+
+	mem_arena_reset(arena);
+	mem_arena_free(&arena);
+
+	DEBUG_LOG("<<<\n");
+}
+
+static size_t testCntGlobalAllocs = 0;
+
+static void* __test_arena_counting_alloc(void* ctx, size_t size)
+{
+	(void)ctx;
+	testCntGlobalAllocs++;
+	return malloc(size);
+}
+
+static size_t testCntGlobalFrees = 0;
+
+static void __test_arena_counting_free(void* ctx, void* ptr)
+{
+	(void)ctx;
+	if (ptr) testCntGlobalFrees++;
+	free(ptr);
+}
+
+static void test_global_allocator_strings()
+{
+	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
+
+	const MemAllocator *defaultAllocator = mem_allocator_default();
+	MemAllocator counting = *defaultAllocator;
+	counting.alloc = __test_arena_counting_alloc;
+	counting.free = __test_arena_counting_free;
+	mem_allocator_set(&counting);
+
+	char *copy = copy_string("global");
+	char *formatted = format_string_new("%d", 7);
+	char *name = name_from_filename("/tmp/name.txt");
+
+	assert(testCntGlobalAllocs == 3);
+	assert(strcmp(name, "name") == 0);
+
+	//arena object and chunks come from the global allocator too
+	MemArena *arena = mem_arena_new(64);
+	assert(mem_arena_alloc(arena, 200) != NULL);
+
+	assert(testCntGlobalAllocs == 5);
+
+	mem_free(copy);
+	mem_free(formatted);
+	mem_free(name);
+
+	mem_allocator_set(NULL);
+
+	//the arena keeps its allocator, chunks and object go back to it
+	mem_arena_reset(arena);
+	assert(mem_arena_alloc(arena, 300) != NULL);
+	mem_arena_free(&arena);
+
+	assert(testCntGlobalAllocs == 6);
+	assert(testCntGlobalFrees == 6);
+
+	DEBUG_LOG("<<<\n");
+}
+
+static void test_arena_buffers()
+{
+	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
+
+	MemArena *arena = mem_arena_new(0);
+
+	ByteBuffer *buffer = byte_buffer_new_arena(BYTE_BUFFER_TRUNCATE, 16, arena);
+	assert(buffer != NULL);
+	assert(buffer->size == 16);
+	assert(!buffer->alloc && !buffer->allocObj);
+
+	byte_buffer_append_bytes(buffer, (unsigned char *)"ARENA", 5);
+	assert(memcmp(buffer->buffer, "ARENA", 5) == 0);
+
+	//growing leaves the arena storage
+	ByteBuffer grow;
+	byte_buffer_init_new_arena(&grow, BYTE_BUFFER_GROW, 4, arena);
+	unsigned char *arenaStorage = grow.buffer;
+	assert(grow.size == 4);
+
+	byte_buffer_append_bytes(&grow, (unsigned char *)"0123456789", 10);
+	assert(grow.buffer != arenaStorage);
+	assert(grow.alloc);
+	assert(memcmp(grow.buffer, "0123456789", 10) == 0);
+	byte_buffer_free(&(ByteBuffer *){&grow});
+
+	//free releases nothing of the arena
+	byte_buffer_free(&buffer);
+	assert(buffer != NULL);
+
+	mem_arena_reset(arena);
+	mem_arena_free(&arena);
+
+	DEBUG_LOG("<<<\n");
+}
+
+int main(int argc, char **argv) {
+	UNUSED(argc);
+	UNUSED(argv);
+	DEBUG_LOG(">> start arena utils test:\n");
+
+	test_arena_alloc();
+
+	test_arena_strings();
+
+	test_global_allocator_strings();
+
+	test_arena_buffers();
+
+	DEBUG_LOG("<< end arena utils test:\n");
+
+	return 0;
+}
\ No newline at end of file
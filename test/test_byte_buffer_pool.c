@@ -0,0 +1,262 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "defs.h"
+#include "byte_buffer_pool.h"
+
+#define TEST_POOL_THREADS 4
+#define TEST_POOL_ROUNDS 20000
+#define TEST_POOL_HANDOVER 1000
+
+static void test_pool_classes()
+{
+	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
+
+	ByteBufferPool *pool = byte_buffer_pool_new();
+	ByteBufferPoolStats stats;
+
+	ByteBuffer *buffer = byte_buffer_new_pooled(pool, BYTE_BUFFER_TRUNCATE, 100);
+
+	assert(buffer->size == 100);
+	assert(buffer->offset == 0);
+	assert(buffer->mode == BYTE_BUFFER_TRUNCATE);
+
+	byte_buffer_append_bytes(buffer, (unsigned char *)"POOLED", 6);
+	assert(memcmp(buffer->buffer, "POOLED", 6) == 0);
+
+	unsigned char *storage = buffer->buffer;
+
+	byte_buffer_free_pooled(&buffer);
+	assert(buffer == NULL);
+
+	//same size class is served from the cache
+	buffer = byte_buffer_new_pooled(pool, BYTE_BUFFER_RING, 120);
+
+	assert(buffer->buffer == storage);
+	assert(buffer->size == 120);
+	assert(buffer->mode == BYTE_BUFFER_RING);
+
+	byte_buffer_pool_stats(pool, &stats);
+	assert(stats.hits == 1);
+	assert(stats.misses == 1);
+	assert(stats.inUse == 128);
+	assert(stats.highWater == 128);
+
+	//other class
+	ByteBuffer *other = byte_buffer_new_pooled(pool, BYTE_BUFFER_TRUNCATE, 129);
+	assert(other->buffer != storage);
+
+	byte_buffer_pool_stats(pool, &stats);
+	assert(stats.misses == 2);
+	assert(stats.highWater == 128 + 256);
+
+	byte_buffer_free_pooled(&other);
+	byte_buffer_free_pooled(&buffer);
+
+	//larger than the largest class is not pooled
+	ByteBuffer *large = byte_buffer_new_pooled(pool, BYTE_BUFFER_TRUNCATE, 3 * 1024 * 1024);
+	byte_buffer_fill_complete(large, 'L');
+	byte_buffer_free_pooled(&large);
+
+	large = byte_buffer_new_pooled(pool, BYTE_BUFFER_TRUNCATE, 3 * 1024 * 1024);
+	byte_buffer_free_pooled(&large);
+
+	byte_buffer_pool_stats(pool, &stats);
+	assert(stats.misses == 4);
+	assert(stats.inUse == 0);
+
+	//growing moves into own memory, the block is reused anyway
+	ByteBuffer *grow = byte_buffer_new_pooled(pool, BYTE_BUFFER_GROW, 64);
+	for (size_t curByte = 0; curByte < 200; curByte++)
+	{
+		byte_buffer_append_byte(grow, 'G');
+	}
+
+	assert(grow->offset == 200);
+	assert(grow->alloc);
+	byte_buffer_free_pooled(&grow);
+
+	grow = byte_buffer_new_pooled(pool, BYTE_BUFFER_GROW, 64);
+	byte_buffer_pool_stats(pool, &stats);
+	assert(stats.misses == 5);
+	assert(stats.hits == 2);
+	byte_buffer_free_pooled(&grow);
+
+	//clones keep their content after the block is reused
+	ByteBuffer *original = byte_buffer_new_pooled(pool, BYTE_BUFFER_TRUNCATE, 16);
+	byte_buffer_append_bytes(original, (unsigned char *)"ORIGINAL", 8);
+	unsigned char *originalStorage = original->buffer;
+
+	ByteBuffer *clone = byte_buffer_clone(original);
+	assert(clone->buffer != originalStorage);
+	assert(clone->alloc && clone->shared == NULL);
+	assert(clone->offset == 8 && clone->size == 16);
+
+	byte_buffer_free_pooled(&original);
+
+	ByteBuffer *reused = byte_buffer_new_pooled(pool, BYTE_BUFFER_TRUNCATE, 16);
+	assert(reused->buffer == originalStorage);
+	byte_buffer_append_bytes(reused, (unsigned char *)"REUSED!!", 8);
+
+	assert(memcmp(clone->buffer, "ORIGINAL", 8) == 0);
+
+	byte_buffer_free_pooled(&reused);
+	byte_buffer_free(&clone);
+
+	byte_buffer_pool_free(&pool);
+	assert(pool == NULL);
+
+	DEBUG_LOG("<<<\n");
+}
+
+typedef struct 
+{
+	ByteBufferPool *pool;
+	size_t seed;
+	ByteBuffer *handover[TEST_POOL_HANDOVER];
+} TestPoolThread;
+
+static void* __test_pool_worker(void* _thread)
+{
+	TestPoolThread *thread = _thread;
+	size_t state = thread->seed;
+
+	for (size_t curRound = 0; curRound < TEST_POOL_ROUNDS; curRound++)
+	{
+		state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+		size_t size = 1 + (state >> 33) % 8192;
+
+		ByteBuffer *buffer = byte_buffer_new_pooled(thread->pool, BYTE_BUFFER_TRUNCATE, size);
+		assert(buffer && buffer->size == size);
+
+		byte_buffer_fill_complete(buffer, (unsigned char)size);
+		assert(buffer->buffer[size - 1] == (unsigned char)size);
+
+		byte_buffer_free_pooled(&buffer);
+	}
+
+	//allocated here, freed by the main thread
+	for (size_t curBuffer = 0; curBuffer < TEST_POOL_HANDOVER; curBuffer++)
+	{
+		thread->handover[curBuffer] = byte_buffer_new_pooled(thread->pool, BYTE_BUFFER_TRUNCATE, 64 + curBuffer);
+	}
+
+	return NULL;
+}
+
+static size_t testCntAllocs = 0;
+static size_t testCntFrees = 0;
+
+static void* __test_pool_counting_alloc(void* ctx, size_t size)
+{
+	(void)ctx;
+	testCntAllocs++;
+	return malloc(size);
+}
+
+static void __test_pool_counting_free(void* ctx, void* ptr)
+{
+	(void)ctx;
+	if (ptr) testCntFrees++;
+	free(ptr);
+}
+
+static void test_pool_allocator()
+{
+	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
+
+	MemAllocator counting = *mem_allocator_default();
+	counting.alloc = __test_pool_counting_alloc;
+	counting.free = __test_pool_counting_free;
+	mem_allocator_set(&counting);
+
+	ByteBufferPool *pool = byte_buffer_pool_new();
+	ByteBuffer *buffer = byte_buffer_new_pooled(pool, BYTE_BUFFER_TRUNCATE, 100);
+	assert(pool->allocator == &counting);
+	assert(testCntAllocs == 3);
+
+	mem_allocator_set(NULL);
+
+	//blocks, caches and object keep coming from and going back to the allocator of the pool
+	ByteBuffer *other = byte_buffer_new_pooled(pool, BYTE_BUFFER_TRUNCATE, 200);
+	assert(testCntAllocs == 4);
+
+	byte_buffer_free_pooled(&other);
+	byte_buffer_free_pooled(&buffer);
+	byte_buffer_pool_free(&pool);
+
+	assert(testCntFrees == 4);
+
+	DEBUG_LOG("<<<\n");
+}
+
+static void test_pool_threads()
+{
+	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
+
+	ByteBufferPool pool;
+	assert(byte_buffer_pool_init(&pool));
+
+	pthread_t threads[TEST_POOL_THREADS];
+	TestPoolThread *threadData = calloc(TEST_POOL_THREADS, sizeof(TestPoolThread));
+
+	for (size_t curThread = 0; curThread < TEST_POOL_THREADS; curThread++)
+	{
+		threadData[curThread].pool = &pool;
+		threadData[curThread].seed = curThread + 1;
+		pthread_create(&threads[curThread], NULL, __test_pool_worker, &threadData[curThread]);
+	}
+
+	for (size_t curThread = 0; curThread < TEST_POOL_THREADS; curThread++)
+	{
+		pthread_join(threads[curThread], NULL);
+	}
+
+	for (size_t curThread = 0; curThread < TEST_POOL_THREADS; curThread++)
+	{
+		for (size_t curBuffer = 0; curBuffer < TEST_POOL_HANDOVER; curBuffer++)
+		{
+			byte_buffer_free_pooled(&threadData[curThread].handover[curBuffer]);
+		}
+	}
+
+	ByteBufferPoolStats stats;
+	byte_buffer_pool_stats(&pool, &stats);
+
+	assert(stats.hits + stats.misses == TEST_POOL_THREADS * (TEST_POOL_ROUNDS + TEST_POOL_HANDOVER));
+	assert(stats.hits > stats.misses);
+	assert(stats.inUse == 0);
+
+	//blocks of the ended threads went to the global list and are reused here
+	ByteBuffer *reused = byte_buffer_new_pooled(&pool, BYTE_BUFFER_TRUNCATE, 4000);
+	byte_buffer_free_pooled(&reused);
+
+	ByteBufferPoolStats after;
+	byte_buffer_pool_stats(&pool, &after);
+	assert(after.hits == stats.hits + 1);
+
+	ByteBufferPool *poolPtr = &pool;
+	byte_buffer_pool_free(&poolPtr);
+	free(threadData);
+
+	DEBUG_LOG("<<<\n");
+}
+
+int main(int argc, char **argv) {
+	UNUSED(argc);
+	UNUSED(argv);
+	DEBUG_LOG(">> start byte buffer pool test:\n");
+
+	test_pool_classes();
+
+	test_pool_allocator();
+
+	test_pool_threads();
+
+	DEBUG_LOG("<< end byte buffer pool test:\n");
+
+	return 0;
+}
\ No newline at end of file
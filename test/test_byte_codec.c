@@ -0,0 +1,269 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "defs.h"
+#include "cpu_utils.h"
+#include "byte_codec.h"
+#include "test_utils.h"
+
+#define TEST_CODEC_SIZE 1000
+
+static const unsigned __test_codec_disabled[] = { 0, CPU_FEATURE_AVX2, CPU_FEATURE_AVX2 | CPU_FEATURE_SSSE3, ~0U };
+
+static ByteView __test_codec_str(const char* str)
+{
+	return byte_view_of((const unsigned char*)str, strlen(str));
+}
+
+static bool __test_codec_base64_equals(const char* plain, const char* encoded)
+{
+	unsigned char result[64];
+	size_t cntDecoded = 0;
+
+	size_t cntEncoded = byte_base64_encode(result, __test_codec_str(plain));
+	if (!byte_view_equals(byte_view_of(result, cntEncoded), __test_codec_str(encoded))) return false;
+
+	if (!byte_base64_decode(result, __test_codec_str(encoded), &cntDecoded)) return false;
+
+	return byte_view_equals(byte_view_of(result, cntDecoded), __test_codec_str(plain));
+}
+
+static bool __test_codec_base64_invalid(const char* encoded)
+{
+	unsigned char result[256];
+	size_t cntDecoded = 0;
+
+	return !byte_base64_decode(result, __test_codec_str(encoded), &cntDecoded);
+}
+
+static void test_codec_vectors()
+{
+	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
+
+	for (size_t curMode = 0; curMode < sizeof(__test_codec_disabled) / sizeof(__test_codec_disabled[0]); curMode++)
+	{
+		cpu_features_disable(__test_codec_disabled[curMode]);
+
+		//RFC 4648
+		assert(__test_codec_base64_equals("", ""));
+		assert(__test_codec_base64_equals("f", "Zg=="));
+		assert(__test_codec_base64_equals("fo", "Zm8="));
+		assert(__test_codec_base64_equals("foo", "Zm9v"));
+		assert(__test_codec_base64_equals("foob", "Zm9vYg=="));
+		assert(__test_codec_base64_equals("fooba", "Zm9vYmE="));
+		assert(__test_codec_base64_equals("foobar", "Zm9vYmFy"));
+		assert(__test_codec_base64_equals("The quick brown fox jumps over the lazy dog",
+		                                  "VGhlIHF1aWNrIGJyb3duIGZveCBqdW1wcyBvdmVyIHRoZSBsYXp5IGRvZw=="));
+
+		unsigned char result[64];
+		size_t cntDecoded = 0;
+		assert(byte_hex_encode(result, __test_codec_str("foobar")) == 12);
+		assert(memcmp(result, "666f6f626172", 12) == 0);
+		assert(byte_hex_decode(result, __test_codec_str("DEADbeef"), &cntDecoded));
+		assert(cntDecoded == 4 && memcmp(result, "\xDE\xAD\xBE\xEF", 4) == 0);
+	}
+
+	cpu_features_disable(0);
+
+	DEBUG_LOG("<<<\n");
+}
+
+static void test_codec_round_trip()
+{
+	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
+
+	unsigned char *data = malloc(TEST_CODEC_SIZE);
+	unsigned char *encoded = malloc(byte_hex_encoded_size(TEST_CODEC_SIZE));
+	unsigned char *decoded = malloc(TEST_CODEC_SIZE);
+	unsigned char *reference = malloc(byte_hex_encoded_size(TEST_CODEC_SIZE));
+	test_random_fill(data, TEST_CODEC_SIZE);
+
+	//the scalar results are the reference for the kernels
+	for (size_t cntBytes = 0; cntBytes <= TEST_CODEC_SIZE; cntBytes += ( cntBytes < 200 ? 1 : 37 ))
+	{
+		ByteView src = byte_view_of(data, cntBytes);
+
+		cpu_features_disable(~0U);
+		size_t cntBase64 = byte_base64_encode(reference, src);
+		assert(cntBase64 == byte_base64_encoded_size(cntBytes));
+
+		for (size_t curMode = 0; curMode < sizeof(__test_codec_disabled) / sizeof(__test_codec_disabled[0]); curMode++)
+		{
+			cpu_features_disable(__test_codec_disabled[curMode]);
+			size_t cntDecoded = 0;
+
+			assert(byte_base64_encode(encoded, src) == cntBase64);
+			assert(memcmp(encoded, reference, cntBase64) == 0);
+			assert(byte_base64_decode(decoded, byte_view_of(encoded, cntBase64), &cntDecoded));
+			assert(cntDecoded == cntBytes && memcmp(decoded, data, cntBytes) == 0);
+
+			assert(byte_hex_encode(encoded, src) == 2 * cntBytes);
+			assert(byte_hex_decode(decoded, byte_view_of(encoded, 2 * cntBytes), &cntDecoded));
+			assert(cntDecoded == cntBytes && memcmp(decoded, data, cntBytes) == 0);
+		}
+	}
+
+	cpu_features_disable(0);
+	free(data);
+	free(encoded);
+	free(decoded);
+	free(reference);
+
+	DEBUG_LOG("<<<\n");
+}
+
+static void test_codec_invalid()
+{
+	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
+
+	unsigned char data[96];
+	unsigned char encoded[384];
+	unsigned char decoded[128];
+	test_random_fill(data, sizeof(data));
+
+	for (size_t curMode = 0; curMode < sizeof(__test_codec_disabled) / sizeof(__test_codec_disabled[0]); curMode++)
+	{
+		cpu_features_disable(__test_codec_disabled[curMode]);
+
+		assert(__test_codec_base64_invalid("Zg="));
+		assert(__test_codec_base64_invalid("Zg=a"));
+		assert(__test_codec_base64_invalid("Z==="));
+		assert(__test_codec_base64_invalid("===="));
+		assert(__test_codec_base64_invalid("Zh=="));
+		assert(__test_codec_base64_invalid("Zm9="));
+		assert(__test_codec_base64_invalid("Zg==Zm9v"));
+		assert(__test_codec_base64_invalid("Zm9v\nYmFy"));
+		assert(__test_codec_base64_invalid("Zm9v-_Fy"));
+
+		//every position of a long input is checked, also inside of the kernel blocks
+		size_t cntEncoded = byte_base64_encode(encoded, byte_view_of(data, sizeof(data)));
+		size_t cntHex = byte_hex_encode(encoded + cntEncoded, byte_view_of(data, sizeof(data)));
+		for (size_t position = 0; position < cntEncoded; position++)
+		{
+			size_t cntDecoded = 0;
+			unsigned char saved = encoded[position];
+
+			encoded[position] = '*';
+			assert(!byte_base64_decode(decoded, byte_view_of(encoded, cntEncoded), &cntDecoded));
+			encoded[position] = 0x80 | saved;
+			assert(!byte_base64_decode(decoded, byte_view_of(encoded, cntEncoded), &cntDecoded));
+			encoded[position] = saved;
+		}
+
+		for (size_t position = 0; position < cntHex; position++)
+		{
+			size_t cntDecoded = 0;
+			unsigned char* hex = encoded + cntEncoded;
+			unsigned char saved = hex[position];
+
+			hex[position] = 'g';
+			assert(!byte_hex_decode(decoded, byte_view_of(hex, cntHex), &cntDecoded));
+			hex[position] = '0' - 1;
+			assert(!byte_hex_decode(decoded, byte_view_of(hex, cntHex), &cntDecoded));
+			hex[position] = saved;
+		}
+
+		size_t cntDecoded = 0;
+		assert(!byte_hex_decode(decoded, __test_codec_str("abc"), &cntDecoded));
+		assert(!byte_hex_decode(decoded, __test_codec_str("0x"), &cntDecoded));
+	}
+
+	cpu_features_disable(0);
+
+	DEBUG_LOG("<<<\n");
+}
+
+static void test_codec_buffer()
+{
+	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
+
+	unsigned char data[TEST_CODEC_SIZE];
+	test_random_fill(data, sizeof(data));
+
+	ByteBuffer *encoded = byte_buffer_new(BYTE_BUFFER_GROW, 8);
+	ByteBuffer *decoded = byte_buffer_new(BYTE_BUFFER_GROW, 8);
+	byte_buffer_clear(encoded);
+	byte_buffer_clear(decoded);
+
+	byte_buffer_append_bytes_fmt(encoded, "%s", "head:");
+	assert(byte_buffer_append_base64_encoded(encoded, byte_view_of(data, sizeof(data))));
+	assert(encoded->offset == 5 + byte_base64_encoded_size(sizeof(data)));
+
+	ByteView content = byte_view_suffix(byte_view_from_content(encoded), 5);
+	assert(byte_buffer_append_base64_decoded(decoded, content));
+	assert(byte_view_equals(byte_view_from_content(decoded), byte_view_of(data, sizeof(data))));
+
+	//invalid input leaves the buffer unchanged
+	assert(!byte_buffer_append_base64_decoded(decoded, __test_codec_str("Zm9")));
+	assert(!byte_buffer_append_hex_decoded(decoded, __test_codec_str("zz")));
+	assert(decoded->offset == sizeof(data));
+
+	byte_buffer_clear(encoded);
+	byte_buffer_clear(decoded);
+	assert(byte_buffer_append_hex_encoded(encoded, byte_view_of(data, 100)));
+	assert(byte_buffer_append_hex_decoded(decoded, byte_view_from_content(encoded)));
+	assert(byte_view_equals(byte_view_from_content(decoded), byte_view_of(data, 100)));
+
+	//the content of a growing buffer can be appended encoded to itself, even if growing moves it
+	ByteBuffer *self = byte_buffer_new(BYTE_BUFFER_GROW, 4);
+	byte_buffer_clear(self);
+	byte_buffer_append_bytes(self, (unsigned char *)"\x01\xAB", 2);
+	assert(byte_buffer_append_hex_encoded(self, byte_view_from_content(self)));
+	assert(self->offset == 6 && memcmp(self->buffer, "\x01\xAB" "01ab", 6) == 0);
+
+	assert(byte_buffer_append_base64_encoded(self, byte_view_suffix(byte_view_from_content(self), 2)));
+	assert(self->offset == 14 && memcmp(self->buffer + 6, "MDFhYg==", 8) == 0);
+
+	assert(byte_buffer_append_base64_decoded(self, byte_view_suffix(byte_view_from_content(self), 6)));
+	assert(self->offset == 18 && memcmp(self->buffer + 14, "01ab", 4) == 0);
+
+	//a source reaching into the free space is not overwritten by the result
+	byte_buffer_shrink_to_fit(self);
+	assert(byte_buffer_reserve(self, 64));
+	memcpy(self->buffer + self->offset, "cdef", 4);
+	assert(byte_buffer_append_hex_decoded(self, byte_view_of(self->buffer + 14, 8)));
+	assert(self->offset == 22 && memcmp(self->buffer + 18, "\x01\xAB\xCD\xEF", 4) == 0);
+
+	byte_buffer_free(&self);
+
+	//other modes apply their overflow handling to the whole result
+	ByteBuffer *skip = byte_buffer_new(BYTE_BUFFER_SKIP, 8);
+	byte_buffer_clear(skip);
+	assert(byte_buffer_append_base64_encoded(skip, __test_codec_str("foo")));
+	assert(byte_buffer_append_base64_encoded(skip, __test_codec_str("foobar")));
+	assert(skip->offset == 4 && memcmp(skip->buffer, "Zm9v", 4) == 0);
+
+	ByteBuffer *truncate = byte_buffer_new(BYTE_BUFFER_TRUNCATE, 1000);
+	byte_buffer_clear(truncate);
+	assert(byte_buffer_append_hex_encoded(truncate, byte_view_of(data, 600)));
+	assert(truncate->offset == 1000);
+	assert(memcmp(truncate->buffer, encoded->buffer, 200) == 0);
+
+	byte_buffer_free(&encoded);
+	byte_buffer_free(&decoded);
+	byte_buffer_free(&skip);
+	byte_buffer_free(&truncate);
+
+	DEBUG_LOG("<<<\n");
+}
+
+int main(int argc, char **argv) {
+	UNUSED(argc);
+	UNUSED(argv);
+	DEBUG_LOG(">> start byte codec test:\n");
+
+	test_codec_vectors();
+
+	test_codec_round_trip();
+
+	test_codec_invalid();
+
+	test_codec_buffer();
+
+	DEBUG_LOG("<< end byte codec test:\n");
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,208 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+
+#include "defs.h"
+#include "byte_format.h"
+#include "test_utils.h"
+
+#define TEST_FORMAT_RANDOM_DOUBLES 50000
+
+static void __test_format_expect(ByteBuffer* buffer, const char* expected)
+{
+	size_t expectedSize = strlen(expected);
+	assert(buffer->offset == expectedSize);
+	assert(memcmp(buffer->buffer, expected, expectedSize) == 0);
+	byte_buffer_clear(buffer);
+}
+
+//significant digits of a formatted double, without sign, exponent, leading and trailing zeros
+static size_t __test_format_count_digits(const char* formatted)
+{
+	size_t first = SIZE_MAX;
+	size_t last = 0;
+	size_t cntDigits = 0;
+
+	for (const char* cur = formatted; *cur && *cur != 'e'; cur++)
+	{
+		if (*cur < '0' || *cur > '9') continue;
+
+		if (*cur != '0')
+		{
+			if (first == SIZE_MAX) first = cntDigits;
+			last = cntDigits;
+		}
+		cntDigits++;
+	}
+
+	return ( first == SIZE_MAX ? 0 : last - first + 1 );
+}
+
+//fewest digits of a printf representation which reads back to value
+static size_t __test_format_shortest_printf(double value)
+{
+	char formatted[32];
+
+	for (int precision = 1; precision < 17; precision++)
+	{
+		snprintf(formatted, sizeof(formatted), "%.*g", precision, value);
+		if (strtod(formatted, NULL) == value) return (size_t)precision;
+	}
+
+	return 17;
+}
+
+//the formatted value reads back to value and has no more digits than needed
+static void __test_format_expect_shortest(ByteBuffer* buffer, double value)
+{
+	byte_buffer_clear(buffer);
+	byte_buffer_append_f64(buffer, value);
+	byte_buffer_append_byte(buffer, '\0');
+
+	assert(strtod((char*)buffer->buffer, NULL) == value);
+	assert(__test_format_count_digits((char*)buffer->buffer) <= __test_format_shortest_printf(value));
+
+	byte_buffer_clear(buffer);
+}
+
+static void test_format_integer()
+{
+	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
+
+	ByteBuffer *buffer = byte_buffer_new(BYTE_BUFFER_TRUNCATE, 64);
+
+	byte_buffer_append_i64(buffer, 0);
+	__test_format_expect(buffer, "0");
+	byte_buffer_append_i64(buffer, 7);
+	__test_format_expect(buffer, "7");
+	byte_buffer_append_i64(buffer, -42);
+	__test_format_expect(buffer, "-42");
+	byte_buffer_append_i64(buffer, 1234567);
+	__test_format_expect(buffer, "1234567");
+	byte_buffer_append_i64(buffer, INT64_MAX);
+	__test_format_expect(buffer, "9223372036854775807");
+	byte_buffer_append_i64(buffer, INT64_MIN);
+	__test_format_expect(buffer, "-9223372036854775808");
+
+	byte_buffer_append_u64(buffer, 100);
+	__test_format_expect(buffer, "100");
+	byte_buffer_append_u64(buffer, UINT64_MAX);
+	__test_format_expect(buffer, "18446744073709551615");
+
+	byte_buffer_append_hex(buffer, 0);
+	__test_format_expect(buffer, "0");
+	byte_buffer_append_hex(buffer, 0x2a);
+	__test_format_expect(buffer, "2a");
+	byte_buffer_append_hex(buffer, UINT64_MAX);
+	__test_format_expect(buffer, "ffffffffffffffff");
+
+	//compare with printf over many magnitudes
+	char expected[32];
+	uint64_t value = 1;
+	for (size_t curValue = 0; curValue < 1000; curValue++)
+	{
+		snprintf(expected, sizeof(expected), "%lld", (long long)(int64_t)value);
+		byte_buffer_append_i64(buffer, (int64_t)value);
+		__test_format_expect(buffer, expected);
+
+		value = value * 6364136223846793005ULL + 1442695040888963407ULL;
+		value >>= (curValue % 64);
+	}
+
+	//appends follow the mode of the buffer
+	byte_buffer_free(&buffer);
+	buffer = byte_buffer_new(BYTE_BUFFER_SKIP, 8);
+
+	byte_buffer_append_u64(buffer, 123456789);
+	assert(buffer->offset == 0);
+	byte_buffer_append_u64(buffer, 1234);
+	assert(memcmp(buffer->buffer, "1234", 4) == 0);
+
+	byte_buffer_free(&buffer);
+
+	DEBUG_LOG("<<<\n");
+}
+
+static void test_format_f64()
+{
+	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
+
+	ByteBuffer *buffer = byte_buffer_new(BYTE_BUFFER_TRUNCATE, 64);
+
+	byte_buffer_append_f64(buffer, 0.);
+	__test_format_expect(buffer, "0");
+	byte_buffer_append_f64(buffer, -0.);
+	__test_format_expect(buffer, "-0");
+	byte_buffer_append_f64(buffer, 0.1);
+	__test_format_expect(buffer, "0.1");
+	byte_buffer_append_f64(buffer, -47.222);
+	__test_format_expect(buffer, "-47.222");
+	byte_buffer_append_f64(buffer, 123.);
+	__test_format_expect(buffer, "123");
+	byte_buffer_append_f64(buffer, 0.000001);
+	__test_format_expect(buffer, "0.000001");
+	byte_buffer_append_f64(buffer, 1.5e-7);
+	__test_format_expect(buffer, "1.5e-7");
+	byte_buffer_append_f64(buffer, 1e20);
+	__test_format_expect(buffer, "100000000000000000000");
+	byte_buffer_append_f64(buffer, 1e21);
+	__test_format_expect(buffer, "1e21");
+	byte_buffer_append_f64(buffer, 5e-324);
+	__test_format_expect(buffer, "5e-324");
+	byte_buffer_append_f64(buffer, 1.7976931348623157e308);
+	__test_format_expect(buffer, "1.7976931348623157e308");
+	byte_buffer_append_f64(buffer, NAN);
+	__test_format_expect(buffer, "nan");
+	byte_buffer_append_f64(buffer, INFINITY);
+	__test_format_expect(buffer, "inf");
+	byte_buffer_append_f64(buffer, -INFINITY);
+	__test_format_expect(buffer, "-inf");
+
+	//64 bit precision is not enough for these, the exact fallback finds the shorter digits
+	byte_buffer_append_f64(buffer, 93.8440251572327);
+	__test_format_expect(buffer, "93.8440251572327");
+	byte_buffer_append_f64(buffer, 4.148662197091951e34);
+	__test_format_expect(buffer, "4.148662197091951e34");
+	byte_buffer_append_f64(buffer, 2.2250738585072014e-308);
+	__test_format_expect(buffer, "2.2250738585072014e-308");
+	byte_buffer_append_f64(buffer, 9007199254740993.);
+	__test_format_expect(buffer, "9007199254740992");
+
+	//random bit patterns and short decimals must read back to the same value with the fewest digits
+	uint64_t state = TEST_RANDOM_SEED;
+	for (size_t curValue = 0; curValue < TEST_FORMAT_RANDOM_DOUBLES; curValue++)
+	{
+		uint64_t bits = test_random_next(&state);
+
+		double value;
+		memcpy(&value, &bits, sizeof(value));
+
+		if (isfinite(value))
+		{
+			__test_format_expect_shortest(buffer, value);
+		}
+
+		__test_format_expect_shortest(buffer, (double)(state % 100000000) / (double)(1 + (state >> 44)));
+	}
+
+	byte_buffer_free(&buffer);
+
+	DEBUG_LOG("<<<\n");
+}
+
+int main(int argc, char **argv) {
+	UNUSED(argc);
+	UNUSED(argv);
+	DEBUG_LOG(">> start byte format test:\n");
+
+	test_format_integer();
+
+	test_format_f64();
+
+	DEBUG_LOG("<< end byte format test:\n");
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,261 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "defs.h"
+#include "cpu_utils.h"
+#include "byte_frame.h"
+#include "test_utils.h"
+
+#define TEST_FRAME_RECORDS 2000
+
+static const unsigned __test_frame_disabled[] = { 0, CPU_FEATURE_AVX2, ~0U };
+
+static ByteView __test_frame_str(const char* str)
+{
+	return byte_view_of((const unsigned char*)str, strlen(str));
+}
+
+static bool __test_frame_next_equals(ByteFrameReader* frames, const char* expected)
+{
+	ByteView record;
+	return byte_frame_next(frames, &record) == BYTE_FRAME_OK && byte_view_equals(record, __test_frame_str(expected));
+}
+
+static void test_frame_delimited()
+{
+	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
+
+	ByteFrameReader frames;
+	ByteView record;
+
+	byte_frame_init_delimited(&frames, __test_frame_str("first\n\nthird\nrest"), __test_frame_str("\n"));
+	assert(__test_frame_next_equals(&frames, "first"));
+	assert(__test_frame_next_equals(&frames, ""));
+	assert(__test_frame_next_equals(&frames, "third"));
+	assert(byte_frame_next(&frames, &record) == BYTE_FRAME_PARTIAL);
+	assert(byte_frame_next(&frames, &record) == BYTE_FRAME_PARTIAL);
+	assert(byte_frame_position(&frames) == 13);
+	assert(byte_view_equals(byte_frame_rest(&frames), __test_frame_str("rest")));
+
+	//records point into the data
+	const char* text = "a\r\nbc\r\n\r\nd\r";
+	byte_frame_init_delimited(&frames, __test_frame_str(text), __test_frame_str("\r\n"));
+	assert(byte_frame_next(&frames, &record) == BYTE_FRAME_OK && record.ptr == (const unsigned char*)text && record.len == 1);
+	assert(__test_frame_next_equals(&frames, "bc"));
+	assert(__test_frame_next_equals(&frames, ""));
+	assert(byte_frame_next(&frames, &record) == BYTE_FRAME_PARTIAL);
+
+	//streaming: the delimiter is split over the updates
+	char stream[] = "ab\r\ncd\r\nef";
+	byte_frame_init_delimited(&frames, byte_view_of((unsigned char*)stream, 3), __test_frame_str("\r\n"));
+	assert(byte_frame_next(&frames, &record) == BYTE_FRAME_PARTIAL);
+	assert(frames.scanned == 3);
+	byte_frame_update(&frames, byte_view_of((unsigned char*)stream, 7));
+	assert(__test_frame_next_equals(&frames, "ab"));
+	assert(byte_frame_next(&frames, &record) == BYTE_FRAME_PARTIAL);
+
+	//the rest is moved to the start
+	memmove(stream, stream + 4, 6);
+	byte_frame_rebase(&frames, byte_view_of((unsigned char*)stream, 6));
+	assert(__test_frame_next_equals(&frames, "cd"));
+	assert(byte_frame_next(&frames, &record) == BYTE_FRAME_PARTIAL);
+	assert(byte_view_equals(byte_frame_rest(&frames), __test_frame_str("ef")));
+
+	byte_frame_init_delimited(&frames, __test_frame_str(""), __test_frame_str("\n"));
+	assert(byte_frame_next(&frames, &record) == BYTE_FRAME_END);
+
+	byte_frame_init_delimited(&frames, __test_frame_str("a\n"), __test_frame_str(""));
+	assert(byte_frame_next(&frames, &record) == BYTE_FRAME_ERROR);
+
+	//records above the limit are errors, also without a delimiter in the data
+	byte_frame_init_delimited(&frames, __test_frame_str("1234\n12345\n"), __test_frame_str("\n"));
+	frames.maxRecordSize = 4;
+	assert(__test_frame_next_equals(&frames, "1234"));
+	assert(byte_frame_next(&frames, &record) == BYTE_FRAME_ERROR);
+	assert(byte_frame_position(&frames) == 5);
+
+	byte_frame_init_delimited(&frames, __test_frame_str("1234"), __test_frame_str("\n"));
+	frames.maxRecordSize = 4;
+	assert(byte_frame_next(&frames, &record) == BYTE_FRAME_PARTIAL);
+	byte_frame_update(&frames, __test_frame_str("12345"));
+	assert(byte_frame_next(&frames, &record) == BYTE_FRAME_ERROR);
+
+	DEBUG_LOG("<<<\n");
+}
+
+static void test_frame_prefixed()
+{
+	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
+
+	ByteFrameKind kinds[] = { BYTE_FRAME_PREFIX_U8, BYTE_FRAME_PREFIX_U16_LE, BYTE_FRAME_PREFIX_U16_BE,
+	                          BYTE_FRAME_PREFIX_U32_LE, BYTE_FRAME_PREFIX_U32_BE, BYTE_FRAME_PREFIX_UVARINT };
+	const char* records[] = { "", "a", "record", "0123456789012345678901234567890123456789012345678901234567890123456789"
+	                          "0123456789012345678901234567890123456789012345678901234567890123456789" };
+
+	for (size_t curKind = 0; curKind < sizeof(kinds) / sizeof(kinds[0]); curKind++)
+	{
+		ByteBuffer *buffer = byte_buffer_new(BYTE_BUFFER_GROW, 16);
+		byte_buffer_clear(buffer);
+
+		for (size_t curRecord = 0; curRecord < sizeof(records) / sizeof(records[0]); curRecord++)
+		{
+			assert(byte_buffer_append_frame(buffer, kinds[curKind], __test_frame_str(records[curRecord])));
+		}
+
+		//every cut through the data is partial until the record is complete
+		ByteView content = byte_view_from_content(buffer);
+		for (size_t cntBytes = 0; cntBytes <= content.len; cntBytes++)
+		{
+			ByteFrameReader frames;
+			ByteView record;
+			size_t cntRecords = 0;
+			ByteFrameStatus status;
+
+			byte_frame_init_prefixed(&frames, byte_view_prefix(content, cntBytes), kinds[curKind]);
+			while ((status = byte_frame_next(&frames, &record)) == BYTE_FRAME_OK)
+			{
+				assert(byte_view_equals(record, __test_frame_str(records[cntRecords])));
+				cntRecords++;
+			}
+
+			assert(status == ( cntBytes == byte_frame_position(&frames) ? BYTE_FRAME_END : BYTE_FRAME_PARTIAL ));
+			assert(cntRecords < sizeof(records) / sizeof(records[0]) || cntBytes == content.len);
+		}
+
+		//the limit is checked from the prefix before the record is there
+		ByteFrameReader frames;
+		ByteView record;
+		byte_frame_init_prefixed(&frames, byte_view_prefix(content, content.len - 1), kinds[curKind]);
+		frames.maxRecordSize = 6;
+		assert(byte_frame_next(&frames, &record) == BYTE_FRAME_OK);
+		assert(byte_frame_next(&frames, &record) == BYTE_FRAME_OK);
+		assert(byte_frame_next(&frames, &record) == BYTE_FRAME_OK);
+		assert(byte_frame_next(&frames, &record) == BYTE_FRAME_ERROR);
+
+		byte_buffer_free(&buffer);
+	}
+
+	ByteBuffer *buffer = byte_buffer_new(BYTE_BUFFER_GROW, 16);
+	unsigned char large[300] = { 0 };
+	assert(!byte_buffer_append_frame(buffer, BYTE_FRAME_PREFIX_U8, byte_view_of(large, sizeof(large))));
+	assert(!byte_buffer_append_frame(buffer, BYTE_FRAME_DELIMITED, byte_view_of(large, 1)));
+	byte_buffer_free(&buffer);
+
+	//an endless varint is malformed
+	ByteFrameReader frames;
+	ByteView record;
+	unsigned char varint[12];
+	memset(varint, 0x80, sizeof(varint));
+	byte_frame_init_prefixed(&frames, byte_view_of(varint, 9), BYTE_FRAME_PREFIX_UVARINT);
+	assert(byte_frame_next(&frames, &record) == BYTE_FRAME_PARTIAL);
+	byte_frame_update(&frames, byte_view_of(varint, sizeof(varint)));
+	assert(byte_frame_next(&frames, &record) == BYTE_FRAME_ERROR);
+
+	DEBUG_LOG("<<<\n");
+}
+
+//bulk reading in all cpu modes gives the same records as single reads
+static void test_frame_bulk()
+{
+	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
+
+	ByteBuffer *buffer = byte_buffer_new(BYTE_BUFFER_GROW, 16);
+	byte_buffer_clear(buffer);
+
+	uint64_t state = TEST_RANDOM_SEED;
+	for (size_t curRecord = 0; curRecord < TEST_FRAME_RECORDS; curRecord++)
+	{
+		uint64_t random = test_random_next(&state);
+		size_t cntRecord = ( random % 7 == 0 ? 100 + random % 200 : random % 20 );
+		for (size_t curByte = 0; curByte < cntRecord; curByte++)
+		{
+			byte_buffer_append_byte(buffer, (unsigned char)('a' + (curRecord + curByte) % 26));
+		}
+		byte_buffer_append_byte(buffer, '\n');
+	}
+	byte_buffer_append_bytes(buffer, (unsigned char*)"tail", 4);
+
+	ByteView content = byte_view_from_content(buffer);
+	ByteView *expected = malloc(TEST_FRAME_RECORDS * sizeof(ByteView));
+	ByteView *records = malloc(TEST_FRAME_RECORDS * sizeof(ByteView));
+
+	ByteFrameReader frames;
+	byte_frame_init_delimited(&frames, content, __test_frame_str("\n"));
+	for (size_t curRecord = 0; curRecord < TEST_FRAME_RECORDS; curRecord++)
+	{
+		assert(byte_frame_next(&frames, &expected[curRecord]) == BYTE_FRAME_OK);
+	}
+	assert(byte_frame_next(&frames, &records[0]) == BYTE_FRAME_PARTIAL);
+
+	size_t chunks[] = { 1, 7, 64, TEST_FRAME_RECORDS };
+	for (size_t curMode = 0; curMode < sizeof(__test_frame_disabled) / sizeof(__test_frame_disabled[0]); curMode++)
+	{
+		cpu_features_disable(__test_frame_disabled[curMode]);
+
+		for (size_t curChunk = 0; curChunk < sizeof(chunks) / sizeof(chunks[0]); curChunk++)
+		{
+			ByteFrameStatus status = BYTE_FRAME_OK;
+			size_t cntRecords = 0;
+
+			byte_frame_init_delimited(&frames, content, __test_frame_str("\n"));
+			while (status == BYTE_FRAME_OK && cntRecords < TEST_FRAME_RECORDS)
+			{
+				size_t maxRecords = chunks[curChunk];
+				if (maxRecords > TEST_FRAME_RECORDS - cntRecords) maxRecords = TEST_FRAME_RECORDS - cntRecords;
+
+				cntRecords += byte_frame_next_bulk(&frames, records + cntRecords, maxRecords, &status);
+			}
+
+			assert(cntRecords == TEST_FRAME_RECORDS);
+			assert(memcmp(records, expected, TEST_FRAME_RECORDS * sizeof(ByteView)) == 0);
+
+			assert(byte_frame_next_bulk(&frames, records, 10, &status) == 0 && status == BYTE_FRAME_PARTIAL);
+			assert(byte_view_equals(byte_frame_rest(&frames), __test_frame_str("tail")));
+		}
+
+		//growing data is continued behind the scanned part
+		byte_frame_init_delimited(&frames, byte_view_prefix(content, 1000), __test_frame_str("\n"));
+		ByteFrameStatus status;
+		size_t cntRecords = byte_frame_next_bulk(&frames, records, TEST_FRAME_RECORDS, &status);
+		assert(status == BYTE_FRAME_PARTIAL);
+
+		byte_frame_update(&frames, content);
+		cntRecords += byte_frame_next_bulk(&frames, records + cntRecords, TEST_FRAME_RECORDS - cntRecords, &status);
+		assert(cntRecords == TEST_FRAME_RECORDS && status == BYTE_FRAME_OK);
+		assert(memcmp(records, expected, TEST_FRAME_RECORDS * sizeof(ByteView)) == 0);
+
+		//the limit stops the bulk read in front of the long record
+		byte_frame_init_delimited(&frames, content, __test_frame_str("\n"));
+		frames.maxRecordSize = 50;
+		cntRecords = byte_frame_next_bulk(&frames, records, TEST_FRAME_RECORDS, &status);
+		assert(status == BYTE_FRAME_ERROR && cntRecords < TEST_FRAME_RECORDS);
+		assert(memcmp(records, expected, cntRecords * sizeof(ByteView)) == 0);
+		assert(expected[cntRecords].len > 50);
+	}
+
+	cpu_features_disable(0);
+	free(expected);
+	free(records);
+	byte_buffer_free(&buffer);
+
+	DEBUG_LOG("<<<\n");
+}
+
+int main(int argc, char **argv) {
+	UNUSED(argc);
+	UNUSED(argv);
+	DEBUG_LOG(">> start byte frame test:\n");
+
+	test_frame_delimited();
+
+	test_frame_prefixed();
+
+	test_frame_bulk();
+
+	DEBUG_LOG("<< end byte frame test:\n");
+
+	return 0;
+}
\ No newline at end of file
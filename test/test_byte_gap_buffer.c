@@ -0,0 +1,320 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+#include <string.h>
+
+#include "defs.h"
+#include "byte_gap_buffer.h"
+
+static void __test_gb_equals(ByteGapBuffer *_buffer, const char* _testBuff)
+{
+	ByteGapBuffer *buffer = _buffer;
+	const char* testBuff = _testBuff;
+	size_t length = strlen(testBuff);
+
+	assert(byte_gap_buffer_length(buffer) == length);
+
+	for (size_t curByte = 0; curByte < length; curByte++)
+	{	
+		assert(byte_gap_buffer_get(buffer, curByte) == (unsigned char)testBuff[curByte]);
+	}
+}
+
+static void test_gb_init()
+{
+	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
+
+	ByteGapBuffer buffer;
+	ByteGapBuffer *buffPtr = &buffer;
+
+	byte_gap_buffer_init_new(buffPtr, 20);
+
+	assert(buffPtr->buffer != NULL);
+	assert(buffPtr->size == 20);
+	assert(buffPtr->gapStart == 0);
+	assert(buffPtr->gapEnd == 20);
+	assert(buffPtr->allocObj == false);
+	assert(byte_gap_buffer_length(buffPtr) == 0);
+
+	byte_gap_buffer_free(&buffPtr);
+
+	assert(buffPtr->buffer == NULL);
+	assert(buffPtr->size == 0);
+
+	ByteGapBuffer *gbObj = byte_gap_buffer_new(0);
+
+	assert(gbObj->allocObj == true);
+	assert(byte_gap_buffer_length(gbObj) == 0);
+
+	byte_gap_buffer_free(&gbObj);
+
+	assert(gbObj == NULL);
+
+	DEBUG_LOG("<<<\n");
+}
+
+static void test_gb_append()
+{
+	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
+
+	ByteGapBuffer *buffer = byte_gap_buffer_new(4);
+
+	byte_gap_buffer_append_byte(buffer, 'A');
+	byte_gap_buffer_append_bytes(buffer, (unsigned char *)"0123456789", 10);
+	byte_gap_buffer_append_bytes_fmt(buffer, "[%.3f]", 47.222f);
+
+	__test_gb_equals(buffer, "A0123456789[47.222]");
+	assert(buffer->size == 32);
+
+	byte_gap_buffer_clear(buffer);
+
+	__test_gb_equals(buffer, "");
+
+	byte_gap_buffer_free(&buffer);
+
+	DEBUG_LOG("<<<\n");
+}
+
+static void test_gb_insert()
+{
+	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
+
+	ByteGapBuffer *buffer = byte_gap_buffer_new(8);
+
+	byte_gap_buffer_append_bytes(buffer, (unsigned char *)"AAAAABBBBB", 10);
+
+	byte_gap_buffer_insert_bytes(buffer, 5, (unsigned char *)"XY", 2);
+	byte_gap_buffer_insert_byte(buffer, 3, 'Z');
+	byte_gap_buffer_insert_bytes_fmt(buffer, 13, "[%s]", "END");
+	byte_gap_buffer_prepend_byte(buffer, '<');
+	byte_gap_buffer_prepend_bytes(buffer, (unsigned char *)"<<", 2);
+	byte_gap_buffer_prepend_bytes_fmt(buffer, "%d", 42);
+
+	__test_gb_equals(buffer, "42<<<AAAZAAXYBBBBB[END]");
+
+	//behind the end is ignored
+	byte_gap_buffer_insert_byte(buffer, 24, 'Q');
+
+	__test_gb_equals(buffer, "42<<<AAAZAAXYBBBBB[END]");
+
+	byte_gap_buffer_free(&buffer);
+
+	DEBUG_LOG("<<<\n");
+}
+
+static void test_gb_replace_remove()
+{
+	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
+
+	ByteGapBuffer *buffer = byte_gap_buffer_new(8);
+
+	byte_gap_buffer_append_bytes(buffer, (unsigned char *)"0123456789", 10);
+
+	byte_gap_buffer_replace_byte(buffer, 0, 'A');
+	byte_gap_buffer_replace_bytes(buffer, 4, (unsigned char *)"BCD", 3);
+	byte_gap_buffer_replace_bytes_fmt(buffer, 1, "[%d]", 7);
+
+	__test_gb_equals(buffer, "A[7]BCD789");
+
+	//replace behind the end extends the content
+	byte_gap_buffer_replace_bytes(buffer, 8, (unsigned char *)"XYZ", 3);
+
+	__test_gb_equals(buffer, "A[7]BCD7XYZ");
+
+	byte_gap_buffer_remove(buffer, 1, 3);
+	byte_gap_buffer_remove(buffer, 6, 100);
+
+	__test_gb_equals(buffer, "ABCD7X");
+
+	byte_gap_buffer_free(&buffer);
+
+	DEBUG_LOG("<<<\n");
+}
+
+static void test_gb_local_edits()
+{
+	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
+
+	ByteGapBuffer *buffer = byte_gap_buffer_new(64);
+
+	for (size_t curByte = 0; curByte < 1000; curByte++)
+	{
+		byte_gap_buffer_append_byte(buffer, '.');
+	}
+
+	//edits near the gap only move the bytes between gap and edit position
+	for (size_t curEdit = 0; curEdit < 100; curEdit++)
+	{
+		byte_gap_buffer_insert_byte(buffer, 500 + curEdit, (unsigned char)('a' + (curEdit % 26)));
+		assert(buffer->gapStart == 501 + curEdit);
+	}
+
+	assert(byte_gap_buffer_length(buffer) == 1100);
+	assert(byte_gap_buffer_get(buffer, 499) == '.');
+	assert(byte_gap_buffer_get(buffer, 500) == 'a');
+	assert(byte_gap_buffer_get(buffer, 599) == 'v');
+	assert(byte_gap_buffer_get(buffer, 600) == '.');
+
+	byte_gap_buffer_free(&buffer);
+
+	DEBUG_LOG("<<<\n");
+}
+
+static bool testFailAllocs = false;
+
+static void* __test_gb_failing_alloc(void* ctx, size_t size)
+{
+	(void)ctx;
+	return ( testFailAllocs ? NULL : malloc(size) );
+}
+
+static void test_gb_alloc_failure()
+{
+	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
+
+	MemAllocator failing = *mem_allocator_default();
+	failing.alloc = __test_gb_failing_alloc;
+	mem_allocator_set(&failing);
+
+	ByteGapBuffer *buffer = byte_gap_buffer_new(8);
+	byte_gap_buffer_append_bytes(buffer, (unsigned char *)"KEEP", 4);
+
+	testFailAllocs = true;
+
+	assert(byte_gap_buffer_new(8) == NULL);
+
+	//without a result object the gap buffer keeps its memory
+	unsigned char* memory = buffer->buffer;
+	assert(byte_gap_buffer_flatten(buffer, BYTE_BUFFER_GROW) == NULL);
+	assert(buffer->buffer == memory);
+	__test_gb_equals(buffer, "KEEP");
+
+	testFailAllocs = false;
+
+	byte_gap_buffer_free(&buffer);
+	mem_allocator_set(NULL);
+
+	DEBUG_LOG("<<<\n");
+}
+
+static size_t testCntAllocs = 0;
+static size_t testCntFrees = 0;
+
+static void* __test_gb_counting_alloc(void* ctx, size_t size)
+{
+	(void)ctx;
+	testCntAllocs++;
+	return malloc(size);
+}
+
+static void __test_gb_counting_free(void* ctx, void* ptr)
+{
+	(void)ctx;
+	if (ptr) testCntFrees++;
+	free(ptr);
+}
+
+static void test_gb_allocator()
+{
+	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
+
+	MemAllocator counting = *mem_allocator_default();
+	counting.alloc = __test_gb_counting_alloc;
+	counting.free = __test_gb_counting_free;
+	mem_allocator_set(&counting);
+
+	ByteGapBuffer *buffer = byte_gap_buffer_new(8);
+	ByteGapBuffer *flattened = byte_gap_buffer_new(8);
+	assert(buffer->allocator == &counting);
+
+	mem_allocator_set(NULL);
+
+	//memory goes back to the allocator of the gap buffer, not the current one
+	byte_gap_buffer_append_bytes(buffer, (unsigned char *)"0123456789ABCDEF", 16);
+	byte_gap_buffer_append_bytes(flattened, (unsigned char *)"FLAT", 4);
+
+	ByteBuffer *flat = byte_gap_buffer_flatten(flattened, BYTE_BUFFER_GROW);
+	assert(flat->allocator == &counting);
+
+	byte_buffer_free(&flat);
+	byte_gap_buffer_free(&flattened);
+	byte_gap_buffer_free(&buffer);
+
+	assert(testCntAllocs == 5);
+	assert(testCntFrees == testCntAllocs);
+
+	DEBUG_LOG("<<<\n");
+}
+
+static void test_gb_flatten()
+{
+	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
+
+	ByteGapBuffer *buffer = byte_gap_buffer_new(8);
+
+	byte_gap_buffer_append_bytes(buffer, (unsigned char *)"AAAAABBBBB", 10);
+	byte_gap_buffer_insert_bytes(buffer, 5, (unsigned char *)"XY", 2);
+
+	//copy keeps the gap buffer
+	unsigned char rawBuffer[20];
+	ByteBuffer dest;
+	byte_buffer_init(&dest, BYTE_BUFFER_TRUNCATE, &rawBuffer[0], 20);
+	byte_gap_buffer_copy_to_buffer(buffer, &dest);
+
+	assert(dest.offset == 12);
+	assert(memcmp(dest.buffer, "AAAAAXYBBBBB", 12) == 0);
+	__test_gb_equals(buffer, "AAAAAXYBBBBB");
+
+	//flatten takes over the memory
+	unsigned char* memory = buffer->buffer;
+	size_t capacity = buffer->size;
+
+	ByteBuffer *flat = byte_gap_buffer_flatten(buffer, BYTE_BUFFER_GROW);
+
+	assert(flat->buffer == memory);
+	assert(flat->size == capacity);
+	assert(flat->offset == 12);
+	assert(flat->alloc == true);
+	assert(flat->allocObj == true);
+	assert(flat->mode == BYTE_BUFFER_GROW);
+	assert(memcmp(flat->buffer, "AAAAAXYBBBBB", 12) == 0);
+
+	assert(buffer->buffer == NULL);
+	assert(byte_gap_buffer_length(buffer) == 0);
+
+	//gap buffer stays usable
+	byte_gap_buffer_append_bytes(buffer, (unsigned char *)"NEW", 3);
+
+	__test_gb_equals(buffer, "NEW");
+
+	byte_buffer_free(&flat);
+	byte_gap_buffer_free(&buffer);
+
+	DEBUG_LOG("<<<\n");
+}
+
+int main(int argc, char **argv) {
+	UNUSED(argc);
+	UNUSED(argv);
+	DEBUG_LOG(">> start byte gap buffer test:\n");
+
+	test_gb_init();
+
+	test_gb_append();
+
+	test_gb_insert();
+
+	test_gb_replace_remove();
+
+	test_gb_local_edits();
+
+	test_gb_flatten();
+
+	test_gb_alloc_failure();
+
+	test_gb_allocator();
+
+	DEBUG_LOG("<< end byte gap buffer test:\n");
+
+	return 0;
+}
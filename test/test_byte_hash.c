@@ -0,0 +1,164 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "defs.h"
+#include "cpu_utils.h"
+#include "byte_hash.h"
+#include "test_utils.h"
+
+#define TEST_HASH_SIZE 5000
+
+//bitwise reference
+static uint32_t __test_hash_crc32c_bitwise(const unsigned char* bytes, size_t cntBytes)
+{
+	uint32_t crc = 0xFFFFFFFFU;
+
+	for (size_t curByte = 0; curByte < cntBytes; curByte++)
+	{
+		crc ^= bytes[curByte];
+		for (int curBit = 0; curBit < 8; curBit++)
+		{
+			crc = (crc >> 1) ^ (0x82F63B78U & (0U - (crc & 1)));
+		}
+	}
+
+	return ~crc;
+}
+
+static void test_hash_crc32c()
+{
+	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
+
+	unsigned char zeros[32] = { 0 };
+	unsigned char *data = malloc(TEST_HASH_SIZE);
+	test_random_fill(data, TEST_HASH_SIZE);
+
+	unsigned disabled[] = { 0, ~0U };
+	for (size_t curMode = 0; curMode < sizeof(disabled) / sizeof(disabled[0]); curMode++)
+	{
+		cpu_features_disable(disabled[curMode]);
+
+		assert(byte_crc32c((unsigned char *)"123456789", 9) == 0xE3069283U);
+		assert(byte_crc32c(zeros, sizeof(zeros)) == 0x8A9136AAU);
+		assert(byte_crc32c(NULL, 0) == 0);
+
+		for (size_t cntBytes = 0; cntBytes < 100; cntBytes++)
+		{
+			assert(byte_crc32c(data + 3, cntBytes) == __test_hash_crc32c_bitwise(data + 3, cntBytes));
+		}
+
+		//split at any point gives the same crc
+		uint32_t complete = byte_crc32c(data, TEST_HASH_SIZE);
+		assert(complete == __test_hash_crc32c_bitwise(data, TEST_HASH_SIZE));
+
+		for (size_t split = 0; split < TEST_HASH_SIZE; split += 97)
+		{
+			assert(byte_crc32c_update(byte_crc32c(data, split), data + split, TEST_HASH_SIZE - split) == complete);
+		}
+	}
+
+	cpu_features_disable(0);
+	free(data);
+
+	DEBUG_LOG("<<<\n");
+}
+
+static void test_hash_xxh64()
+{
+	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
+
+	//reference values of XXH64
+	assert(byte_xxh64(NULL, 0, 0) == 0xEF46DB3751D8E999ULL);
+	assert(byte_xxh64((unsigned char *)"a", 1, 0) == 0xD24EC4F1A98C6E5BULL);
+	assert(byte_xxh64((unsigned char *)"abc", 3, 0) == 0x44BC2CF5AD770999ULL);
+
+	unsigned char *data = malloc(TEST_HASH_SIZE);
+	test_random_fill(data, TEST_HASH_SIZE);
+
+	uint64_t complete = byte_xxh64(data, TEST_HASH_SIZE, 42);
+	assert(complete != byte_xxh64(data, TEST_HASH_SIZE, 43));
+
+	//streaming in uneven pieces
+	size_t pieces[] = { 1, 7, 31, 32, 33, 64, 5, 1000 };
+	ByteXxh64 state;
+	byte_xxh64_init(&state, 42);
+
+	size_t position = 0;
+	for (size_t curPiece = 0; position < TEST_HASH_SIZE; curPiece++)
+	{
+		size_t cntPiece = pieces[curPiece % (sizeof(pieces) / sizeof(pieces[0]))];
+		if (cntPiece > TEST_HASH_SIZE - position) cntPiece = TEST_HASH_SIZE - position;
+
+		byte_xxh64_update(&state, data + position, cntPiece);
+		position += cntPiece;
+
+		assert(byte_xxh64_digest(&state) == byte_xxh64(data, position, 42));
+	}
+
+	assert(byte_xxh64_digest(&state) == complete);
+
+	free(data);
+
+	DEBUG_LOG("<<<\n");
+}
+
+static void test_hash_buffer()
+{
+	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
+
+	ByteBuffer *buffer = byte_buffer_new(BYTE_BUFFER_GROW, 16);
+	byte_buffer_clear(buffer);
+
+	ByteBufferHasher hasher;
+	byte_buffer_hasher_init(&hasher, BYTE_HASH_CRC32C | BYTE_HASH_XXH64, 7);
+
+	unsigned char *data = malloc(TEST_HASH_SIZE);
+	test_random_fill(data, TEST_HASH_SIZE);
+
+	for (size_t position = 0; position < TEST_HASH_SIZE; position += 100)
+	{
+		byte_buffer_append_bytes(buffer, data + position, 100);
+		assert(byte_buffer_hasher_update(&hasher, buffer));
+	}
+
+	byte_buffer_append_bytes_fmt(buffer, "%s", "tail");
+	assert(byte_buffer_hasher_update(&hasher, buffer));
+	assert(hasher.position == TEST_HASH_SIZE + 4);
+
+	assert(hasher.crc32c == byte_buffer_crc32c(buffer));
+	assert(byte_buffer_hasher_xxh64(&hasher) == byte_buffer_xxh64(buffer, 7));
+
+	//only the selected hashes are updated
+	ByteBufferHasher crcOnly;
+	byte_buffer_hasher_init(&crcOnly, BYTE_HASH_CRC32C, 0);
+	assert(byte_buffer_hasher_update(&crcOnly, buffer));
+	assert(crcOnly.crc32c == hasher.crc32c);
+	assert(byte_buffer_hasher_xxh64(&crcOnly) == byte_xxh64(NULL, 0, 0));
+
+	byte_buffer_clear(buffer);
+	assert(!byte_buffer_hasher_update(&hasher, buffer));
+
+	free(data);
+	byte_buffer_free(&buffer);
+
+	DEBUG_LOG("<<<\n");
+}
+
+int main(int argc, char **argv) {
+	UNUSED(argc);
+	UNUSED(argv);
+	DEBUG_LOG(">> start byte hash test:\n");
+
+	test_hash_crc32c();
+
+	test_hash_xxh64();
+
+	test_hash_buffer();
+
+	DEBUG_LOG("<< end byte hash test:\n");
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,146 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include "defs.h"
+#include "byte_io.h"
+
+#define TEST_IO_LARGE_SIZE (300 * 1024)
+
+static void test_io_writev_readv()
+{
+	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
+
+	int fds[2];
+	assert(pipe(fds) == 0);
+
+	ByteBuffer *first = byte_buffer_new(BYTE_BUFFER_TRUNCATE, 10);
+	ByteBuffer *empty = byte_buffer_new(BYTE_BUFFER_TRUNCATE, 10);
+	ByteBuffer *second = byte_buffer_new(BYTE_BUFFER_TRUNCATE, 20);
+
+	byte_buffer_fill_complete(first, 'X');
+	byte_buffer_fill_complete(second, 'X');
+
+	//only the written bytes until offset are sent
+	byte_buffer_append_bytes(first, (unsigned char *)"HELLO", 5);
+	byte_buffer_append_bytes_fmt(second, " WORLD %d", 42);
+
+	ByteBuffer *sendBuffers[3] = { first, empty, second };
+	size_t written = 0;
+
+	assert(byte_buffer_writev_fd(fds[1], &sendBuffers[0], 3, &written));
+	assert(written == 14);
+
+	//read is spread over the free bytes of the buffers
+	unsigned char rawBuffer1[6];
+	unsigned char rawBuffer2[20];
+	ByteBuffer recv1;
+	ByteBuffer recv2;
+	byte_buffer_init(&recv1, BYTE_BUFFER_TRUNCATE, &rawBuffer1[0], 6);
+	byte_buffer_init(&recv2, BYTE_BUFFER_TRUNCATE, &rawBuffer2[0], 20);
+	byte_buffer_append_byte(&recv1, '>');
+
+	ByteBuffer *recvBuffers[2] = { &recv1, &recv2 };
+	size_t cntRead = 0;
+
+	assert(byte_buffer_readv_fd(fds[0], &recvBuffers[0], 2, &cntRead));
+	assert(cntRead == 14);
+	assert(recv1.offset == 6);
+	assert(recv2.offset == 9);
+	assert(memcmp(recv1.buffer, ">HELLO", 6) == 0);
+	assert(memcmp(recv2.buffer, " WORLD 42", 9) == 0);
+
+	//end of file
+	close(fds[1]);
+
+	assert(byte_buffer_readv_fd(fds[0], &recvBuffers[0], 2, &cntRead));
+	assert(cntRead == 0);
+
+	close(fds[0]);
+
+	byte_buffer_free(&first);
+	byte_buffer_free(&empty);
+	byte_buffer_free(&second);
+
+	DEBUG_LOG("<<<\n");
+}
+
+static void* __test_io_reader(void* _fd)
+{
+	int fd = *(int*)_fd;
+	ByteBuffer *buffer = byte_buffer_new(BYTE_BUFFER_TRUNCATE, 3 * TEST_IO_LARGE_SIZE);
+	size_t cntRead = 1;
+
+	while (cntRead > 0)
+	{
+		assert(byte_buffer_readv_fd(fd, &buffer, 1, &cntRead));
+	}
+
+	return buffer;
+}
+
+static void test_io_large()
+{
+	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
+
+	int fds[2];
+	assert(pipe(fds) == 0);
+
+	pthread_t reader;
+	pthread_create(&reader, NULL, __test_io_reader, &fds[0]);
+
+	//more than a pipe can hold, so the writes get split
+	ByteBuffer *buffers[3];
+	for (size_t curBuffer = 0; curBuffer < 3; curBuffer++)
+	{
+		buffers[curBuffer] = byte_buffer_new(BYTE_BUFFER_TRUNCATE, TEST_IO_LARGE_SIZE);
+		byte_buffer_fill_complete(buffers[curBuffer], (unsigned char)('A' + curBuffer));
+		buffers[curBuffer]->offset = TEST_IO_LARGE_SIZE - curBuffer;
+	}
+
+	size_t written = 0;
+
+	assert(byte_buffer_writev_fd(fds[1], &buffers[0], 3, &written));
+	assert(written == 3 * TEST_IO_LARGE_SIZE - 3);
+
+	close(fds[1]);
+
+	ByteBuffer *received = NULL;
+	pthread_join(reader, (void**)&received);
+
+	assert(received->offset == written);
+
+	size_t curIdx = 0;
+	for (size_t curBuffer = 0; curBuffer < 3; curBuffer++)
+	{
+		for (size_t curByte = 0; curByte < buffers[curBuffer]->offset; curByte++, curIdx++)
+		{
+			assert(received->buffer[curIdx] == (unsigned char)('A' + curBuffer));
+		}
+		byte_buffer_free(&buffers[curBuffer]);
+	}
+
+	close(fds[0]);
+	byte_buffer_free(&received);
+
+	DEBUG_LOG("<<<\n");
+}
+
+int main(int argc, char **argv) {
+	UNUSED(argc);
+	UNUSED(argv);
+	DEBUG_LOG(">> start byte io test:\n");
+
+	test_io_writev_readv();
+
+	test_io_large();
+
+	DEBUG_LOG("<< end byte io test:\n");
+
+	return 0;
+}
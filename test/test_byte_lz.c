@@ -0,0 +1,367 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "defs.h"
+#include "byte_lz.h"
+#include "test_utils.h"
+
+#define TEST_LZ_SIZE (300 * 1024)
+
+static uint64_t testLzState = TEST_RANDOM_SEED;
+
+//random bytes, words of a small dictionary or runs of one byte
+static void __test_lz_fill(unsigned char* bytes, size_t cntBytes, int kind)
+{
+	static const char* words[] = { "alpha ", "beta ", "gamma ", "delta ", "epsilon ", "zeta ", "\n" };
+
+	for (size_t curByte = 0; curByte < cntBytes;)
+	{
+		if (kind == 0)
+		{
+			bytes[curByte++] = (unsigned char)test_random_next(&testLzState);
+		}
+		else if (kind == 1)
+		{
+			const char* word = words[test_random_next(&testLzState) % (sizeof(words) / sizeof(words[0]))];
+			for (size_t curChar = 0; word[curChar] && curByte < cntBytes; curChar++)
+			{
+				bytes[curByte++] = (unsigned char)word[curChar];
+			}
+		}
+		else
+		{
+			size_t cntRun = 1 + test_random_next(&testLzState) % 300;
+			unsigned char value = (unsigned char)(test_random_next(&testLzState) % 4);
+			for (; cntRun > 0 && curByte < cntBytes; cntRun--)
+			{
+				bytes[curByte++] = value;
+			}
+		}
+	}
+}
+
+static void test_lz_block()
+{
+	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
+
+	unsigned char *data = malloc(TEST_LZ_SIZE);
+	unsigned char *compressed = malloc(byte_lz_compress_bound(TEST_LZ_SIZE));
+	unsigned char *decompressed = malloc(TEST_LZ_SIZE);
+
+	for (int kind = 0; kind < 3; kind++)
+	{
+		__test_lz_fill(data, TEST_LZ_SIZE, kind);
+
+		for (size_t cntBytes = 0; cntBytes <= TEST_LZ_SIZE; cntBytes += ( cntBytes < 100 ? 1 : 9973 ))
+		{
+			ByteView src = byte_view_of(data, cntBytes);
+			size_t cntCompressed = byte_lz_compress(compressed, byte_lz_compress_bound(cntBytes), src);
+			assert(cntCompressed > 0 && cntCompressed <= byte_lz_compress_bound(cntBytes));
+
+			size_t cntDecompressed = 0;
+			assert(byte_lz_decompress(decompressed, cntBytes, byte_view_of(compressed, cntCompressed), &cntDecompressed));
+			assert(cntDecompressed == cntBytes && memcmp(decompressed, data, cntBytes) == 0);
+
+			//exactly the compressed size is enough
+			assert(byte_lz_compress(compressed, cntCompressed, src) == cntCompressed);
+
+			//too small for the result or for the compressed block
+			if (cntBytes > 0)
+			{
+				assert(!byte_lz_decompress(decompressed, cntBytes - 1, byte_view_of(compressed, cntCompressed), &cntDecompressed));
+				assert(byte_lz_compress(compressed, cntCompressed - 1, src) == 0);
+			}
+		}
+
+		size_t cntCompressed = byte_lz_compress(compressed, byte_lz_compress_bound(TEST_LZ_SIZE), byte_view_of(data, TEST_LZ_SIZE));
+		if (kind == 0) assert(cntCompressed > TEST_LZ_SIZE);
+		if (kind == 1) assert(cntCompressed < TEST_LZ_SIZE / 2);
+		if (kind == 2) assert(cntCompressed < TEST_LZ_SIZE / 20);
+	}
+
+	free(data);
+	free(compressed);
+	free(decompressed);
+
+	DEBUG_LOG("<<<\n");
+}
+
+//damaged blocks are rejected or decompressed to something, but never out of bounds
+static void test_lz_block_damaged()
+{
+	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
+
+	size_t cntBytes = 4000;
+	unsigned char *data = malloc(cntBytes);
+	unsigned char *compressed = malloc(byte_lz_compress_bound(cntBytes));
+	unsigned char *decompressed = malloc(cntBytes);
+	__test_lz_fill(data, cntBytes, 1);
+
+	size_t cntCompressed = byte_lz_compress(compressed, byte_lz_compress_bound(cntBytes), byte_view_of(data, cntBytes));
+
+	for (size_t curRound = 0; curRound < 2000; curRound++)
+	{
+		unsigned char *damaged = malloc(cntCompressed);
+		memcpy(damaged, compressed, cntCompressed);
+		damaged[test_random_next(&testLzState) % cntCompressed] = (unsigned char)test_random_next(&testLzState);
+
+		size_t cntDamaged = ( curRound % 2 ? cntCompressed : test_random_next(&testLzState) % cntCompressed );
+		size_t cntDecompressed = 0;
+		if (byte_lz_decompress(decompressed, cntBytes, byte_view_of(damaged, cntDamaged), &cntDecompressed))
+		{
+			assert(cntDecompressed <= cntBytes);
+		}
+
+		free(damaged);
+	}
+
+	free(data);
+	free(compressed);
+	free(decompressed);
+
+	DEBUG_LOG("<<<\n");
+}
+
+static void test_lz_frame()
+{
+	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
+
+	unsigned char *data = malloc(TEST_LZ_SIZE);
+	__test_lz_fill(data, TEST_LZ_SIZE / 2, 1);
+	__test_lz_fill(data + TEST_LZ_SIZE / 2, TEST_LZ_SIZE / 2, 0);
+
+	size_t pieces[] = { 1, 700, 5000, 70000, 13, 1024 };
+	size_t blockSizes[] = { 0, BYTE_LZ_MIN_BLOCK_SIZE, BYTE_LZ_MAX_BLOCK_SIZE };
+
+	for (size_t curBlockSize = 0; curBlockSize < sizeof(blockSizes) / sizeof(blockSizes[0]); curBlockSize++)
+	{
+		ByteBuffer *compressed = byte_buffer_new(BYTE_BUFFER_GROW, 16);
+		byte_buffer_clear(compressed);
+
+		//written in uneven pieces
+		ByteLzEncoder *encoder = byte_lz_encoder_new(compressed, blockSizes[curBlockSize], BYTE_LZ_FLAG_CHECKSUM);
+		assert(encoder);
+
+		for (size_t position = 0, curPiece = 0; position < TEST_LZ_SIZE; curPiece++)
+		{
+			size_t cntPiece = pieces[curPiece % (sizeof(pieces) / sizeof(pieces[0]))];
+			if (cntPiece > TEST_LZ_SIZE - position) cntPiece = TEST_LZ_SIZE - position;
+
+			assert(byte_lz_encoder_write(encoder, byte_view_of(data + position, cntPiece)));
+			position += cntPiece;
+		}
+
+		assert(byte_lz_encoder_finish(encoder));
+		assert(!byte_lz_encoder_finish(encoder));
+		assert(!byte_lz_encoder_write(encoder, byte_view_of(data, 1)));
+		byte_lz_encoder_free(&encoder);
+		assert(!encoder);
+
+		assert(compressed->offset < TEST_LZ_SIZE * 3 / 4);
+
+		//read in the same uneven pieces into growing and fixed buffers
+		ByteBuffer *grow = byte_buffer_new(BYTE_BUFFER_GROW, 16);
+		ByteBuffer *fixed = byte_buffer_new(BYTE_BUFFER_TRUNCATE, TEST_LZ_SIZE);
+		byte_buffer_clear(grow);
+		byte_buffer_clear(fixed);
+
+		ByteLzDecoder *growDecoder = byte_lz_decoder_new(grow);
+		ByteLzDecoder *fixedDecoder = byte_lz_decoder_new(fixed);
+		ByteView frame = byte_view_from_content(compressed);
+
+		ByteLzStatus growStatus = BYTE_LZ_OK;
+		for (size_t position = 0, curPiece = 0; position < frame.len; curPiece++)
+		{
+			size_t cntPiece = pieces[curPiece % (sizeof(pieces) / sizeof(pieces[0]))];
+			if (cntPiece > frame.len - position) cntPiece = frame.len - position;
+
+			size_t consumed = 0;
+			growStatus = byte_lz_decoder_write(growDecoder, byte_view_slice(frame, position, cntPiece), &consumed);
+			assert(consumed == cntPiece);
+			assert(growStatus == ( position + cntPiece < frame.len ? BYTE_LZ_OK : BYTE_LZ_END ));
+			position += cntPiece;
+		}
+
+		assert(byte_lz_decoder_write(fixedDecoder, frame, NULL) == BYTE_LZ_END);
+
+		assert(byte_view_equals(byte_view_from_content(grow), byte_view_of(data, TEST_LZ_SIZE)));
+		assert(byte_view_equals(byte_view_from_content(fixed), byte_view_of(data, TEST_LZ_SIZE)));
+
+		byte_lz_decoder_free(&growDecoder);
+		byte_lz_decoder_free(&fixedDecoder);
+		byte_buffer_free(&grow);
+		byte_buffer_free(&fixed);
+		byte_buffer_free(&compressed);
+	}
+
+	ByteLzEncoder encoder;
+	ByteBuffer *dest = byte_buffer_new(BYTE_BUFFER_GROW, 16);
+	assert(!byte_lz_encoder_init(&encoder, dest, 3000, 0));
+	assert(!byte_lz_encoder_init(&encoder, dest, BYTE_LZ_MAX_BLOCK_SIZE * 2, 0));
+	assert(!byte_lz_encoder_init(&encoder, NULL, 0, 0));
+	byte_buffer_free(&dest);
+
+	free(data);
+
+	DEBUG_LOG("<<<\n");
+}
+
+static size_t testCntAllocs = 0;
+static size_t testCntFrees = 0;
+
+static void* __test_lz_counting_alloc(void* ctx, size_t size)
+{
+	(void)ctx;
+	testCntAllocs++;
+	return malloc(size);
+}
+
+static void __test_lz_counting_free(void* ctx, void* ptr)
+{
+	(void)ctx;
+	if (ptr) testCntFrees++;
+	free(ptr);
+}
+
+static void test_lz_allocator()
+{
+	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
+
+	MemAllocator counting = *mem_allocator_default();
+	counting.alloc = __test_lz_counting_alloc;
+	counting.free = __test_lz_counting_free;
+
+	ByteBuffer *compressed = byte_buffer_new(BYTE_BUFFER_GROW, 16);
+	ByteBuffer *decompressed = byte_buffer_new(BYTE_BUFFER_GROW, 16);
+	byte_buffer_clear(compressed);
+	byte_buffer_clear(decompressed);
+
+	mem_allocator_set(&counting);
+
+	ByteLzEncoder *encoder = byte_lz_encoder_new(compressed, 0, 0);
+	ByteLzDecoder *decoder = byte_lz_decoder_new(decompressed);
+	assert(encoder->allocator == &counting);
+	assert(decoder->allocator == &counting);
+
+	mem_allocator_set(NULL);
+
+	//staging memory and objects use the allocator of encoder and decoder
+	assert(byte_lz_encoder_write(encoder, byte_view_of((unsigned char *)"ALLOCATOR", 9)));
+	assert(byte_lz_encoder_finish(encoder));
+	assert(byte_lz_decoder_write(decoder, byte_view_from_content(compressed), NULL) == BYTE_LZ_END);
+	assert(byte_view_equals(byte_view_from_content(decompressed), byte_view_of((unsigned char *)"ALLOCATOR", 9)));
+
+	byte_lz_encoder_free(&encoder);
+	byte_lz_decoder_free(&decoder);
+
+	assert(testCntAllocs == 4);
+	assert(testCntFrees == 4);
+
+	byte_buffer_free(&compressed);
+	byte_buffer_free(&decompressed);
+
+	DEBUG_LOG("<<<\n");
+}
+
+static void test_lz_buffer()
+{
+	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
+
+	unsigned char *data = malloc(TEST_LZ_SIZE);
+	__test_lz_fill(data, TEST_LZ_SIZE, 2);
+
+	ByteBuffer *source = byte_buffer_new(BYTE_BUFFER_GROW, 16);
+	byte_buffer_clear(source);
+	byte_buffer_append_bytes(source, data, TEST_LZ_SIZE);
+
+	ByteBuffer *compressed = byte_buffer_new(BYTE_BUFFER_GROW, 16);
+	ByteBuffer *decompressed = byte_buffer_new(BYTE_BUFFER_GROW, 16);
+	byte_buffer_clear(compressed);
+	byte_buffer_clear(decompressed);
+
+	assert(byte_buffer_append_lz_compressed(compressed, byte_view_from_content(source)));
+	assert(byte_buffer_append_lz_decompressed(decompressed, byte_view_from_content(compressed)));
+	assert(byte_view_equals(byte_view_from_content(decompressed), byte_view_from_content(source)));
+
+	//empty content is a frame without blocks
+	ByteBuffer *empty = byte_buffer_new(BYTE_BUFFER_GROW, 16);
+	byte_buffer_clear(empty);
+	assert(byte_buffer_append_lz_compressed(empty, byte_view_of(data, 0)));
+	assert(empty->offset == 6 + 4 + 4);
+	assert(byte_buffer_append_lz_decompressed(decompressed, byte_view_from_content(empty)));
+	assert(decompressed->offset == TEST_LZ_SIZE);
+
+	//damaged frames leave the offset
+	ByteView frame = byte_view_from_content(compressed);
+	assert(!byte_buffer_append_lz_decompressed(decompressed, byte_view_prefix(frame, frame.len - 1)));
+	assert(decompressed->offset == TEST_LZ_SIZE);
+
+	byte_buffer_append_byte(compressed, 0);
+	assert(!byte_buffer_append_lz_decompressed(decompressed, byte_view_from_content(compressed)));
+	compressed->offset--;
+
+	//a wrong checksum or header is detected
+	for (size_t position = 0; position < 6; position++)
+	{
+		compressed->buffer[position] ^= 0x40;
+		assert(!byte_buffer_append_lz_decompressed(decompressed, byte_view_from_content(compressed)));
+		compressed->buffer[position] ^= 0x40;
+	}
+
+	compressed->buffer[compressed->offset - 1] ^= 1;
+	assert(!byte_buffer_append_lz_decompressed(decompressed, byte_view_from_content(compressed)));
+	compressed->buffer[compressed->offset - 1] ^= 1;
+
+	//fixed size buffers without space fail instead of keeping a cut frame
+	ByteBuffer *small = byte_buffer_new(BYTE_BUFFER_TRUNCATE, 100);
+	byte_buffer_clear(small);
+	assert(!byte_buffer_append_lz_compressed(small, byte_view_of(data, 4000)));
+	assert(small->offset == 0);
+	assert(!byte_buffer_append_lz_decompressed(small, byte_view_from_content(compressed)));
+	assert(small->offset == 0);
+
+	byte_buffer_mode_set(small, BYTE_BUFFER_SKIP);
+	assert(!byte_buffer_append_lz_compressed(small, byte_view_of(data, 4000)));
+	assert(small->offset == 0);
+	byte_buffer_free(&small);
+
+	//a stopped decoder keeps its status
+	ByteLzDecoder decoder;
+	ByteLzDecoder *decoderPtr = &decoder;
+	byte_lz_decoder_init(&decoder, decompressed);
+	assert(byte_lz_decoder_write(&decoder, byte_view_of((const unsigned char*)"BLZ2", 4), NULL) == BYTE_LZ_OK);
+	assert(byte_lz_decoder_write(&decoder, byte_view_of((const unsigned char*)"\x10\x00", 2), NULL) == BYTE_LZ_ERROR);
+	assert(byte_lz_decoder_write(&decoder, byte_view_from_content(compressed), NULL) == BYTE_LZ_ERROR);
+	byte_lz_decoder_free(&decoderPtr);
+
+	free(data);
+	byte_buffer_free(&source);
+	byte_buffer_free(&compressed);
+	byte_buffer_free(&decompressed);
+	byte_buffer_free(&empty);
+
+	DEBUG_LOG("<<<\n");
+}
+
+int main(int argc, char **argv) {
+	UNUSED(argc);
+	UNUSED(argv);
+	DEBUG_LOG(">> start byte lz test:\n");
+
+	test_lz_block();
+
+	test_lz_block_damaged();
+
+	test_lz_frame();
+
+	test_lz_allocator();
+
+	test_lz_buffer();
+
+	DEBUG_LOG("<< end byte lz test:\n");
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,300 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+
+#include "defs.h"
+#include "byte_mpmc_queue.h"
+
+#define TEST_MPMC_THREADS 4
+#define TEST_MPMC_RECORDS_PER_PRODUCER 20000
+
+static void test_mpmc_init()
+{
+	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
+
+	ByteMpmcQueue queue;
+	ByteMpmcQueue *queuePtr = &queue;
+
+	assert(byte_mpmc_queue_init_new(queuePtr, 5, 16));
+
+	assert(byte_mpmc_queue_slot_count(queuePtr) == 8);
+	assert(queuePtr->recordSize == 16);
+	assert(queuePtr->storage.size == 8 * 16);
+	assert(queuePtr->allocObj == false);
+
+	byte_mpmc_queue_free(&queuePtr);
+
+	assert(queuePtr->slots == NULL);
+	assert(queuePtr->storage.buffer == NULL);
+
+	ByteMpmcQueue *queueObj = byte_mpmc_queue_new(8, 16);
+
+	assert(queueObj != NULL);
+	assert(queueObj->allocObj == true);
+	assert(byte_mpmc_queue_slot_count(queueObj) == 8);
+
+	byte_mpmc_queue_free(&queueObj);
+
+	assert(queueObj == NULL);
+
+	DEBUG_LOG("<<<\n");
+}
+
+static size_t testCntAllocs = 0;
+static size_t testCntFrees = 0;
+
+static void* __test_mpmc_counting_alloc(void* ctx, size_t size)
+{
+	(void)ctx;
+	testCntAllocs++;
+	return malloc(size);
+}
+
+static void __test_mpmc_counting_free(void* ctx, void* ptr)
+{
+	(void)ctx;
+	if (ptr) testCntFrees++;
+	free(ptr);
+}
+
+static void test_mpmc_allocator()
+{
+	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
+
+	MemAllocator counting = *mem_allocator_default();
+	counting.alloc = __test_mpmc_counting_alloc;
+	counting.free = __test_mpmc_counting_free;
+	mem_allocator_set(&counting);
+
+	ByteMpmcQueue *queue = byte_mpmc_queue_new(4, 16);
+	assert(queue->storage.allocator == &counting);
+
+	mem_allocator_set(NULL);
+
+	//object, slots and records go back to the allocator of the queue, not the current one
+	byte_mpmc_queue_free(&queue);
+
+	assert(testCntAllocs == 3);
+	assert(testCntFrees == 3);
+
+	DEBUG_LOG("<<<\n");
+}
+
+static void test_mpmc_push_pop()
+{
+	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
+
+	ByteMpmcQueue *queue = byte_mpmc_queue_new(4, 8);
+
+	unsigned char rawBuffer[20];
+	ByteBuffer dest;
+	byte_buffer_init(&dest, BYTE_BUFFER_TRUNCATE, &rawBuffer[0], 20);
+
+	assert(byte_mpmc_queue_pop(queue, &dest) == false);
+
+	assert(byte_mpmc_queue_push(queue, (unsigned char *)"A", 1));
+	assert(byte_mpmc_queue_push(queue, (unsigned char *)"BB", 2));
+	assert(byte_mpmc_queue_push(queue, (unsigned char *)"CCC", 3));
+	assert(byte_mpmc_queue_push(queue, (unsigned char *)"DDDDDDDD", 8));
+
+	//full and record too large
+	assert(byte_mpmc_queue_push(queue, (unsigned char *)"E", 1) == false);
+	assert(byte_mpmc_queue_push(queue, (unsigned char *)"FFFFFFFFF", 9) == false);
+
+	assert(byte_mpmc_queue_pop(queue, &dest));
+	assert(byte_mpmc_queue_pop(queue, &dest));
+
+	assert(dest.offset == 3);
+	assert(memcmp(dest.buffer, "ABB", 3) == 0);
+
+	//slots are reused in the next round
+	assert(byte_mpmc_queue_push(queue, (unsigned char *)"GG", 2));
+	assert(byte_mpmc_queue_push(queue, (unsigned char *)"H", 1));
+	assert(byte_mpmc_queue_push(queue, (unsigned char *)"I", 1) == false);
+
+	while (byte_mpmc_queue_pop(queue, &dest));
+
+	assert(dest.offset == 17);
+	assert(memcmp(dest.buffer, "ABBCCCDDDDDDDDGGH", 17) == 0);
+
+	byte_mpmc_queue_free(&queue);
+
+	DEBUG_LOG("<<<\n");
+}
+
+static void test_mpmc_reserve_acquire()
+{
+	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
+
+	ByteMpmcQueue *queue = byte_mpmc_queue_new(2, 8);
+
+	ByteMpmcReservation first;
+	ByteMpmcReservation second;
+	ByteMpmcReservation read;
+
+	unsigned char *firstData = byte_mpmc_queue_reserve(queue, 3, &first);
+	unsigned char *secondData = byte_mpmc_queue_reserve(queue, 2, &second);
+
+	assert(firstData != NULL);
+	assert(secondData != NULL);
+	assert(firstData != secondData);
+	assert(byte_mpmc_queue_reserve(queue, 1, &read) == NULL);
+
+	//commit out of order, the consumer waits for the first record
+	memcpy(secondData, "YY", 2);
+	byte_mpmc_queue_commit(queue, &second);
+
+	assert(byte_mpmc_queue_acquire(queue, &read) == NULL);
+
+	memcpy(firstData, "XXX", 3);
+	byte_mpmc_queue_commit(queue, &first);
+
+	const unsigned char *data = byte_mpmc_queue_acquire(queue, &read);
+
+	assert(data == firstData);
+	assert(read.length == 3);
+	assert(memcmp(data, "XXX", 3) == 0);
+
+	byte_mpmc_queue_release(queue, &read);
+
+	data = byte_mpmc_queue_acquire(queue, &read);
+
+	assert(read.length == 2);
+	assert(memcmp(data, "YY", 2) == 0);
+
+	byte_mpmc_queue_release(queue, &read);
+
+	assert(byte_mpmc_queue_acquire(queue, &read) == NULL);
+
+	byte_mpmc_queue_free(&queue);
+
+	DEBUG_LOG("<<<\n");
+}
+
+typedef struct 
+{
+	ByteMpmcQueue *queue;
+	unsigned char producerId;
+	size_t cntRecords;
+	size_t lastSeen[TEST_MPMC_THREADS];
+} TestMpmcThread;
+
+static void* __test_mpmc_producer(void* _thread)
+{
+	TestMpmcThread* thread = _thread;
+	unsigned char record[16];
+	memset(&record[0], 'P', sizeof(record));
+
+	//variable length records: producer id, sequence and up to 4 padding bytes
+	for (size_t curRecord = 1; curRecord <= TEST_MPMC_RECORDS_PER_PRODUCER; curRecord++)
+	{
+		record[0] = thread->producerId;
+		memcpy(&record[1], &curRecord, sizeof(size_t));
+
+		while (!byte_mpmc_queue_push(thread->queue, &record[0], 1 + sizeof(size_t) + (curRecord % 5)))
+		{
+			sched_yield();
+		}
+	}
+
+	return NULL;
+}
+
+static void* __test_mpmc_consumer(void* _thread)
+{
+	TestMpmcThread* thread = _thread;
+	ByteMpmcReservation reservation;
+	size_t cntTotal = TEST_MPMC_THREADS * TEST_MPMC_RECORDS_PER_PRODUCER;
+
+	static atomic_size_t cntConsumed;
+
+	while (atomic_load(&cntConsumed) < cntTotal)
+	{
+		const unsigned char *data = byte_mpmc_queue_acquire(thread->queue, &reservation);
+		if (!data) 
+		{
+			sched_yield();
+			continue;
+		}
+
+		size_t curRecord = 0;
+		memcpy(&curRecord, data + 1, sizeof(size_t));
+
+		//records of one producer are seen in order by every consumer
+		assert(data[0] < TEST_MPMC_THREADS);
+		assert(reservation.length == 1 + sizeof(size_t) + (curRecord % 5));
+		assert(curRecord > thread->lastSeen[data[0]]);
+		thread->lastSeen[data[0]] = curRecord;
+		thread->cntRecords++;
+
+		byte_mpmc_queue_release(thread->queue, &reservation);
+		atomic_fetch_add(&cntConsumed, 1);
+	}
+
+	return NULL;
+}
+
+static void test_mpmc_threads()
+{
+	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
+
+	ByteMpmcQueue *queue = byte_mpmc_queue_new(64, 16);
+
+	pthread_t producers[TEST_MPMC_THREADS];
+	pthread_t consumers[TEST_MPMC_THREADS];
+	TestMpmcThread producerData[TEST_MPMC_THREADS];
+	TestMpmcThread consumerData[TEST_MPMC_THREADS];
+
+	memset(&consumerData[0], 0, sizeof(consumerData));
+
+	for (size_t curThread = 0; curThread < TEST_MPMC_THREADS; curThread++)
+	{
+		producerData[curThread].queue = queue;
+		producerData[curThread].producerId = (unsigned char)curThread;
+		consumerData[curThread].queue = queue;
+
+		pthread_create(&producers[curThread], NULL, __test_mpmc_producer, &producerData[curThread]);
+		pthread_create(&consumers[curThread], NULL, __test_mpmc_consumer, &consumerData[curThread]);
+	}
+
+	size_t cntRecords = 0;
+
+	for (size_t curThread = 0; curThread < TEST_MPMC_THREADS; curThread++)
+	{
+		pthread_join(producers[curThread], NULL);
+		pthread_join(consumers[curThread], NULL);
+		cntRecords += consumerData[curThread].cntRecords;
+	}
+
+	assert(cntRecords == TEST_MPMC_THREADS * TEST_MPMC_RECORDS_PER_PRODUCER);
+
+	ByteMpmcReservation reservation;
+	assert(byte_mpmc_queue_acquire(queue, &reservation) == NULL);
+
+	byte_mpmc_queue_free(&queue);
+
+	DEBUG_LOG("<<<\n");
+}
+
+int main(int argc, char **argv) {
+	UNUSED(argc);
+	UNUSED(argv);
+	DEBUG_LOG(">> start byte mpmc queue test:\n");
+
+	test_mpmc_init();
+
+	test_mpmc_allocator();
+
+	test_mpmc_push_pop();
+
+	test_mpmc_reserve_acquire();
+
+	test_mpmc_threads();
+
+	DEBUG_LOG("<< end byte mpmc queue test:\n");
+
+	return 0;
+}
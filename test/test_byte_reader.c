@@ -0,0 +1,141 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "defs.h"
+#include "byte_reader.h"
+#include "byte_varint.h"
+
+static void test_reader_typed()
+{
+	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
+
+	ByteBuffer *buffer = byte_buffer_new(BYTE_BUFFER_TRUNCATE, 64);
+	byte_buffer_fill_complete(buffer, 'X');
+
+	byte_buffer_append_byte(buffer, 7);
+	byte_buffer_put_u16_le(buffer, 0x0102);
+	byte_buffer_put_u32_be(buffer, 0x01020304);
+	byte_buffer_put_u64_le(buffer, 0x0102030405060708ULL);
+	byte_buffer_put_f32_be(buffer, 1.5f);
+	byte_buffer_put_f64_le(buffer, -2.25);
+	byte_buffer_put_uvarint(buffer, 300);
+	byte_buffer_put_svarint(buffer, -3);
+	byte_buffer_append_bytes(buffer, (unsigned char *)"HELLO", 5);
+
+	ByteBufferReader reader;
+	byte_reader_init(&reader, buffer);
+
+	//only written bytes are readable
+	assert(byte_reader_remaining(&reader) == 35);
+
+	uint8_t u8 = 0;
+	uint16_t u16 = 0;
+	uint32_t u32 = 0;
+	uint64_t u64 = 0;
+	int64_t s64 = 0;
+	float f32 = 0.f;
+	double f64 = 0.;
+
+	assert(byte_reader_ensure(&reader, 35));
+	assert(!byte_reader_ensure(&reader, 36));
+
+	assert(byte_reader_read_u8(&reader, &u8) && u8 == 7);
+	assert(byte_reader_read_u16_le(&reader, &u16) && u16 == 0x0102);
+	assert(byte_reader_read_u32_be(&reader, &u32) && u32 == 0x01020304);
+	assert(byte_reader_read_u64_le(&reader, &u64) && u64 == 0x0102030405060708ULL);
+	assert(byte_reader_read_f32_be(&reader, &f32) && f32 == 1.5f);
+	assert(byte_reader_read_f64_le(&reader, &f64) && f64 == -2.25);
+	assert(byte_reader_read_uvarint(&reader, &u64) && u64 == 300);
+	assert(byte_reader_read_svarint(&reader, &s64) && s64 == -3);
+
+	assert(byte_reader_position(&reader) == 30);
+
+	//slices point into the buffer
+	const unsigned char *slice = NULL;
+	assert(byte_reader_read_slice(&reader, 2, &slice));
+	assert(slice == &buffer->buffer[30]);
+	assert(memcmp(slice, "HE", 2) == 0);
+
+	ByteView restView = byte_reader_rest(&reader);
+	assert(restView.ptr == &buffer->buffer[32] && restView.len == 3);
+
+	unsigned char rest[4] = { 0 };
+	assert(!byte_reader_read_bytes(&reader, &rest[0], 4));
+	assert(byte_reader_position(&reader) == 32);
+	assert(byte_reader_read_bytes(&reader, &rest[0], 3));
+	assert(memcmp(rest, "LLO", 3) == 0);
+
+	//end reached, reads fail without moving
+	assert(byte_reader_remaining(&reader) == 0);
+	assert(!byte_reader_read_u8(&reader, &u8));
+	assert(!byte_reader_read_u16_be(&reader, &u16));
+	assert(!byte_reader_read_uvarint(&reader, &u64));
+	assert(byte_reader_position(&reader) == 35);
+
+	assert(byte_reader_seek(&reader, 1));
+	assert(byte_reader_read_u16_le(&reader, &u16) && u16 == 0x0102);
+	assert(byte_reader_skip(&reader, 4));
+	assert(byte_reader_position(&reader) == 7);
+	assert(!byte_reader_skip(&reader, 32));
+	assert(!byte_reader_seek(&reader, 36));
+	assert(byte_reader_position(&reader) == 7);
+
+	byte_buffer_free(&buffer);
+
+	DEBUG_LOG("<<<\n");
+}
+
+static void test_reader_bytes()
+{
+	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
+
+	//length prefixed records, one range check per record
+	unsigned char records[] = { 0, 3, 'A', 'B', 'C', 0, 1, 'D', 0, 5, 'E' };
+
+	ByteBufferReader reader;
+	byte_reader_init_bytes(&reader, &records[0], sizeof(records));
+
+	uint16_t length = 0;
+	const unsigned char *payload = NULL;
+	size_t cntRecords = 0;
+
+	while (byte_reader_read_u16_be(&reader, &length) && byte_reader_read_slice(&reader, length, &payload))
+	{
+		cntRecords++;
+	}
+
+	assert(cntRecords == 2);
+	assert(length == 5);
+	assert(memcmp(payload, "D", 1) == 0);
+	assert(byte_reader_remaining(&reader) == 1);
+
+	ByteView view;
+	assert(byte_reader_seek(&reader, 2));
+	assert(byte_reader_read_view(&reader, 3, &view));
+	assert(byte_view_equals(view, byte_view_of((const unsigned char *)"ABC", 3)));
+	assert(!byte_reader_read_view(&reader, 7, &view));
+
+	//empty
+	byte_reader_init(&reader, NULL);
+	assert(byte_reader_remaining(&reader) == 0);
+	assert(!byte_reader_read_u8(&reader, (uint8_t*)&length));
+
+	DEBUG_LOG("<<<\n");
+}
+
+int main(int argc, char **argv) {
+	UNUSED(argc);
+	UNUSED(argv);
+	DEBUG_LOG(">> start byte reader test:\n");
+
+	test_reader_typed();
+
+	test_reader_bytes();
+
+	DEBUG_LOG("<< end byte reader test:\n");
+
+	return 0;
+}
\ No newline at end of file
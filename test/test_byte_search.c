@@ -0,0 +1,165 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "defs.h"
+#include "cpu_utils.h"
+#include "byte_search.h"
+#include "test_utils.h"
+
+#define TEST_SEARCH_ROUNDS 20000
+#define TEST_SEARCH_MAX_SIZE 300
+
+static uint64_t testSearchState = TEST_RANDOM_SEED;
+
+static size_t __test_search_naive_bytes(const unsigned char* data, size_t size, const unsigned char* needle, size_t cntNeedle, bool reverse)
+{
+	if (cntNeedle > size) return BYTE_SEARCH_NOT_FOUND;
+
+	size_t found = BYTE_SEARCH_NOT_FOUND;
+	for (size_t pos = 0; pos + cntNeedle <= size; pos++)
+	{
+		if (memcmp(data + pos, needle, cntNeedle) == 0)
+		{
+			found = pos;
+			if (!reverse) break;
+		}
+	}
+
+	return found;
+}
+
+static size_t __test_search_naive_any(const unsigned char* data, size_t size, const unsigned char* set, size_t cntSet, bool reverse)
+{
+	size_t found = BYTE_SEARCH_NOT_FOUND;
+	for (size_t pos = 0; pos < size; pos++)
+	{
+		if (cntSet > 0 && memchr(set, data[pos], cntSet))
+		{
+			found = pos;
+			if (!reverse) break;
+		}
+	}
+
+	return found;
+}
+
+static void test_search_buffer()
+{
+	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
+
+	ByteBuffer *buffer = byte_buffer_new(BYTE_BUFFER_GROW, 64);
+	byte_buffer_clear(buffer);
+	byte_buffer_append_bytes(buffer, (unsigned char *)"GET /index.html HTTP/1.1\r\nHost: x\r\n\r\nBODY", 41);
+
+	assert(byte_buffer_find_byte(buffer, 0, ' ') == 3);
+	assert(byte_buffer_find_byte(buffer, 4, ' ') == 15);
+	assert(byte_buffer_rfind_byte(buffer, SIZE_MAX, ' ') == 31);
+	assert(byte_buffer_rfind_byte(buffer, 31, ' ') == 15);
+	assert(byte_buffer_find_byte(buffer, 0, '#') == BYTE_SEARCH_NOT_FOUND);
+	assert(byte_buffer_find_byte(buffer, 100, 'G') == BYTE_SEARCH_NOT_FOUND);
+
+	//only the written content is searched
+	assert(byte_buffer_find_byte(buffer, 0, 0) == BYTE_SEARCH_NOT_FOUND);
+
+	assert(byte_buffer_find_bytes(buffer, 0, (unsigned char *)"\r\n\r\n", 4) == 33);
+	assert(byte_buffer_find_bytes(buffer, 0, (unsigned char *)"\r\n", 2) == 24);
+	assert(byte_buffer_find_bytes(buffer, 25, (unsigned char *)"\r\n", 2) == 33);
+	assert(byte_buffer_rfind_bytes(buffer, SIZE_MAX, (unsigned char *)"\r\n", 2) == 35);
+	assert(byte_buffer_rfind_bytes(buffer, 36, (unsigned char *)"\r\n", 2) == 33);
+	assert(byte_buffer_find_bytes(buffer, 0, (unsigned char *)"BODY!", 5) == BYTE_SEARCH_NOT_FOUND);
+	assert(byte_buffer_find_bytes(buffer, 7, NULL, 0) == 7);
+
+	assert(byte_buffer_find_any_of(buffer, 0, (unsigned char *)"\r\n:", 3) == 24);
+	assert(byte_buffer_rfind_any_of(buffer, SIZE_MAX, (unsigned char *)"\r\n:", 3) == 36);
+	assert(byte_buffer_find_any_of(buffer, 0, NULL, 0) == BYTE_SEARCH_NOT_FOUND);
+
+	byte_buffer_free(&buffer);
+
+	DEBUG_LOG("<<<\n");
+}
+
+//every kernel against the naive search, with few distinct bytes for many partial matches
+static void __test_search_random_views(unsigned disabledFeatures)
+{
+	unsigned char data[TEST_SEARCH_MAX_SIZE + 16];
+	unsigned char needle[8];
+	unsigned char set[24];
+
+	cpu_features_disable(disabledFeatures);
+
+	for (size_t curRound = 0; curRound < TEST_SEARCH_ROUNDS; curRound++)
+	{
+		size_t start = test_random_next(&testSearchState) % 16;
+		size_t size = test_random_next(&testSearchState) % TEST_SEARCH_MAX_SIZE;
+		unsigned char alphabet = (unsigned char)(2 + test_random_next(&testSearchState) % 6);
+		unsigned char base = (unsigned char)(test_random_next(&testSearchState) & 0xFF);
+
+		for (size_t curByte = 0; curByte < start + size; curByte++)
+		{
+			data[curByte] = (unsigned char)(base + test_random_next(&testSearchState) % alphabet);
+		}
+
+		size_t cntNeedle = 1 + test_random_next(&testSearchState) % sizeof(needle);
+		for (size_t curByte = 0; curByte < cntNeedle; curByte++)
+		{
+			needle[curByte] = (unsigned char)(base + test_random_next(&testSearchState) % alphabet);
+		}
+
+		size_t cntSet = test_random_next(&testSearchState) % sizeof(set);
+		for (size_t curByte = 0; curByte < cntSet; curByte++)
+		{
+			set[curByte] = (unsigned char)test_random_next(&testSearchState);
+		}
+		if (cntSet > 0) set[0] = (unsigned char)(base + alphabet + test_random_next(&testSearchState) % 2);
+
+		//sometimes the set byte occurs once
+		if (size > 0 && cntSet > 0 && (curRound & 1)) data[start + test_random_next(&testSearchState) % size] = set[0];
+
+		ByteView view = byte_view_of(data + start, size);
+		const unsigned char* bytes = data + start;
+
+		assert(byte_view_find_byte(view, needle[0]) == __test_search_naive_bytes(bytes, size, needle, 1, false));
+		assert(byte_view_rfind_byte(view, needle[0]) == __test_search_naive_bytes(bytes, size, needle, 1, true));
+		assert(byte_view_find_bytes(view, byte_view_of(needle, cntNeedle)) == __test_search_naive_bytes(bytes, size, needle, cntNeedle, false));
+		assert(byte_view_rfind_bytes(view, byte_view_of(needle, cntNeedle)) == __test_search_naive_bytes(bytes, size, needle, cntNeedle, true));
+		assert(byte_view_find_any_of(view, byte_view_of(set, cntSet)) == __test_search_naive_any(bytes, size, set, cntSet, false));
+		assert(byte_view_rfind_any_of(view, byte_view_of(set, cntSet)) == __test_search_naive_any(bytes, size, set, cntSet, true));
+	}
+
+	cpu_features_disable(0);
+}
+
+static void test_search_kernels()
+{
+	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
+
+	__test_search_random_views(0);
+	__test_search_random_views(CPU_FEATURE_AVX2);
+	__test_search_random_views(CPU_FEATURE_AVX2 | CPU_FEATURE_SSSE3);
+	__test_search_random_views(~0U);
+
+	//empty needle is found at both ends
+	ByteView view = byte_view_of((unsigned char *)"abc", 3);
+	assert(byte_view_find_bytes(view, byte_view_of(NULL, 0)) == 0);
+	assert(byte_view_rfind_bytes(view, byte_view_of(NULL, 0)) == 3);
+	assert(byte_view_find_byte(byte_view_of(NULL, 0), 'a') == BYTE_SEARCH_NOT_FOUND);
+
+	DEBUG_LOG("<<<\n");
+}
+
+int main(int argc, char **argv) {
+	UNUSED(argc);
+	UNUSED(argv);
+	DEBUG_LOG(">> start byte search test:\n");
+
+	test_search_buffer();
+
+	test_search_kernels();
+
+	DEBUG_LOG("<< end byte search test:\n");
+
+	return 0;
+}
\ No newline at end of file
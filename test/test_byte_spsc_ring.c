@@ -0,0 +1,303 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+
+#include "defs.h"
+#include "byte_spsc_ring.h"
+
+#define TEST_SPSC_TRANSFER_BYTES ((size_t)1024 * 1024)
+
+static void test_spsc_init()
+{
+	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
+
+	unsigned char rawBuffer[20];
+	size_t buffSize = 20;
+
+	ByteSpscRing ring;
+	ByteSpscRing *ringPtr = &ring;
+
+	byte_spsc_ring_init(ringPtr, &rawBuffer[0], buffSize);
+
+	assert(ringPtr->storage.buffer == &rawBuffer[0]);
+	assert(ringPtr->storage.alloc == false);
+	assert(byte_spsc_ring_capacity(ringPtr) == buffSize);
+	assert(byte_spsc_ring_readable(ringPtr) == 0);
+	assert(byte_spsc_ring_writable(ringPtr) == buffSize);
+
+	byte_spsc_ring_free(&ringPtr);
+
+	assert(ringPtr->storage.buffer == NULL);
+
+	byte_spsc_ring_init_new(ringPtr, buffSize);
+
+	assert(ringPtr->storage.buffer != NULL);
+	assert(ringPtr->storage.alloc == true);
+	assert(ringPtr->allocObj == false);
+
+	byte_spsc_ring_free(&ringPtr);
+
+	ByteSpscRing *ringObj = byte_spsc_ring_new(buffSize);
+
+	assert(ringObj->storage.buffer != NULL);
+	assert(ringObj->allocObj == true);
+	assert(byte_spsc_ring_capacity(ringObj) == buffSize);
+
+	byte_spsc_ring_free(&ringObj);
+
+	assert(ringObj == NULL);
+
+	DEBUG_LOG("<<<\n");
+}
+
+static size_t testCntAllocs = 0;
+static size_t testCntFrees = 0;
+
+static void* __test_spsc_counting_alloc(void* ctx, size_t size)
+{
+	(void)ctx;
+	testCntAllocs++;
+	return malloc(size);
+}
+
+static void __test_spsc_counting_free(void* ctx, void* ptr)
+{
+	(void)ctx;
+	if (ptr) testCntFrees++;
+	free(ptr);
+}
+
+static void test_spsc_allocator()
+{
+	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
+
+	MemAllocator counting = *mem_allocator_default();
+	counting.alloc = __test_spsc_counting_alloc;
+	counting.free = __test_spsc_counting_free;
+	mem_allocator_set(&counting);
+
+	ByteSpscRing *ring = byte_spsc_ring_new(16);
+	assert(ring->storage.allocator == &counting);
+
+	mem_allocator_set(NULL);
+
+	//storage and object go back to the allocator of the ring, not the current one
+	assert(byte_spsc_ring_write(ring, (unsigned char *)"RING", 4) == 4);
+	byte_spsc_ring_free(&ring);
+
+	assert(testCntAllocs == 2);
+	assert(testCntFrees == 2);
+
+	DEBUG_LOG("<<<\n");
+}
+
+static void test_spsc_write_read()
+{
+	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
+
+	unsigned char rawBuffer[10];
+	size_t buffSize = 10;
+	unsigned char readBuffer[20];
+
+	ByteSpscRing ring;
+
+	byte_spsc_ring_init(&ring, &rawBuffer[0], buffSize);
+
+	assert(byte_spsc_ring_write(&ring, (unsigned char *)"0123456", 7) == 7);
+	assert(byte_spsc_ring_readable(&ring) == 7);
+
+	//only 3 bytes left
+	assert(byte_spsc_ring_write(&ring, (unsigned char *)"ABCDEF", 6) == 3);
+	assert(byte_spsc_ring_writable(&ring) == 0);
+	assert(byte_spsc_ring_write(&ring, (unsigned char *)"X", 1) == 0);
+
+	assert(byte_spsc_ring_read(&ring, &readBuffer[0], 4) == 4);
+	assert(memcmp(&readBuffer[0], "0123", 4) == 0);
+
+	//write wraps around the end
+	assert(byte_spsc_ring_write(&ring, (unsigned char *)"GHIJ", 4) == 4);
+	assert(memcmp(&rawBuffer[0], "GHIJ456ABC", 10) == 0);
+
+	assert(byte_spsc_ring_read(&ring, &readBuffer[0], 20) == 10);
+	assert(memcmp(&readBuffer[0], "456ABCGHIJ", 10) == 0);
+	assert(byte_spsc_ring_readable(&ring) == 0);
+	assert(byte_spsc_ring_read(&ring, &readBuffer[0], 20) == 0);
+
+	//positions wrap at twice the capacity and keep the data in order for sizes other than a power of two
+	for (size_t curRound = 0; curRound < 50; curRound++)
+	{
+		unsigned char chunk[7];
+		for (size_t curByte = 0; curByte < sizeof(chunk); curByte++)
+		{
+			chunk[curByte] = (unsigned char)(curRound * sizeof(chunk) + curByte);
+		}
+
+		assert(byte_spsc_ring_write(&ring, &chunk[0], sizeof(chunk)) == sizeof(chunk));
+		assert(byte_spsc_ring_readable(&ring) == sizeof(chunk));
+		assert(byte_spsc_ring_writable(&ring) == buffSize - sizeof(chunk));
+		assert(byte_spsc_ring_read(&ring, &readBuffer[0], 20) == sizeof(chunk));
+		assert(memcmp(&readBuffer[0], &chunk[0], sizeof(chunk)) == 0);
+
+		assert(atomic_load(&ring.head) < 2 * buffSize);
+		assert(atomic_load(&ring.tail) == atomic_load(&ring.head));
+	}
+
+	DEBUG_LOG("<<<\n");
+}
+
+static void test_spsc_peek_commit()
+{
+	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
+
+	unsigned char rawBuffer[10];
+	size_t buffSize = 10;
+
+	ByteSpscRing ring;
+
+	byte_spsc_ring_init(&ring, &rawBuffer[0], buffSize);
+
+	unsigned char *space = NULL;
+	const unsigned char *data = NULL;
+
+	//reserve gives the contiguous space until the end
+	assert(byte_spsc_ring_reserve(&ring, &space) == 10);
+	assert(space == &rawBuffer[0]);
+	memcpy(space, "01234567", 8);
+	byte_spsc_ring_publish(&ring, 8);
+
+	assert(byte_spsc_ring_peek(&ring, &data) == 8);
+	assert(data == &rawBuffer[0]);
+	assert(memcmp(data, "01234567", 8) == 0);
+
+	//peek does not consume
+	assert(byte_spsc_ring_peek(&ring, &data) == 8);
+	byte_spsc_ring_commit(&ring, 6);
+
+	assert(byte_spsc_ring_readable(&ring) == 2);
+
+	//reserve is limited by the end of storage
+	assert(byte_spsc_ring_reserve(&ring, &space) == 2);
+	assert(space == &rawBuffer[8]);
+	memcpy(space, "89", 2);
+	byte_spsc_ring_publish(&ring, 2);
+
+	assert(byte_spsc_ring_reserve(&ring, &space) == 6);
+	assert(space == &rawBuffer[0]);
+	memcpy(space, "AB", 2);
+	byte_spsc_ring_publish(&ring, 2);
+
+	//peek is limited by the end of storage too
+	assert(byte_spsc_ring_peek(&ring, &data) == 4);
+	assert(memcmp(data, "6789", 4) == 0);
+	byte_spsc_ring_commit(&ring, 4);
+
+	assert(byte_spsc_ring_peek(&ring, &data) == 2);
+	assert(memcmp(data, "AB", 2) == 0);
+	byte_spsc_ring_commit(&ring, 2);
+
+	assert(byte_spsc_ring_peek(&ring, &data) == 0);
+
+	DEBUG_LOG("<<<\n");
+}
+
+static void* __test_spsc_producer(void* _ring)
+{
+	ByteSpscRing* ring = _ring;
+	unsigned char chunk[97];
+	size_t written = 0;
+
+	while (written < TEST_SPSC_TRANSFER_BYTES)
+	{
+		size_t cntChunk = 1 + (written % sizeof(chunk));
+		if (cntChunk > TEST_SPSC_TRANSFER_BYTES - written) cntChunk = TEST_SPSC_TRANSFER_BYTES - written;
+
+		for (size_t curByte = 0; curByte < cntChunk; curByte++)
+		{
+			chunk[curByte] = (unsigned char)((written + curByte) % 251);
+		}
+
+		size_t sent = 0;
+		while (sent < cntChunk)
+		{
+			size_t cntWritten = byte_spsc_ring_write(ring, &chunk[sent], cntChunk - sent);
+			if (cntWritten == 0) sched_yield();
+			sent += cntWritten;
+		}
+
+		written += cntChunk;
+	}
+
+	return NULL;
+}
+
+static void test_spsc_threads()
+{
+	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
+
+	ByteSpscRing *ring = byte_spsc_ring_new(1000);
+	pthread_t producer;
+
+	pthread_create(&producer, NULL, __test_spsc_producer, ring);
+
+	size_t received = 0;
+	unsigned char readBuffer[61];
+
+	while (received < TEST_SPSC_TRANSFER_BYTES)
+	{
+		//alternate between copying and in place reads
+		if (received % 2)
+		{
+			size_t cntRead = byte_spsc_ring_read(ring, &readBuffer[0], sizeof(readBuffer));
+			if (cntRead == 0) sched_yield();
+
+			for (size_t curByte = 0; curByte < cntRead; curByte++, received++)
+			{
+				assert(readBuffer[curByte] == (unsigned char)(received % 251));
+			}
+		}
+		else
+		{
+			const unsigned char *data = NULL;
+			size_t cntRead = byte_spsc_ring_peek(ring, &data);
+			if (cntRead == 0) sched_yield();
+
+			for (size_t curByte = 0; curByte < cntRead; curByte++, received++)
+			{
+				assert(data[curByte] == (unsigned char)(received % 251));
+			}
+
+			byte_spsc_ring_commit(ring, cntRead);
+		}
+	}
+
+	pthread_join(producer, NULL);
+
+	assert(byte_spsc_ring_readable(ring) == 0);
+
+	byte_spsc_ring_free(&ring);
+
+	DEBUG_LOG("<<<\n");
+}
+
+int main(int argc, char **argv) {
+	UNUSED(argc);
+	UNUSED(argv);
+	DEBUG_LOG(">> start byte spsc ring test:\n");
+
+	test_spsc_init();
+
+	test_spsc_allocator();
+
+	test_spsc_write_read();
+
+	test_spsc_peek_commit();
+
+	test_spsc_threads();
+
+	DEBUG_LOG("<< end byte spsc ring test:\n");
+
+	return 0;
+}
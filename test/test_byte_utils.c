@@ -727,6 +727,65 @@ static void test_bb_append_bytes_ring()
 	DEBUG_LOG("<<<\n");
 }
 
+static void test_bb_append_bytes_ring_bulk()
+{
+	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
+
+	unsigned char bytes[50];
+	for (size_t curByte = 0; curByte < 50; curByte++)
+	{
+		bytes[curByte] = (unsigned char)('a' + (curByte % 26));
+	}
+
+	unsigned char rawBuffer[20];
+	unsigned char rawExpected[20];
+	size_t buffSize = 20;
+
+	ByteBuffer buffer;
+	ByteBuffer expected;
+
+	byte_buffer_init(&buffer, BYTE_BUFFER_RING, &rawBuffer[0], buffSize);
+	byte_buffer_init(&expected, BYTE_BUFFER_RING, &rawExpected[0], buffSize);
+
+	//bulk append must be equal to appending byte by byte for every start offset and length
+	for (size_t startOffset = 0; startOffset <= buffSize + 1; startOffset++)
+	{
+		for (size_t cntBytes = 0; cntBytes <= 50; cntBytes++)
+		{
+			byte_buffer_clear(&buffer);
+			byte_buffer_clear(&expected);
+
+			buffer.offset = startOffset;
+			expected.offset = startOffset;
+
+			byte_buffer_append_bytes(&buffer, &bytes[0], cntBytes);
+
+			for (size_t curByte = 0; curByte < cntBytes; curByte++)
+			{
+				byte_buffer_append_byte(&expected, bytes[curByte]);
+			}
+
+			assert(buffer.offset == expected.offset);
+			__test_bb_equals(&buffer, expected.buffer);
+		}
+	}
+
+	//input larger than the ring keeps the last 20 bytes
+	byte_buffer_clear(&buffer);
+	byte_buffer_append_bytes(&buffer, (unsigned char *)"0123", 4);
+	byte_buffer_append_bytes(&buffer, &bytes[0], 50);
+
+	assert(buffer.offset == 14);
+	__test_bb_equals(&buffer, (unsigned char *)"klmnopqrstuvwxefghij");
+
+	#ifdef debug
+	printf("RING bulk:");
+	__test_bb_print_buffer(&rawBuffer[0], buffSize);
+	#endif
+
+	DEBUG_LOG("<<<\n");
+}
+
 static void test_bb_replace_byte()
 {
 	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
@@ -876,6 +935,90 @@ static void test_bb_insert_bytes()
 	DEBUG_LOG("<<<\n");
 }
 
+static void test_bb_insert_bytes_skip()
+{
+	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
+
+	unsigned char rawBuffer[20];
+	size_t buffSize = 20;
+	
+	ByteBuffer buffer;
+
+	byte_buffer_init(&buffer, BYTE_BUFFER_SKIP, &rawBuffer[0], buffSize);
+	
+	byte_buffer_fill_range(&buffer, 0, 5, 'A');
+	byte_buffer_fill_range(&buffer, 5, 5, 'B');
+	byte_buffer_fill_range(&buffer, 10, 5, 'C');
+	byte_buffer_fill_range(&buffer, 15, 5, 'D');
+
+	//the moved rest never fits, so SKIP only writes the inserted bytes
+	byte_buffer_insert_bytes(&buffer, 3, (unsigned char *)"XYZ", 3);
+	byte_buffer_insert_byte(&buffer, 19, 'E');
+	byte_buffer_insert_bytes(&buffer, 15, (unsigned char *)"0123456789", 10);
+	byte_buffer_prepend_bytes(&buffer, (unsigned char *)"FG", 2);
+	byte_buffer_insert_bytes_fmt(&buffer, 17, "[%d]", 42);
+	byte_buffer_prepend_byte(&buffer, 'H');
+
+	__test_bb_equals(&buffer, (unsigned char *)"HGAXYZBBBBCCCCCDDDDE");
+	assert(buffer.offset == 0);
+
+	#ifdef debug
+	printf("insert bytes SKIP:");
+	__test_bb_print_buffer(&rawBuffer[0], buffSize);
+	#endif
+
+	DEBUG_LOG("<<<\n");
+}
+
+static void test_bb_insert_bytes_ring()
+{
+	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
+
+	unsigned char rawBuffer[20];
+	size_t buffSize = 20;
+	
+	ByteBuffer buffer;
+
+	byte_buffer_init(&buffer, BYTE_BUFFER_RING, &rawBuffer[0], buffSize);
+	
+	byte_buffer_fill_range(&buffer, 0, 5, 'A');
+	byte_buffer_fill_range(&buffer, 5, 5, 'B');
+	byte_buffer_fill_range(&buffer, 10, 5, 'C');
+	byte_buffer_fill_range(&buffer, 15, 5, 'D');
+
+	//bytes moved out at the end come back at the beginning
+	byte_buffer_insert_bytes(&buffer, 3, (unsigned char *)"XYZ", 3);
+
+	__test_bb_equals(&buffer, (unsigned char *)"DDDXYZAABBBBBCCCCCDD");
+
+	byte_buffer_insert_byte(&buffer, 19, 'E');
+
+	__test_bb_equals(&buffer, (unsigned char *)"DDDXYZAABBBBBCCCCCDE");
+
+	byte_buffer_insert_bytes(&buffer, 15, (unsigned char *)"0123456789", 10);
+
+	__test_bb_equals(&buffer, (unsigned char *)"56789CCCDEBBBCC01234");
+
+	byte_buffer_prepend_bytes(&buffer, (unsigned char *)"FG", 2);
+	byte_buffer_insert_bytes_fmt(&buffer, 17, "[%d]", 42);
+	byte_buffer_prepend_byte(&buffer, 'H');
+
+	__test_bb_equals(&buffer, (unsigned char *)"2]012789CCCDEBBBCC[4");
+
+	//more bytes than the buffer size
+	byte_buffer_insert_bytes(&buffer, 0, (unsigned char *)"abcdefghijklmnopqrstuvwxyz", 26);
+
+	__test_bb_equals(&buffer, (unsigned char *)"BBCC[42]012789CCCDEB");
+	assert(buffer.offset == 0);
+
+	#ifdef debug
+	printf("insert bytes RING:");
+	__test_bb_print_buffer(&rawBuffer[0], buffSize);
+	#endif
+
+	DEBUG_LOG("<<<\n");
+}
+
 static void test_bb_prepend_byte()
 {
 	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
@@ -1196,6 +1339,615 @@ static void test_bb_join_buffer()
 }
 
 
+static void test_bb_grow()
+{
+	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
+
+	ByteBuffer *buffer = byte_buffer_new(BYTE_BUFFER_GROW, 0);
+
+	assert(buffer->size == 0);
+
+	for (size_t curByte = 0; curByte < 1000; curByte++)
+	{
+		byte_buffer_append_byte(buffer, (unsigned char)('A' + (curByte % 26)));
+	}
+
+	assert(buffer->offset == 1000);
+	assert(buffer->size == 1024);
+
+	for (size_t curIdx = 0; curIdx < buffer->offset; curIdx++)
+	{
+		assert(buffer->buffer[curIdx] == (unsigned char)('A' + (curIdx % 26)));
+	}
+
+	byte_buffer_append_bytes(buffer, (unsigned char *)"0123456789012345678901234", 25);
+
+	assert(buffer->offset == 1025);
+	assert(buffer->size == 2048);
+	assert(memcmp(buffer->buffer + 1000, "0123456789012345678901234", 25) == 0);
+
+	byte_buffer_shrink_to_fit(buffer);
+
+	assert(buffer->size == 1025);
+	assert(buffer->offset == 1025);
+
+	assert(byte_buffer_reserve(buffer, 4000));
+	assert(buffer->size == 4100);
+	assert(buffer->offset == 1025);
+	assert(memcmp(buffer->buffer + 1000, "0123456789012345678901234", 25) == 0);
+
+	byte_buffer_free(&buffer);
+
+	//growing outside memory switches to own memory
+	unsigned char rawBuffer[10];
+	size_t buffSize = 10;
+
+	ByteBuffer growBuffer;
+	ByteBuffer *growPtr = &growBuffer;
+
+	byte_buffer_init(growPtr, BYTE_BUFFER_GROW, &rawBuffer[0], buffSize);
+
+	byte_buffer_append_bytes(growPtr, (unsigned char *)"0123456789", 10);
+
+	assert(growPtr->buffer == &rawBuffer[0]);
+	assert(growPtr->alloc == false);
+
+	byte_buffer_append_bytes_fmt(growPtr, "[%.3f]", 47.222f);
+
+	assert(growPtr->buffer != &rawBuffer[0]);
+	assert(growPtr->alloc == true);
+	assert(growPtr->size == 32);
+	assert(growPtr->offset == 18);
+	assert(memcmp(growPtr->buffer, "0123456789[47.222]", 18) == 0);
+
+	//insert moves written bytes only and increases the offset
+	byte_buffer_insert_bytes(growPtr, 10, (unsigned char *)"ABC", 3);
+	byte_buffer_prepend_byte(growPtr, 'X');
+	byte_buffer_insert_bytes_fmt(growPtr, 4, "[%s]", "FU");
+
+	assert(growPtr->offset == 26);
+	assert(growPtr->size == 32);
+	assert(memcmp(growPtr->buffer, "X012[FU]3456789ABC[47.222]", 26) == 0);
+
+	//insert behind the written bytes is ignored
+	byte_buffer_insert_byte(growPtr, 27, 'Y');
+
+	assert(growPtr->offset == 26);
+
+	//replace behind capacity grows too
+	byte_buffer_replace_bytes(growPtr, 38, (unsigned char *)"END", 3);
+
+	assert(growPtr->offset == 26);
+	assert(growPtr->size == 64);
+	assert(memcmp(growPtr->buffer + 38, "END", 3) == 0);
+
+	#ifdef debug
+	printf("grow buff:");
+	__test_bb_print_buffer(growPtr->buffer, growPtr->offset);
+	#endif
+
+	byte_buffer_free(&growPtr);
+
+	assert(growPtr->buffer == NULL);
+	assert(growPtr->size == 0);
+
+	DEBUG_LOG("<<<\n");
+}
+
+static void test_bb_grow_self()
+{
+	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
+
+	//the own bytes stay valid while growing moves the memory
+	ByteBuffer *buffer = byte_buffer_new(BYTE_BUFFER_GROW, 4);
+	byte_buffer_append_bytes(buffer, (unsigned char *)"ABCD", 4);
+
+	byte_buffer_append_view(buffer, byte_view_from_content(buffer));
+
+	assert(buffer->offset == 8);
+	assert(memcmp(buffer->buffer, "ABCDABCD", 8) == 0);
+
+	byte_buffer_shrink_to_fit(buffer);
+	byte_buffer_append_buffer(buffer, buffer);
+
+	assert(buffer->offset == 16);
+	assert(memcmp(buffer->buffer, "ABCDABCDABCDABCD", 16) == 0);
+
+	byte_buffer_shrink_to_fit(buffer);
+	byte_buffer_clear(buffer);
+	byte_buffer_append_bytes(buffer, (unsigned char *)"0123456789ABCDEF", 16);
+
+	//the inserted bytes span the insert index, so a part of them moves behind the gap
+	byte_buffer_insert_bytes(buffer, 4, buffer->buffer + 2, 6);
+
+	assert(buffer->offset == 22);
+	assert(memcmp(buffer->buffer, "0123234567456789ABCDEF", 22) == 0);
+
+	byte_buffer_shrink_to_fit(buffer);
+	byte_buffer_prepend_buffer(buffer, buffer);
+
+	assert(buffer->offset == 44);
+	assert(memcmp(buffer->buffer, "0123234567456789ABCDEF0123234567456789ABCDEF", 44) == 0);
+
+	//whole buffers include the unwritten bytes
+	assert(byte_buffer_reserve(buffer, 64));
+	size_t cntUnwritten = buffer->size - buffer->offset;
+	byte_buffer_prepend_buffer(buffer, buffer);
+
+	assert(buffer->offset == 88 + cntUnwritten);
+	assert(memcmp(buffer->buffer, "0123234567456789ABCDEF0123234567456789ABCDEF", 44) == 0);
+	assert(memcmp(buffer->buffer + 44 + cntUnwritten, "0123234567456789ABCDEF0123234567456789ABCDEF", 44) == 0);
+
+	byte_buffer_free(&buffer);
+
+	DEBUG_LOG("<<<\n");
+}
+
+static void test_bb_fmt_long()
+{
+	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
+
+	//longer than the scratch, formatted in place. Content behind the result stays untouched.
+	char longText[301];
+	memset(longText, 'L', 300);
+	longText[300] = '\0';
+
+	ByteBuffer *buffer = byte_buffer_new(BYTE_BUFFER_TRUNCATE, 320);
+	byte_buffer_fill_complete(buffer, 'X');
+	byte_buffer_append_bytes(buffer, (unsigned char *)"<", 1);
+
+	byte_buffer_append_bytes_fmt(buffer, "%s>", longText);
+
+	assert(buffer->offset == 302);
+	assert(buffer->buffer[0] == '<');
+	assert(memcmp(&buffer->buffer[1], longText, 300) == 0);
+	assert(buffer->buffer[301] == '>');
+	assert(buffer->buffer[302] == 'X');
+	assert(buffer->buffer[319] == 'X');
+
+	//not enough space, truncated as before
+	byte_buffer_append_bytes_fmt(buffer, "%s", longText);
+
+	assert(buffer->offset == 320);
+	assert(buffer->buffer[319] == 'L');
+
+	byte_buffer_free(&buffer);
+
+	//growing buffer formats direct into free space and grows on overflow
+	buffer = byte_buffer_new(BYTE_BUFFER_GROW, 8);
+
+	byte_buffer_append_bytes_fmt(buffer, "%d", 1234567);
+
+	assert(buffer->offset == 7);
+	assert(buffer->size == 8);
+	assert(memcmp(buffer->buffer, "1234567", 7) == 0);
+
+	byte_buffer_append_bytes_fmt(buffer, "[%s]", longText);
+
+	assert(buffer->offset == 309);
+	assert(buffer->size >= 310);
+	assert(memcmp(buffer->buffer, "1234567[", 8) == 0);
+	assert(memcmp(&buffer->buffer[8], longText, 300) == 0);
+	assert(buffer->buffer[308] == ']');
+
+	//replace keeps the written bytes behind the result
+	byte_buffer_replace_bytes_fmt(buffer, 1, "%d", 99);
+
+	assert(buffer->offset == 309);
+	assert(memcmp(buffer->buffer, "1994567[", 8) == 0);
+
+	byte_buffer_free(&buffer);
+
+	DEBUG_LOG("<<<\n");
+}
+
+static void test_bb_put_get()
+{
+	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
+
+	ByteBuffer *buffer = byte_buffer_new(BYTE_BUFFER_TRUNCATE, 64);
+
+	byte_buffer_put_u16_le(buffer, 0x0102);
+	byte_buffer_put_u16_be(buffer, 0x0102);
+	byte_buffer_put_u32_le(buffer, 0x01020304);
+	byte_buffer_put_u32_be(buffer, 0x01020304);
+	byte_buffer_put_u64_le(buffer, 0x0102030405060708ULL);
+	byte_buffer_put_u64_be(buffer, 0x0102030405060708ULL);
+	byte_buffer_put_f32_le(buffer, 1.5f);
+	byte_buffer_put_f64_be(buffer, -2.25);
+
+	assert(buffer->offset == 40);
+
+	unsigned char expected[] = { 0x02, 0x01, 0x01, 0x02, 
+	                             0x04, 0x03, 0x02, 0x01, 0x01, 0x02, 0x03, 0x04,
+	                             0x08, 0x07, 0x06, 0x05, 0x04, 0x03, 0x02, 0x01,
+	                             0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08,
+	                             0x00, 0x00, 0xC0, 0x3F,
+	                             0xC0, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+
+	assert(memcmp(buffer->buffer, expected, 40) == 0);
+
+	uint16_t u16 = 0;
+	uint32_t u32 = 0;
+	uint64_t u64 = 0;
+	float f32 = 0.f;
+	double f64 = 0.;
+
+	assert(byte_buffer_get_u16_le(buffer, 0, &u16) && u16 == 0x0102);
+	assert(byte_buffer_get_u16_be(buffer, 2, &u16) && u16 == 0x0102);
+	assert(byte_buffer_get_u32_le(buffer, 4, &u32) && u32 == 0x01020304);
+	assert(byte_buffer_get_u32_be(buffer, 8, &u32) && u32 == 0x01020304);
+	assert(byte_buffer_get_u64_le(buffer, 12, &u64) && u64 == 0x0102030405060708ULL);
+	assert(byte_buffer_get_u64_be(buffer, 20, &u64) && u64 == 0x0102030405060708ULL);
+	assert(byte_buffer_get_f32_le(buffer, 28, &f32) && f32 == 1.5f);
+	assert(byte_buffer_get_f64_be(buffer, 32, &f64) && f64 == -2.25);
+
+	//values crossing the end are not read
+	assert(byte_buffer_get_u64_le(buffer, 56, &u64));
+	assert(!byte_buffer_get_u64_le(buffer, 57, &u64));
+	assert(!byte_buffer_get_u16_be(buffer, SIZE_MAX, &u16));
+
+	//overflow follows the mode
+	buffer->offset = 62;
+	byte_buffer_put_u32_be(buffer, 0xAABBCCDD);
+	assert(buffer->offset == 64);
+	assert(buffer->buffer[62] == 0xAA && buffer->buffer[63] == 0xBB);
+
+	byte_buffer_mode_set(buffer, BYTE_BUFFER_SKIP);
+	buffer->offset = 62;
+	byte_buffer_put_u32_be(buffer, 0x11223344);
+	assert(buffer->offset == 62);
+	assert(buffer->buffer[62] == 0xAA);
+
+	byte_buffer_mode_set(buffer, BYTE_BUFFER_RING);
+	byte_buffer_put_u32_be(buffer, 0x11223344);
+	assert(buffer->offset == 2);
+	assert(buffer->buffer[62] == 0x11 && buffer->buffer[63] == 0x22);
+	assert(buffer->buffer[0] == 0x33 && buffer->buffer[1] == 0x44);
+
+	byte_buffer_free(&buffer);
+
+	//growing buffer reads only written values
+	buffer = byte_buffer_new(BYTE_BUFFER_GROW, 4);
+	byte_buffer_clear(buffer);
+
+	byte_buffer_put_u32_le(buffer, 7);
+	byte_buffer_put_u64_be(buffer, 8);
+
+	assert(buffer->offset == 12);
+	assert(byte_buffer_get_u64_be(buffer, 4, &u64) && u64 == 8);
+	assert(!byte_buffer_get_u32_le(buffer, 12, &u32));
+
+	byte_buffer_free(&buffer);
+
+	DEBUG_LOG("<<<\n");
+}
+
+static void test_bb_view()
+{
+	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
+
+	const unsigned char *text = (const unsigned char *)"0123456789";
+	ByteView view = byte_view_of(text, 10);
+
+	ByteView slice = byte_view_slice(view, 2, 3);
+	assert(slice.ptr == text + 2 && slice.len == 3);
+	assert(byte_view_equals(slice, byte_view_of((const unsigned char *)"234", 3)));
+
+	//clamped to the view
+	assert(byte_view_slice(view, 8, 5).len == 2);
+	assert(byte_view_slice(view, 20, 5).len == 0);
+	assert(byte_view_prefix(view, 4).len == 4);
+	assert(byte_view_suffix(view, 7).ptr == text + 7);
+	assert(byte_view_suffix(view, 7).len == 3);
+	assert(!byte_view_equals(byte_view_prefix(view, 3), byte_view_suffix(view, 7)));
+
+	ByteBuffer *buffer = byte_buffer_new(BYTE_BUFFER_TRUNCATE, 12);
+	byte_buffer_fill_complete(buffer, '_');
+
+	byte_buffer_append_view(buffer, byte_view_slice(view, 4, 3));
+	byte_buffer_prepend_view(buffer, byte_view_prefix(view, 2));
+	byte_buffer_insert_view(buffer, byte_view_suffix(view, 9), 2);
+	byte_buffer_replace_view(buffer, byte_view_of((const unsigned char *)"AB", 2), 10);
+
+	assert(memcmp(buffer->buffer, "019456____AB", 12) == 0);
+
+	//sub range of one buffer into another without temporary buffer
+	ByteBuffer *joined = byte_buffer_join_view(byte_view_slice(byte_view_from_buffer(buffer), 3, 3), view, BYTE_BUFFER_TRUNCATE);
+
+	assert(joined->size == 13);
+	assert(memcmp(joined->buffer, "4560123456789", 13) == 0);
+
+	byte_buffer_free(&joined);
+	byte_buffer_free(&buffer);
+
+	DEBUG_LOG("<<<\n");
+}
+
+static void test_bb_content()
+{
+	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
+
+	ByteBuffer *bufferA = byte_buffer_new(BYTE_BUFFER_TRUNCATE, 1024);
+	ByteBuffer *bufferB = byte_buffer_new(BYTE_BUFFER_TRUNCATE, 1024);
+	byte_buffer_append_bytes(bufferA, (unsigned char *)"HEAD", 4);
+	byte_buffer_append_bytes(bufferB, (unsigned char *)"BODY", 4);
+
+	//joined from the written bytes only
+	ByteBuffer *joined = byte_buffer_join_content(bufferA, bufferB, BYTE_BUFFER_GROW);
+
+	assert(joined->size == 8);
+	assert(joined->offset == 8);
+	assert(memcmp(joined->buffer, "HEADBODY", 8) == 0);
+
+	byte_buffer_append_content(joined, bufferA);
+	byte_buffer_prepend_content(joined, bufferB);
+	byte_buffer_insert_content(joined, bufferB, 4);
+	byte_buffer_replace_content(joined, bufferA, 8);
+
+	assert(joined->offset == 20);
+	assert(memcmp(joined->buffer, "BODYBODYHEADBODYHEAD", 20) == 0);
+
+	ByteView content = byte_view_from_content(bufferA);
+	assert(content.ptr == bufferA->buffer && content.len == 4);
+
+	//full buffer has the offset at the end
+	ByteBuffer *full = byte_buffer_new(BYTE_BUFFER_TRUNCATE, 4);
+	byte_buffer_append_bytes(full, (unsigned char *)"FULLER", 6);
+	assert(byte_view_from_content(full).len == 4);
+
+	byte_buffer_free(&full);
+	byte_buffer_free(&joined);
+	byte_buffer_free(&bufferA);
+	byte_buffer_free(&bufferB);
+
+	DEBUG_LOG("<<<\n");
+}
+
+static void test_bb_clone()
+{
+	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
+
+	ByteBuffer *payload = byte_buffer_new(BYTE_BUFFER_TRUNCATE, 8);
+	byte_buffer_clear(payload);
+	byte_buffer_append_bytes(payload, (unsigned char *)"DATA", 4);
+
+	//fan out without copies
+	ByteBuffer *first = byte_buffer_clone(payload);
+	ByteBuffer *second = byte_buffer_clone(payload);
+
+	assert(first->buffer == payload->buffer);
+	assert(second->buffer == payload->buffer);
+	assert(first->offset == 4);
+
+	//first change copies
+	byte_buffer_append_bytes(first, (unsigned char *)"1", 1);
+
+	assert(first->buffer != payload->buffer);
+	assert(memcmp(first->buffer, "DATA1", 5) == 0);
+	assert(payload->offset == 4);
+	assert(payload->buffer[4] == 0);
+
+	byte_buffer_insert_byte(payload, 0, '>');
+	assert(payload->buffer != second->buffer);
+	assert(memcmp(payload->buffer, ">DATA", 5) == 0);
+	assert(memcmp(second->buffer, "DATA", 4) == 0);
+
+	//last reference changes without copy
+	unsigned char *secondStorage = second->buffer;
+	byte_buffer_fill_range(second, 4, 4, 'Z');
+	assert(second->buffer == secondStorage);
+	assert(memcmp(second->buffer, "DATAZZZZ", 8) == 0);
+
+	byte_buffer_free(&first);
+	byte_buffer_free(&second);
+	byte_buffer_free(&payload);
+
+	//growing a shared buffer copies into own memory, freeing in any order
+	ByteBuffer *grow = byte_buffer_new(BYTE_BUFFER_GROW, 4);
+	byte_buffer_clear(grow);
+	byte_buffer_append_bytes(grow, (unsigned char *)"ABCD", 4);
+
+	ByteBuffer *growClone = byte_buffer_clone(grow);
+
+	byte_buffer_free(&grow);
+	assert(growClone->shared != NULL);
+
+	byte_buffer_put_u32_be(growClone, 0x45464748);
+	assert(growClone->shared == NULL);
+	assert(growClone->offset == 8);
+	assert(memcmp(growClone->buffer, "ABCDEFGH", 8) == 0);
+
+	ByteBuffer *sharedGrow = byte_buffer_clone(growClone);
+	byte_buffer_reserve(sharedGrow, 100);
+	assert(sharedGrow->buffer != growClone->buffer);
+	assert(growClone->shared != NULL);
+	assert(memcmp(sharedGrow->buffer, "ABCDEFGH", 8) == 0);
+
+	byte_buffer_free(&growClone);
+	byte_buffer_free(&sharedGrow);
+
+	//outside memory is copied, its owner could release it before the clone
+	unsigned char rawBuffer[6] = "OUTER";
+	ByteBuffer outside;
+	byte_buffer_init(&outside, BYTE_BUFFER_TRUNCATE, &rawBuffer[0], sizeof(rawBuffer));
+
+	ByteBuffer *outsideClone = byte_buffer_clone(&outside);
+	assert(outsideClone->buffer != &rawBuffer[0]);
+	assert(outsideClone->alloc && outsideClone->shared == NULL);
+	assert(memcmp(outsideClone->buffer, "OUTER", 6) == 0);
+
+	rawBuffer[0] = 'X';
+	assert(outsideClone->buffer[0] == 'O');
+
+	byte_buffer_free(&outsideClone);
+
+	DEBUG_LOG("<<<\n");
+}
+
+typedef struct
+{
+	size_t cntAlloc;
+	size_t cntRealloc;
+	size_t cntFree;
+} TestAllocStats;
+
+static void* __test_bb_alloc(void* ctx, size_t size)
+{
+	((TestAllocStats*)ctx)->cntAlloc++;
+	return malloc(size);
+}
+
+static void* __test_bb_realloc(void* ctx, void* ptr, size_t size)
+{
+	((TestAllocStats*)ctx)->cntRealloc++;
+	return realloc(ptr, size);
+}
+
+static void __test_bb_free(void* ctx, void* ptr)
+{
+	if (ptr) ((TestAllocStats*)ctx)->cntFree++;
+	free(ptr);
+}
+
+static void test_bb_allocator()
+{
+	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
+
+	TestAllocStats stats = {0};
+	MemAllocator counting = { __test_bb_alloc, __test_bb_realloc, __test_bb_free, &stats };
+
+	//per buffer allocator: object, storage, growth, format scratch and clones
+	ByteBuffer *buffer = byte_buffer_new_allocator(BYTE_BUFFER_GROW, 4, &counting);
+	assert(buffer->allocator == &counting);
+	assert(stats.cntAlloc == 2);
+
+	byte_buffer_append_bytes(buffer, (unsigned char *)"0123456789", 10);
+	assert(stats.cntRealloc == 1);
+
+	ByteBuffer *clone = byte_buffer_clone(buffer);
+	assert(clone->allocator == &counting);
+	byte_buffer_append_byte(clone, 'X');
+	byte_buffer_free(&clone);
+	byte_buffer_free(&buffer);
+
+	assert(stats.cntAlloc == stats.cntFree);
+
+	ByteBuffer fixed;
+	byte_buffer_init_new_allocator(&fixed, BYTE_BUFFER_TRUNCATE, 8, &counting);
+	size_t allocsBefore = stats.cntAlloc;
+
+	char longText[400];
+	memset(longText, 'y', sizeof(longText) - 1);
+	longText[sizeof(longText) - 1] = '\0';
+	byte_buffer_replace_bytes_fmt(&fixed, 0, (unsigned char *)"%s", longText);
+	assert(stats.cntAlloc == allocsBefore + 1);
+
+	ByteBuffer *fixedPtr = &fixed;
+	byte_buffer_free(&fixedPtr);
+	assert(stats.cntAlloc == stats.cntFree);
+
+	//global allocator is taken by buffers without an explicit one
+	TestAllocStats globalStats = {0};
+	MemAllocator global = { __test_bb_alloc, __test_bb_realloc, __test_bb_free, &globalStats };
+	mem_allocator_set(&global);
+	assert(mem_allocator_get() == &global);
+
+	ByteBuffer *globalBuffer = byte_buffer_new(BYTE_BUFFER_TRUNCATE, 16);
+	assert(globalBuffer->allocator == &global);
+	assert(globalStats.cntAlloc == 2);
+
+	mem_allocator_set(NULL);
+	assert(mem_allocator_get() == mem_allocator_default());
+
+	//memory goes back to the allocator it came from
+	byte_buffer_free(&globalBuffer);
+	assert(globalStats.cntFree == 2);
+
+	DEBUG_LOG("<<<\n");
+}
+
+static void test_bb_mapped()
+{
+	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
+
+	const char* fileName = "test_bb_mapped.tmp";
+	FILE* file = fopen(fileName, "wb");
+	assert(file != NULL);
+	fputs("0123456789ABCDEFGHIJ", file);
+	fclose(file);
+
+	//read mapping, changes stay private
+	ByteBuffer *buffer = byte_buffer_new_mapped(BYTE_BUFFER_TRUNCATE, fileName, BYTE_BUFFER_MAP_READ);
+
+	assert(buffer != NULL);
+	assert(buffer->mapped == true);
+	assert(buffer->alloc == false);
+	assert(buffer->allocObj == true);
+	assert(buffer->size == 20);
+	assert(buffer->offset == 20);
+	__test_bb_equals(buffer, (unsigned char *)"0123456789ABCDEFGHIJ");
+
+	assert(byte_buffer_advise(buffer, BYTE_BUFFER_ADVICE_SEQUENTIAL));
+	assert(byte_buffer_advise(buffer, BYTE_BUFFER_ADVICE_RANDOM));
+
+	byte_buffer_replace_bytes(buffer, 0, (unsigned char *)"XX", 2);
+
+	__test_bb_equals(buffer, (unsigned char *)"XX23456789ABCDEFGHIJ");
+
+	byte_buffer_free(&buffer);
+
+	assert(buffer == NULL);
+
+	//shared mapping writes back to the file
+	ByteBuffer shared;
+	ByteBuffer *sharedPtr = &shared;
+
+	assert(byte_buffer_init_mapped(sharedPtr, BYTE_BUFFER_TRUNCATE, fileName, BYTE_BUFFER_MAP_SHARED));
+
+	__test_bb_equals(sharedPtr, (unsigned char *)"0123456789ABCDEFGHIJ");
+
+	byte_buffer_replace_bytes(sharedPtr, 10, (unsigned char *)"abcdef", 6);
+
+	assert(byte_buffer_sync(sharedPtr));
+
+	char fileContent[21] = { 0 };
+	file = fopen(fileName, "rb");
+	assert(fread(&fileContent[0], 1, 20, file) == 20);
+	fclose(file);
+
+	assert(memcmp(&fileContent[0], "0123456789abcdefGHIJ", 20) == 0);
+
+	//growing copies the mapping into own memory
+	byte_buffer_mode_set(sharedPtr, BYTE_BUFFER_GROW);
+	byte_buffer_append_bytes(sharedPtr, (unsigned char *)"KL", 2);
+
+	assert(sharedPtr->mapped == false);
+	assert(sharedPtr->alloc == true);
+	assert(sharedPtr->offset == 22);
+	assert(memcmp(sharedPtr->buffer, "0123456789abcdefGHIJKL", 22) == 0);
+	assert(byte_buffer_sync(sharedPtr) == false);
+
+	byte_buffer_free(&sharedPtr);
+
+	//empty file and missing file
+	file = fopen(fileName, "wb");
+	fclose(file);
+
+	assert(byte_buffer_init_mapped(sharedPtr, BYTE_BUFFER_TRUNCATE, fileName, BYTE_BUFFER_MAP_READ));
+	assert(sharedPtr->size == 0);
+	assert(sharedPtr->offset == 0);
+	assert(sharedPtr->mapped == false);
+
+	byte_buffer_free(&sharedPtr);
+
+	remove(fileName);
+
+	assert(byte_buffer_new_mapped(BYTE_BUFFER_TRUNCATE, fileName, BYTE_BUFFER_MAP_READ) == NULL);
+
+	DEBUG_LOG("<<<\n");
+}
+
 static void test_bb_dummy()
 {
 	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
@@ -1227,6 +1979,8 @@ int main(int argc, char **argv) {
 
 	test_bb_append_bytes_ring();
 
+	test_bb_append_bytes_ring_bulk();
+
 	test_bb_replace_byte();
 
 	test_bb_replace_bytes();
@@ -1235,6 +1989,10 @@ int main(int argc, char **argv) {
 
 	test_bb_insert_bytes();
 
+	test_bb_insert_bytes_skip();
+
+	test_bb_insert_bytes_ring();
+
 	test_bb_prepend_byte();
 
 	test_bb_prepend_bytes();
@@ -1249,6 +2007,24 @@ int main(int argc, char **argv) {
 
 	test_bb_join_buffer();
 
+	test_bb_grow();
+
+	test_bb_grow_self();
+
+	test_bb_fmt_long();
+
+	test_bb_put_get();
+
+	test_bb_view();
+
+	test_bb_content();
+
+	test_bb_clone();
+
+	test_bb_allocator();
+
+	test_bb_mapped();
+
 	DEBUG_LOG("<< end byte utils test:\n");
 
 	return 0;
@@ -0,0 +1,166 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "defs.h"
+#include "cpu_utils.h"
+#include "byte_varint.h"
+#include "test_utils.h"
+
+#define TEST_VARINT_BULK_VALUES 20000
+
+static void test_varint_put_get()
+{
+	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
+
+	ByteBuffer *buffer = byte_buffer_new(BYTE_BUFFER_GROW, 8);
+	byte_buffer_clear(buffer);
+
+	byte_buffer_put_uvarint(buffer, 0);
+	byte_buffer_put_uvarint(buffer, 127);
+	byte_buffer_put_uvarint(buffer, 300);
+	byte_buffer_put_uvarint(buffer, UINT64_MAX);
+	byte_buffer_put_svarint(buffer, -1);
+	byte_buffer_put_svarint(buffer, INT64_MIN);
+
+	unsigned char expected[] = { 0x00, 0x7F, 0xAC, 0x02, 
+	                             0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01,
+	                             0x01,
+	                             0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01 };
+
+	assert(buffer->offset == sizeof(expected));
+	assert(memcmp(buffer->buffer, expected, sizeof(expected)) == 0);
+
+	uint64_t value = 0;
+	int64_t signedValue = 0;
+	size_t index = 0;
+
+	index += byte_buffer_get_uvarint(buffer, index, &value);
+	assert(index == 1 && value == 0);
+	index += byte_buffer_get_uvarint(buffer, index, &value);
+	assert(index == 2 && value == 127);
+	index += byte_buffer_get_uvarint(buffer, index, &value);
+	assert(index == 4 && value == 300);
+	index += byte_buffer_get_uvarint(buffer, index, &value);
+	assert(index == 14 && value == UINT64_MAX);
+	index += byte_buffer_get_svarint(buffer, index, &signedValue);
+	assert(index == 15 && signedValue == -1);
+	index += byte_buffer_get_svarint(buffer, index, &signedValue);
+	assert(index == 25 && signedValue == INT64_MIN);
+
+	//behind the content
+	assert(byte_buffer_get_uvarint(buffer, index, &value) == 0);
+
+	//truncated
+	buffer->offset = 3;
+	assert(byte_buffer_get_uvarint(buffer, 2, &value) == 0);
+
+	byte_buffer_free(&buffer);
+
+	//overflowing 64 bit
+	unsigned char tooLong[] = { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x02 };
+	assert(byte_varint_decode(tooLong, sizeof(tooLong), &value) == 0);
+	unsigned char elevenBytes[] = { 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x00 };
+	assert(byte_varint_decode(elevenBytes, sizeof(elevenBytes), &value) == 0);
+
+	assert(byte_varint_zigzag_encode(0) == 0);
+	assert(byte_varint_zigzag_encode(-1) == 1);
+	assert(byte_varint_zigzag_encode(1) == 2);
+	assert(byte_varint_zigzag_decode(3) == -2);
+
+	DEBUG_LOG("<<<\n");
+}
+
+//mixes runs of small values with all encoded lengths, so both block paths and the tail are used
+static ByteBuffer* __test_varint_encode_mixed(uint64_t* values, size_t cntValues)
+{
+	ByteBuffer *encoded = byte_buffer_new(BYTE_BUFFER_GROW, 16);
+	byte_buffer_clear(encoded);
+
+	uint64_t state = TEST_RANDOM_SEED;
+	for (size_t curValue = 0; curValue < cntValues; curValue++)
+	{
+		uint64_t random = test_random_next(&state);
+
+		bool smallRun = ((curValue / 64) % 2) == 0;
+		values[curValue] = ( smallRun ? random % 128 : random >> (random % 64) );
+
+		byte_buffer_put_uvarint(encoded, values[curValue]);
+	}
+
+	return encoded;
+}
+
+static void __test_varint_bulk(unsigned disabledFeatures)
+{
+	cpu_features_disable(disabledFeatures);
+
+	uint64_t* values = malloc(TEST_VARINT_BULK_VALUES * sizeof(uint64_t));
+	uint64_t* decoded = malloc(TEST_VARINT_BULK_VALUES * sizeof(uint64_t));
+
+	ByteBuffer *encoded = __test_varint_encode_mixed(values, TEST_VARINT_BULK_VALUES);
+	size_t consumed = 0;
+
+	size_t cntDecoded = byte_varint_decode_bulk(encoded->buffer, encoded->offset, decoded, TEST_VARINT_BULK_VALUES, &consumed);
+
+	assert(cntDecoded == TEST_VARINT_BULK_VALUES);
+	assert(consumed == encoded->offset);
+	assert(memcmp(values, decoded, TEST_VARINT_BULK_VALUES * sizeof(uint64_t)) == 0);
+
+	//limited count of values
+	cntDecoded = byte_varint_decode_bulk(encoded->buffer, encoded->offset, decoded, 100, &consumed);
+	assert(cntDecoded == 100);
+
+	size_t expectedConsumed = 0;
+	for (size_t curValue = 0; curValue < 100; curValue++)
+	{
+		uint64_t value;
+		expectedConsumed += byte_varint_decode(encoded->buffer + expectedConsumed, encoded->offset - expectedConsumed, &value);
+	}
+	assert(consumed == expectedConsumed);
+
+	//stops in front of a truncated varint
+	cntDecoded = byte_varint_decode_bulk(encoded->buffer, encoded->offset - 1, decoded, TEST_VARINT_BULK_VALUES, &consumed);
+	assert(cntDecoded == TEST_VARINT_BULK_VALUES - 1);
+	assert(consumed <= encoded->offset - 1);
+
+	//stops in front of a malformed varint in the middle of a block
+	memset(encoded->buffer + 200, 0x80, 40);
+	cntDecoded = byte_varint_decode_bulk(encoded->buffer, encoded->offset, decoded, TEST_VARINT_BULK_VALUES, &consumed);
+	assert(consumed <= 200);
+	assert(memcmp(values, decoded, cntDecoded * sizeof(uint64_t)) == 0);
+
+	byte_buffer_free(&encoded);
+	free(values);
+	free(decoded);
+
+	cpu_features_disable(0);
+}
+
+static void test_varint_bulk()
+{
+	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
+
+	//best kernel, SSE2 only and scalar only
+	__test_varint_bulk(0);
+	__test_varint_bulk(CPU_FEATURE_AVX2);
+	__test_varint_bulk(~0U);
+
+	DEBUG_LOG("<<<\n");
+}
+
+int main(int argc, char **argv) {
+	UNUSED(argc);
+	UNUSED(argv);
+	DEBUG_LOG(">> start byte varint test:\n");
+
+	test_varint_put_get();
+
+	test_varint_bulk();
+
+	DEBUG_LOG("<< end byte varint test:\n");
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,299 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include "defs.h"
+#include "byte_writer.h"
+
+#define TEST_WRITER_FILE "test_byte_writer.tmp"
+#define TEST_WRITER_LINES 20000
+#define TEST_WRITER_PRODUCERS 4
+#define TEST_WRITER_PRODUCER_LINES 5000
+#define TEST_WRITER_PRODUCER_LINE_SIZE 9
+
+static ByteBuffer* __test_writer_read_file(const char* fileName)
+{
+	FILE* file = fopen(fileName, "rb");
+	assert(file != NULL);
+
+	fseek(file, 0, SEEK_END);
+	long fileSize = ftell(file);
+	fseek(file, 0, SEEK_SET);
+
+	ByteBuffer *content = byte_buffer_new(BYTE_BUFFER_TRUNCATE, (size_t)fileSize + 1);
+	content->offset = fread(content->buffer, 1, (size_t)fileSize, file);
+
+	fclose(file);
+
+	return content;
+}
+
+static void test_writer_small()
+{
+	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
+
+	int fd = open(TEST_WRITER_FILE, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	assert(fd >= 0);
+
+	//tiny buffers, so nearly every append swaps the buffers
+	ByteWriter *writer = byte_writer_new(fd, 4);
+
+	byte_writer_append_byte(writer, '[');
+	byte_writer_append_bytes(writer, (unsigned char*)"HELLO", 5);
+	byte_writer_append_bytes_fmt(writer, " %s %d", "WORLD", 42);
+	byte_writer_append_byte(writer, ']');
+
+	assert(byte_writer_flush(writer));
+
+	ByteWriterStats stats;
+	byte_writer_stats(writer, &stats);
+	assert(stats.bytesWritten == 16);
+	assert(stats.cntFlushes == 4);
+
+	byte_writer_free(&writer);
+	assert(writer == NULL);
+	close(fd);
+
+	ByteBuffer *content = __test_writer_read_file(TEST_WRITER_FILE);
+	assert(content->offset == 16);
+	assert(memcmp(content->buffer, "[HELLO WORLD 42]", 16) == 0);
+	byte_buffer_free(&content);
+
+	remove(TEST_WRITER_FILE);
+
+	DEBUG_LOG("<<<\n");
+}
+
+static void test_writer_large()
+{
+	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
+
+	int fd = open(TEST_WRITER_FILE, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	assert(fd >= 0);
+
+	ByteWriter writer;
+	assert(byte_writer_init(&writer, fd, 4096));
+
+	size_t expected = 0;
+	for (size_t curLine = 0; curLine < TEST_WRITER_LINES; curLine++)
+	{
+		char line[64];
+		int lineSize = snprintf(line, sizeof(line), "line %zu of %d\n", curLine, TEST_WRITER_LINES);
+		byte_writer_append_bytes_fmt(&writer, "line %zu of %d\n", curLine, TEST_WRITER_LINES);
+		expected += (size_t)lineSize;
+	}
+
+	//longer than the format scratch buffer and the writer buffers
+	char *longLine = malloc(10000);
+	memset(longLine, 'L', 9999);
+	longLine[9999] = '\0';
+	byte_writer_append_bytes_fmt(&writer, "%s\n", longLine);
+	expected += 10000;
+
+	assert(byte_writer_flush(&writer));
+	assert(byte_writer_error(&writer) == 0);
+
+	ByteWriterStats stats;
+	byte_writer_stats(&writer, &stats);
+	assert(stats.bytesWritten == expected);
+	assert(stats.elapsedSeconds >= stats.stallSeconds);
+
+	ByteWriter *writerPtr = &writer;
+	byte_writer_free(&writerPtr);
+	assert(writerPtr == &writer);
+	close(fd);
+
+	ByteBuffer *content = __test_writer_read_file(TEST_WRITER_FILE);
+	assert(content->offset == expected);
+
+	size_t curIdx = 0;
+	for (size_t curLine = 0; curLine < TEST_WRITER_LINES; curLine++)
+	{
+		char line[64];
+		int lineSize = snprintf(line, sizeof(line), "line %zu of %d\n", curLine, TEST_WRITER_LINES);
+		assert(memcmp(&content->buffer[curIdx], line, (size_t)lineSize) == 0);
+		curIdx += (size_t)lineSize;
+	}
+	assert(memcmp(&content->buffer[curIdx], longLine, 9999) == 0);
+	assert(content->buffer[curIdx + 9999] == '\n');
+
+	free(longLine);
+	byte_buffer_free(&content);
+
+	remove(TEST_WRITER_FILE);
+
+	DEBUG_LOG("<<<\n");
+}
+
+typedef struct
+{
+	ByteWriter* writer;
+	int producer;
+} TestWriterProducer;
+
+static void* __test_writer_producer(void* _producer)
+{
+	TestWriterProducer* producer = _producer;
+
+	for (size_t curLine = 0; curLine < TEST_WRITER_PRODUCER_LINES; curLine++)
+	{
+		byte_writer_append_bytes_fmt(producer->writer, "p%d %05zu\n", producer->producer, curLine);
+	}
+
+	return NULL;
+}
+
+static void test_writer_producers()
+{
+	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
+
+	int fd = open(TEST_WRITER_FILE, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	assert(fd >= 0);
+
+	//lines do not fit the buffer size evenly, so many of them are split over both buffers
+	ByteWriter *writer = byte_writer_new(fd, 64);
+
+	pthread_t threads[TEST_WRITER_PRODUCERS];
+	TestWriterProducer producers[TEST_WRITER_PRODUCERS];
+
+	for (int curProducer = 0; curProducer < TEST_WRITER_PRODUCERS; curProducer++)
+	{
+		producers[curProducer].writer = writer;
+		producers[curProducer].producer = curProducer;
+		assert(pthread_create(&threads[curProducer], NULL, __test_writer_producer, &producers[curProducer]) == 0);
+	}
+
+	for (int curProducer = 0; curProducer < TEST_WRITER_PRODUCERS; curProducer++)
+	{
+		pthread_join(threads[curProducer], NULL);
+	}
+
+	assert(byte_writer_flush(writer));
+	byte_writer_free(&writer);
+	close(fd);
+
+	//each line is complete and the lines of one producer keep their order
+	ByteBuffer *content = __test_writer_read_file(TEST_WRITER_FILE);
+	assert(content->offset == TEST_WRITER_PRODUCERS * TEST_WRITER_PRODUCER_LINES * TEST_WRITER_PRODUCER_LINE_SIZE);
+
+	size_t nextLine[TEST_WRITER_PRODUCERS] = { 0 };
+	for (size_t curIdx = 0; curIdx < content->offset; curIdx += TEST_WRITER_PRODUCER_LINE_SIZE)
+	{
+		unsigned char *line = &content->buffer[curIdx];
+		assert(line[0] == 'p' && line[2] == ' ' && line[8] == '\n');
+
+		int producer = line[1] - '0';
+		assert(producer >= 0 && producer < TEST_WRITER_PRODUCERS);
+
+		char expected[TEST_WRITER_PRODUCER_LINE_SIZE + 1];
+		snprintf(expected, sizeof(expected), "p%d %05zu\n", producer, nextLine[producer]++);
+		assert(memcmp(line, expected, TEST_WRITER_PRODUCER_LINE_SIZE) == 0);
+	}
+
+	for (int curProducer = 0; curProducer < TEST_WRITER_PRODUCERS; curProducer++)
+	{
+		assert(nextLine[curProducer] == TEST_WRITER_PRODUCER_LINES);
+	}
+
+	byte_buffer_free(&content);
+
+	remove(TEST_WRITER_FILE);
+
+	DEBUG_LOG("<<<\n");
+}
+
+static size_t testCntAllocs = 0;
+static size_t testCntFrees = 0;
+
+static void* __test_writer_counting_alloc(void* ctx, size_t size)
+{
+	(void)ctx;
+	testCntAllocs++;
+	return malloc(size);
+}
+
+static void __test_writer_counting_free(void* ctx, void* ptr)
+{
+	(void)ctx;
+	if (ptr) testCntFrees++;
+	free(ptr);
+}
+
+static void test_writer_allocator()
+{
+	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
+
+	MemAllocator counting = *mem_allocator_default();
+	counting.alloc = __test_writer_counting_alloc;
+	counting.free = __test_writer_counting_free;
+
+	int fd = open(TEST_WRITER_FILE, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	assert(fd >= 0);
+
+	mem_allocator_set(&counting);
+
+	ByteWriter *writer = byte_writer_new(fd, 64);
+	assert(writer->allocator == &counting);
+	assert(testCntAllocs == 3);
+
+	mem_allocator_set(NULL);
+
+	//lines longer than the format scratch and the writer itself use the allocator of the writer
+	char longLine[400];
+	memset(longLine, 'w', sizeof(longLine) - 1);
+	longLine[sizeof(longLine) - 1] = '\0';
+	byte_writer_append_bytes_fmt(writer, "%s", longLine);
+	assert(testCntAllocs == 4);
+
+	byte_writer_free(&writer);
+	close(fd);
+
+	assert(testCntFrees == 4);
+
+	remove(TEST_WRITER_FILE);
+
+	DEBUG_LOG("<<<\n");
+}
+
+static void test_writer_error()
+{
+	DEBUG_LOG_ARGS(">>> %s => %s\n", __FILE__, __func__);
+
+	ByteWriter *writer = byte_writer_new(-1, 16);
+
+	byte_writer_append_bytes(writer, (unsigned char*)"lost", 4);
+
+	assert(!byte_writer_flush(writer));
+	assert(byte_writer_error(writer) == EBADF);
+
+	byte_writer_free(&writer);
+
+	DEBUG_LOG("<<<\n");
+}
+
+int main(int argc, char **argv) {
+	UNUSED(argc);
+	UNUSED(argv);
+	DEBUG_LOG(">> start byte writer test:\n");
+
+	test_writer_small();
+
+	test_writer_large();
+
+	test_writer_producers();
+
+	test_writer_allocator();
+
+	test_writer_error();
+
+	DEBUG_LOG("<< end byte writer test:\n");
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,29 @@
+#ifndef TEST_UTILS_H
+#define TEST_UTILS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+//seed of all random test and bench data, so every run sees the same input
+#define TEST_RANDOM_SEED 88172645463325252ULL
+
+//next value of the xorshift64 generator in state
+static inline uint64_t test_random_next(uint64_t* state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+//cntBytes random bytes, the same for every call
+static inline void test_random_fill(unsigned char* bytes, size_t cntBytes)
+{
+    uint64_t state = TEST_RANDOM_SEED;
+    for (size_t curByte = 0; curByte < cntBytes; curByte++)
+    {
+        bytes[curByte] = (unsigned char)test_random_next(&state);
+    }
+}
+
+#endif